@@ -0,0 +1,120 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFrequencyBandAccumulateImageFilter_h
+#define itkFrequencyBandAccumulateImageFilter_h
+
+#include <itkInPlaceImageFilter.h>
+#include <vector>
+
+namespace itk
+{
+/** \class FrequencyBandAccumulateImageFilter
+ * \brief Add to a frequency image the high-pass bands of a wavelet level, each one multiplied
+ * by its filter bank image and a factor, in a single pass.
+ *
+ * Each output bin is
+ * \f$ O(k) = s \left( L(k) + \sum_b c_b M_b(k) C_b(k) \right) \f$
+ * where L is the input (the filtered low pass of the level), C_b the coefficients of the band b,
+ * M_b its filter bank image, c_b its factor and s the Scale.
+ * All the bands of the level are read together, and the output is written once.
+ * It can run in place of the input.
+ *
+ * Used to reconstruct each level in WaveletFrequencyInverse and WaveletFrequencyInverseUndecimated.
+ * The filter banks can have a real pixel type \sa Functor::FilterBankMultiply.
+ * The coefficients and filter banks only have to match the size of the input, their metadata is ignored.
+ * The output information is the one of the input.
+ *
+ * \sa FrequencyFilterBankMultiplyImageFilter
+ * \ingroup IsotropicWavelets
+ */
+template< typename TImageType, typename TFilterBankImage = TImageType >
+class FrequencyBandAccumulateImageFilter:
+  public InPlaceImageFilter< TImageType, TImageType >
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(FrequencyBandAccumulateImageFilter);
+
+  /** Standard class type alias. */
+  using Self = FrequencyBandAccumulateImageFilter;
+  using Superclass = InPlaceImageFilter< TImageType, TImageType >;
+  using Pointer = SmartPointer< Self >;
+  using ConstPointer = SmartPointer< const Self >;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(FrequencyBandAccumulateImageFilter, InPlaceImageFilter);
+
+  /** Typedef to images */
+  using ImageType = TImageType;
+  using PixelType = typename ImageType::PixelType;
+  using IndexType = typename ImageType::IndexType;
+  using OutputImageRegionType = typename Superclass::OutputImageRegionType;
+  using FilterBankImageType = TFilterBankImage;
+  using BandFactorsType = std::vector< double >;
+
+  static constexpr unsigned int ImageDimension = TImageType::ImageDimension;
+
+  /** Number of bands added to the input. Bands have to be set with SetBand before updating. */
+  void SetNumberOfBands(unsigned int numberOfBands);
+  unsigned int GetNumberOfBands() const
+    {
+    return static_cast< unsigned int >( this->m_BandFactors.size() );
+    }
+
+  /** Set the coefficients, the filter bank image and the factor of a band, band < NumberOfBands. */
+  void SetBand(unsigned int band, const ImageType * coefficients, const FilterBankImageType * filterBank,
+    double factor = 1.0);
+  const ImageType * GetBandCoefficients(unsigned int band) const;
+  const FilterBankImageType * GetBandFilterBank(unsigned int band) const;
+  double GetBandFactor(unsigned int band) const;
+
+  /** Constant multiplying the output. 1 by default. */
+  itkSetMacro(Scale, double);
+  itkGetConstMacro(Scale, double);
+
+#ifdef ITK_USE_CONCEPT_CHECKING
+  itkConceptMacro( ImageTypeHasNumericTraitsCheck,
+                   ( Concept::HasNumericTraits< PixelType > ) );
+#endif
+
+protected:
+  FrequencyBandAccumulateImageFilter();
+  ~FrequencyBandAccumulateImageFilter() override {}
+  void PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** The bands and filter banks are requested whole: their start index can differ from the input. */
+  void GenerateInputRequestedRegion() override;
+
+  /** The bands and filter banks only have to match the size of the input. */
+  void VerifyInputInformation() ITKv5_CONST override;
+
+  void DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+private:
+  BandFactorsType m_BandFactors;
+  double          m_Scale;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkFrequencyBandAccumulateImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,233 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFrequencyBandAccumulateImageFilter_hxx
+#define itkFrequencyBandAccumulateImageFilter_hxx
+
+#include "itkFrequencyBandAccumulateImageFilter.h"
+#include "itkFrequencyFilterBankMultiplyImageFilter.h"
+#include <itkImageScanlineIterator.h>
+#include <itkNumericTraits.h>
+
+namespace itk
+{
+template< typename TImageType, typename TFilterBankImage >
+FrequencyBandAccumulateImageFilter< TImageType, TFilterBankImage >
+::FrequencyBandAccumulateImageFilter()
+  : m_Scale(1.0)
+{
+  this->InPlaceOff();
+  this->DynamicMultiThreadingOn();
+}
+
+template< typename TImageType, typename TFilterBankImage >
+void
+FrequencyBandAccumulateImageFilter< TImageType, TFilterBankImage >
+::SetNumberOfBands(unsigned int numberOfBands)
+{
+  if ( numberOfBands == this->GetNumberOfBands() )
+    {
+    return;
+    }
+  // Input 0 is the low pass, followed by the coefficients and the filter bank of each band.
+  this->m_BandFactors.resize(numberOfBands, 1.0);
+  this->SetNumberOfIndexedInputs(1 + 2 * numberOfBands);
+  this->SetNumberOfRequiredInputs(1 + 2 * numberOfBands);
+  this->Modified();
+}
+
+template< typename TImageType, typename TFilterBankImage >
+void
+FrequencyBandAccumulateImageFilter< TImageType, TFilterBankImage >
+::SetBand(unsigned int band, const ImageType * coefficients, const FilterBankImageType * filterBank, double factor)
+{
+  if ( band >= this->GetNumberOfBands() )
+    {
+    itkExceptionMacro(<< "Band " << band << " is out of range, NumberOfBands: " << this->GetNumberOfBands());
+    }
+  this->SetNthInput(1 + 2 * band, const_cast< ImageType * >( coefficients ));
+  this->SetNthInput(2 + 2 * band, const_cast< FilterBankImageType * >( filterBank ));
+  if ( this->m_BandFactors[band] != factor )
+    {
+    this->m_BandFactors[band] = factor;
+    this->Modified();
+    }
+}
+
+template< typename TImageType, typename TFilterBankImage >
+const typename FrequencyBandAccumulateImageFilter< TImageType, TFilterBankImage >::ImageType *
+FrequencyBandAccumulateImageFilter< TImageType, TFilterBankImage >
+::GetBandCoefficients(unsigned int band) const
+{
+  return itkDynamicCastInDebugMode< const ImageType * >( this->ProcessObject::GetInput(1 + 2 * band) );
+}
+
+template< typename TImageType, typename TFilterBankImage >
+const typename FrequencyBandAccumulateImageFilter< TImageType, TFilterBankImage >::FilterBankImageType *
+FrequencyBandAccumulateImageFilter< TImageType, TFilterBankImage >
+::GetBandFilterBank(unsigned int band) const
+{
+  return itkDynamicCastInDebugMode< const FilterBankImageType * >( this->ProcessObject::GetInput(2 + 2 * band) );
+}
+
+template< typename TImageType, typename TFilterBankImage >
+double
+FrequencyBandAccumulateImageFilter< TImageType, TFilterBankImage >
+::GetBandFactor(unsigned int band) const
+{
+  return this->m_BandFactors.at(band);
+}
+
+template< typename TImageType, typename TFilterBankImage >
+void
+FrequencyBandAccumulateImageFilter< TImageType, TFilterBankImage >
+::VerifyInputInformation() ITKv5_CONST
+{
+  const ImageType * input = this->GetInput();
+  if ( !input )
+    {
+    return;
+    }
+  const typename ImageType::SizeType & inputSize = input->GetLargestPossibleRegion().GetSize();
+  for ( unsigned int band = 0; band < this->GetNumberOfBands(); ++band )
+    {
+    const ImageType * coefficients = this->GetBandCoefficients(band);
+    const FilterBankImageType * filterBank = this->GetBandFilterBank(band);
+    if ( ( coefficients && coefficients->GetLargestPossibleRegion().GetSize() != inputSize )
+         || ( filterBank && filterBank->GetLargestPossibleRegion().GetSize() != inputSize ) )
+      {
+      itkExceptionMacro(<< "The size of the coefficients or the filter bank of band " << band
+                        << " is different than the size of the input: " << inputSize);
+      }
+    }
+}
+
+template< typename TImageType, typename TFilterBankImage >
+void
+FrequencyBandAccumulateImageFilter< TImageType, TFilterBankImage >
+::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  for ( unsigned int band = 0; band < this->GetNumberOfBands(); ++band )
+    {
+    auto * coefficients = const_cast< ImageType * >( this->GetBandCoefficients(band) );
+    auto * filterBank = const_cast< FilterBankImageType * >( this->GetBandFilterBank(band) );
+    if ( coefficients )
+      {
+      coefficients->SetRequestedRegionToLargestPossibleRegion();
+      }
+    if ( filterBank )
+      {
+      filterBank->SetRequestedRegionToLargestPossibleRegion();
+      }
+    }
+}
+
+template< typename TImageType, typename TFilterBankImage >
+void
+FrequencyBandAccumulateImageFilter< TImageType, TFilterBankImage >
+::DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread)
+{
+  const ImageType * input = this->GetInput();
+  ImageType * output = this->GetOutput();
+  const unsigned int numberOfBands = this->GetNumberOfBands();
+  const IndexType & outputStart = output->GetLargestPossibleRegion().GetIndex();
+  const IndexType & inputStart = input->GetLargestPossibleRegion().GetIndex();
+
+  using ValueType = typename NumericTraits< PixelType >::ValueType;
+  using FilterBankPixelType = typename FilterBankImageType::PixelType;
+  const auto scale = static_cast< ValueType >( this->m_Scale );
+  const Functor::FilterBankMultiply< PixelType, FilterBankPixelType > multiply;
+
+  std::vector< const ImageType * > coefficients(numberOfBands);
+  std::vector< const FilterBankImageType * > filterBanks(numberOfBands);
+  std::vector< ValueType > factors(numberOfBands);
+  // Start of the current line in the buffer of each band.
+  std::vector< const PixelType * > coefficientsLines(numberOfBands);
+  std::vector< const FilterBankPixelType * > filterBankLines(numberOfBands);
+  for ( unsigned int band = 0; band < numberOfBands; ++band )
+    {
+    coefficients[band] = this->GetBandCoefficients(band);
+    filterBanks[band] = this->GetBandFilterBank(band);
+    factors[band] = static_cast< ValueType >( this->m_BandFactors[band] );
+    }
+
+  ImageScanlineIterator< ImageType > outIt(output, outputRegionForThread);
+  while ( !outIt.IsAtEnd() )
+    {
+    const IndexType outputIndex = outIt.GetIndex();
+    IndexType relativeIndex;
+    IndexType inputIndex;
+    for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
+      {
+      relativeIndex[dim] = outputIndex[dim] - outputStart[dim];
+      inputIndex[dim] = relativeIndex[dim] + inputStart[dim];
+      }
+    // Read before writing the same bin when running in place.
+    const PixelType * inputLine = input->GetBufferPointer() + input->ComputeOffset(inputIndex);
+    for ( unsigned int band = 0; band < numberOfBands; ++band )
+      {
+      IndexType coefficientsIndex = relativeIndex;
+      typename FilterBankImageType::IndexType filterBankIndex;
+      const IndexType & coefficientsStart = coefficients[band]->GetLargestPossibleRegion().GetIndex();
+      const typename FilterBankImageType::IndexType & filterBankStart =
+        filterBanks[band]->GetLargestPossibleRegion().GetIndex();
+      for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
+        {
+        coefficientsIndex[dim] += coefficientsStart[dim];
+        filterBankIndex[dim] = relativeIndex[dim] + filterBankStart[dim];
+        }
+      coefficientsLines[band] = coefficients[band]->GetBufferPointer()
+        + coefficients[band]->ComputeOffset(coefficientsIndex);
+      filterBankLines[band] = filterBanks[band]->GetBufferPointer()
+        + filterBanks[band]->ComputeOffset(filterBankIndex);
+      }
+    for ( OffsetValueType x = 0; !outIt.IsAtEndOfLine(); ++x )
+      {
+      PixelType sum = NumericTraits< PixelType >::ZeroValue();
+      for ( unsigned int band = 0; band < numberOfBands; ++band )
+        {
+        sum += multiply(coefficientsLines[band][x], filterBankLines[band][x]) * factors[band];
+        }
+      sum += inputLine[x];
+      outIt.Set(sum * scale);
+      ++outIt;
+      }
+    outIt.NextLine();
+    }
+}
+
+template< typename TImageType, typename TFilterBankImage >
+void
+FrequencyBandAccumulateImageFilter< TImageType, TFilterBankImage >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "NumberOfBands: " << this->GetNumberOfBands() << std::endl;
+  os << indent << "BandFactors: [";
+  for ( unsigned int band = 0; band < this->GetNumberOfBands(); ++band )
+    {
+    os << ( band > 0 ? ", " : "" ) << this->m_BandFactors[band];
+    }
+  os << "]" << std::endl;
+  os << indent << "Scale: " << this->m_Scale << std::endl;
+}
+} // end namespace itk
+
+#endif
@@ -29,8 +29,8 @@ namespace itk
  * FrequencyExpandImageFilter increases the size of an image in the frequency domain
  * (for example, the output of a FFTImageFilter), by an integer
  * factor in each dimension.
- * The output image is composed by the input image, but all the new high
- * frequency pixels are set to Zero, no interpolation is made.
+ * The output image is composed by copies of the input image, the new high frequency
+ * pixels are the aliases of the input frequencies, no interpolation is made.
  *
  * Note that the input image shouldn't be shifted by ShiftFFTImageFilter.
  * It must conserve the following standard strucuture in frequency (in all dims):
@@ -53,6 +53,11 @@ namespace itk
  *
  * OutputSpacing[j] = InputSpacing[j] / ExpandFactors[j]
  *
+ * With HalfHermitian on, input and output have the layout of RealToHalfHermitianForwardFFTImageFilter:
+ * only the non-negative frequencies of the x dimension are stored.
+ * The output is equal to the non-negative x half of the output of the full spectrum.
+ * Use GetOutputActualXDimensionIsOdd to continue the pipeline.
+ *
  * The filter is templated over the input image, and will produce the same image type for the output.
  *
  * Example (Odd):
@@ -79,6 +84,12 @@ namespace itk
  * the positive frequencies: index <= floor(inputSize/2.0) at the begining of the output, including zero component, and
  * negative frequencies: index > floor(inputSize/2.0) (>= if even) at the end.
  *
+ * With an expand factor f, the input is pasted f times per dimension, at m * inputSize, m < f,
+ * so each output bin k takes the input bin k mod inputSize. This is the adjoint of FrequencyShrinkImageFilter,
+ * equivalent to the insertion of f - 1 zeros between samples in the spatial domain.
+ * A factor of 1 leaves the dimension untouched.
+ * The copies tile the output, each output bin is computed from its source bin in one multi-threaded pass.
+ *
  * If inputSize[dim] is even, Nyquist (highest) freq is unique, but shared between negative and positive frequencies. So this freq (index=4) it is copied to the output: index >= floor(inputSize/2.0).
  *
  * If the input image is generated from an FFT of a real image, then the input is hermitian;
@@ -146,13 +157,24 @@ public:
    * \sa ProcessObject::GenerateOutputInformaton() */
   void GenerateOutputInformation() override;
 
-  /** FrequencyExpandImageFilter needs a smaller input requested region than the output
-   * requested region.  As such, ShrinkImageFilter needs to provide an
-   * implementation for GenerateInputRequestedRegion() in order to inform
-   * the pipeline execution model.
+  /** Each output bin takes the input bin k mod inputSize, so any output requested region
+   * can require the whole input. The input requested region is its largest possible region.
    * \sa ProcessObject::GenerateInputRequestedRegion() */
   void GenerateInputRequestedRegion() override;
 
+  /** Flag for input and output with half-hermitian layout. Off by default. */
+  itkGetConstMacro(HalfHermitian, bool);
+  itkSetMacro(HalfHermitian, bool);
+  itkBooleanMacro(HalfHermitian);
+
+  /** Only used if HalfHermitian is On: the x size of the full spectrum of the input is odd. */
+  itkGetConstMacro(ActualXDimensionIsOdd, bool);
+  itkSetMacro(ActualXDimensionIsOdd, bool);
+  itkBooleanMacro(ActualXDimensionIsOdd);
+
+  /** The x size of the full spectrum of the output is odd. Computed in GenerateOutputInformation. */
+  itkGetConstMacro(OutputActualXDimensionIsOdd, bool);
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
   itkConceptMacro( ImageTypeHasNumericTraitsCheck,
@@ -166,10 +188,16 @@ protected:
   void PrintSelf(std::ostream & os, Indent indent) const override;
 
 
-  void GenerateData() override;
+  void DynamicThreadedGenerateData(const ImageRegionType & outputRegionForThread) override;
+
+  /** Direct computation of the output bins when HalfHermitian is On. */
+  void DynamicThreadedGenerateDataHalfHermitian(const ImageRegionType & outputRegionForThread);
 
 private:
   ExpandFactorsType m_ExpandFactors;
+  bool              m_HalfHermitian;
+  bool              m_ActualXDimensionIsOdd;
+  bool              m_OutputActualXDimensionIsOdd;
 };
 } // end namespace itk
 
@@ -19,9 +19,9 @@
 #define itkFrequencyExpandImageFilter_hxx
 
 #include <itkFrequencyExpandImageFilter.h>
-#include <itkProgressReporter.h>
-#include "itkInd2Sub.h"
-#include <itkPasteImageFilter.h>
+#include <itkImageScanlineIterator.h>
+#include <itkImageRegionIteratorWithIndex.h>
+#include "itkWaveletUtilities.h"
 
 namespace itk
 {
@@ -31,12 +31,17 @@ namespace itk
 template< typename TImageType >
 FrequencyExpandImageFilter< TImageType >
 ::FrequencyExpandImageFilter()
+  : m_HalfHermitian(false),
+  m_ActualXDimensionIsOdd(false),
+  m_OutputActualXDimensionIsOdd(false)
 {
   // Set default factors to 1
   for ( unsigned int j = 0; j < ImageDimension; j++ )
     {
     m_ExpandFactors[j] = 2;
     }
+
+  this->DynamicMultiThreadingOn();
 }
 
 /**
@@ -56,6 +61,9 @@ FrequencyExpandImageFilter< TImageType >
     os << m_ExpandFactors[j] << ", ";
     }
   os << m_ExpandFactors[j] << "]" << std::endl;
+  os << indent << "HalfHermitian: " << this->m_HalfHermitian << std::endl;
+  os << indent << "ActualXDimensionIsOdd: " << this->m_ActualXDimensionIsOdd << std::endl;
+  os << indent << "OutputActualXDimensionIsOdd: " << this->m_OutputActualXDimensionIsOdd << std::endl;
 }
 
 /**
@@ -92,96 +100,84 @@ FrequencyExpandImageFilter< TImageType >
 
 /**
  * Implementation Detail:
- * Assume Expand Factor = 2
- * Input image is pasted 2^ImageDimension times to form the outputImage.
- * The implementation calculate the number of different regions in an image,
- * depending on the dimension:
- * numberOfRegions = 2^dim (positive and negative frequencies per dim)
- * then uses function to convert a linear array of regions [0, ..., numberOfRegions - 1]
- * to binary subindices (only two options: positive or negative region)
- * In 3D: numberOfRegions = Nr = 2^3 = 8
- * sizeOfSubindices = [2,2,2]
- * Region = 0       -----> Ind2Sub(   0, [2,2,2]) = [0,0,0]
- * Region = 1       -----> Ind2Sub(   1, [2,2,2]) = [1,0,0]
- * Region = Nr - 1  -----> Ind2Sub(Nr-1, [2,2,2]) = [1,1,1]
- * So, if the result of Ind2Sub is 0 we paste the positive frequencies, if 1, negative freq
+ * Input image is pasted prod(ExpandFactors) times to form the outputImage, at m * inputSize, m < ExpandFactor,
+ * per dimension. The copies tile the output, so each output bin k takes the input bin k mod inputSize,
+ * and no bin has to be zeroed.
+ * For even sizes the unique Nyquist bin is copied to the end of the positive frequencies and to the start
+ * of the negative ones of each copy, keeping the hermitian property of the input.
+ * Along a scanline the input index only wraps to the start of the input when reaching inputSize.
  */
 template< typename TImageType >
 void
 FrequencyExpandImageFilter< TImageType >
-::GenerateData()
+::DynamicThreadedGenerateData(const ImageRegionType & outputRegionForThread)
 {
-  const ImageType * inputPtr  = this->GetInput();
-  ImagePointer outputPtr = this->GetOutput();
-
-  // complex is initialized to zero directly.
-
-  this->AllocateOutputs();
-  outputPtr->FillBuffer(0);
-  typename TImageType::SizeType inputSize = inputPtr->GetLargestPossibleRegion().GetSize();
-  typename TImageType::IndexType inputOriginIndex = inputPtr->GetLargestPossibleRegion().GetIndex();
-  typename TImageType::SizeType outputSize = outputPtr->GetLargestPossibleRegion().GetSize();
-
-  const typename TImageType::IndexType indexRequested = outputPtr->GetLargestPossibleRegion().GetIndex();
-
-  // Manage ImageDimension array linearly:{{{
-  FixedArray< unsigned int, ImageDimension > nsizes;
-  unsigned int numberOfRegions = 1;
-  for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
+  if ( this->m_HalfHermitian )
     {
-    nsizes[dim]      = 2;
-    numberOfRegions *= nsizes[dim];
+    this->DynamicThreadedGenerateDataHalfHermitian(outputRegionForThread);
+    return;
     }
-  FixedArray< unsigned int, ImageDimension > subIndices;
-  /// }}}
 
-  // Prepare filter to paste the different regions into output.
-  using PasteFilterType = itk::PasteImageFilter< ImageType >;
-  typename PasteFilterType::Pointer pasteFilter = PasteFilterType::New();
-  pasteFilter->SetSourceImage(inputPtr);
-  pasteFilter->SetDestinationImage(outputPtr);
-  pasteFilter->InPlaceOn();
+  const ImageType * inputPtr = this->GetInput();
+  ImageType * outputPtr = this->GetOutput();
+  const typename TImageType::SizeType & inputSize = inputPtr->GetLargestPossibleRegion().GetSize();
+  const typename TImageType::IndexType & inputStart = inputPtr->GetLargestPossibleRegion().GetIndex();
+  const typename TImageType::IndexType & outputStart = outputPtr->GetLargestPossibleRegion().GetIndex();
+  const auto inputSizeX = static_cast< IndexValueType >( inputSize[0] );
 
-  using RegionType = typename ImageType::RegionType;
-  ProgressReporter progress(this, 0, numberOfRegions );
-  for ( unsigned int n = 0; n < numberOfRegions; ++n )
+  ImageScanlineIterator< ImageType > outIt(outputPtr, outputRegionForThread);
+  while ( !outIt.IsAtEnd() )
     {
-    subIndices = Ind2Sub< ImageDimension >(n, nsizes);
-    RegionType zoneRegion;
-    typename ImageType::SizeType zoneSize = inputSize;
-    typename ImageType::IndexType inputIndex = inputOriginIndex;
-    typename ImageType::IndexType outputIndex = indexRequested;
-    // We have to avoid break simmetry and the hermitian property.
-    // So the output of a ComplexInverseFFT will generate complex images with non-zero imaginary part.
+    const typename ImageType::IndexType outputIndex = outIt.GetIndex();
+    typename ImageType::IndexType inputIndex;
     for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
       {
-      if ( subIndices[dim] == 0 ) // positive frequencies
-        {
-        outputIndex[dim] = indexRequested[dim];
-        }
-      else // negative frequencies
+      inputIndex[dim] = inputStart[dim]
+        + ( outputIndex[dim] - outputStart[dim] ) % static_cast< IndexValueType >( inputSize[dim] );
+      }
+    IndexValueType inputX = inputIndex[0] - inputStart[0];
+    inputIndex[0] = inputStart[0];
+    const PixelType * inputLine = inputPtr->GetBufferPointer() + inputPtr->ComputeOffset(inputIndex);
+    while ( !outIt.IsAtEndOfLine() )
+      {
+      outIt.Set(inputLine[inputX]);
+      ++outIt;
+      if ( ++inputX == inputSizeX )
         {
-        outputIndex[dim] = indexRequested[dim] + outputSize[dim] - zoneSize[dim];
+        inputX = 0;
         }
       }
-    zoneRegion.SetIndex(inputIndex);
-    zoneRegion.SetSize(zoneSize);
-    itkDebugMacro( << "n:" << n << " region: " << zoneRegion);
+    outIt.NextLine();
+    }
+}
 
-    pasteFilter->SetSourceRegion(zoneRegion);
-    pasteFilter->SetDestinationIndex(outputIndex);
-    if ( n == numberOfRegions - 1 ) // Graft the output.
-      {
-      pasteFilter->GraftOutput(outputPtr);
-      pasteFilter->Update();
-      this->GraftOutput(pasteFilter->GetOutput() );
-      }
-    else // update output
+/**
+ * Half-hermitian layout: each output bin takes the input bin that DynamicThreadedGenerateData would copy on it,
+ * the bin of the full spectrum k mod inputSize per dimension.
+ */
+template< typename TImageType >
+void
+FrequencyExpandImageFilter< TImageType >
+::DynamicThreadedGenerateDataHalfHermitian(const ImageRegionType & outputRegionForThread)
+{
+  const ImageType * inputPtr = this->GetInput();
+  ImageType * outputPtr = this->GetOutput();
+
+  // Size of the full spectrum of the input.
+  typename TImageType::SizeType inputSize = inputPtr->GetLargestPossibleRegion().GetSize();
+  inputSize[0] = 2 * ( inputSize[0] - 1 ) + ( this->m_ActualXDimensionIsOdd ? 1 : 0 );
+  const typename TImageType::IndexType indexOrigOut = outputPtr->GetLargestPossibleRegion().GetIndex();
+
+  ImageRegionIteratorWithIndex< ImageType > outIt(outputPtr, outputRegionForThread);
+  for ( outIt.GoToBegin(); !outIt.IsAtEnd(); ++outIt )
+    {
+    const typename ImageType::IndexType outputIndex = outIt.GetIndex();
+    typename ImageType::IndexType fullIndex;
+    for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
       {
-      pasteFilter->Update();
-      outputPtr = pasteFilter->GetOutput();
+      fullIndex[dim] = ( outputIndex[dim] - indexOrigOut[dim] ) % static_cast< IndexValueType >(inputSize[dim]);
       }
-    progress.CompletedPixel();
+    outIt.Set(itk::utils::GetHalfHermitianPixel(inputPtr, fullIndex, inputSize));
     }
 }
 
@@ -196,46 +192,12 @@ FrequencyExpandImageFilter< TImageType >
   // Call the superclass' implementation of this method
   Superclass::GenerateInputRequestedRegion();
 
-  // Get pointers to the input and output
+  // Get pointer to the input
   auto * inputPtr = const_cast< TImageType * >( this->GetInput() );
-  const TImageType * outputPtr = this->GetOutput();
-
   itkAssertInDebugAndIgnoreInReleaseMacro( inputPtr != nullptr );
-  itkAssertInDebugAndIgnoreInReleaseMacro( outputPtr );
 
-  // We need to compute the input requested region (size and start index)
-  unsigned int i;
-  const typename TImageType::SizeType & outputRequestedRegionSize =
-    outputPtr->GetRequestedRegion().GetSize();
-  const typename TImageType::IndexType & outputRequestedRegionStartIndex =
-    outputPtr->GetRequestedRegion().GetIndex();
-
-  typename TImageType::SizeType inputRequestedRegionSize;
-  typename TImageType::IndexType inputRequestedRegionStartIndex;
-  /**
-   * inputRequestedSize = (outputRequestedSize / ExpandFactor) + 1)
-   * The extra 1 above is to take care of edge effects when streaming.
-   */
-  for ( i = 0; i < TImageType::ImageDimension; i++ )
-    {
-    inputRequestedRegionSize[i] =
-      (SizeValueType)std::ceil( (double)outputRequestedRegionSize[i]
-        / (double)m_ExpandFactors[i] ) + 1;
-
-    inputRequestedRegionStartIndex[i] =
-      (SizeValueType)std::floor( (double)outputRequestedRegionStartIndex[i]
-        / (double)m_ExpandFactors[i] );
-    }
-
-  typename TImageType::RegionType inputRequestedRegion;
-  inputRequestedRegion.SetSize(inputRequestedRegionSize);
-  inputRequestedRegion.SetIndex(inputRequestedRegionStartIndex);
-
-  // Make sure the requested region is within largest possible.
-  inputRequestedRegion.Crop( inputPtr->GetLargestPossibleRegion() );
-
-  // Set the input requested region.
-  inputPtr->SetRequestedRegion(inputRequestedRegion);
+  // Each output bin takes the input bin k mod inputSize: the whole input is needed.
+  inputPtr->SetRequestedRegionToLargestPossibleRegion();
 }
 
 /**
@@ -278,6 +240,14 @@ FrequencyExpandImageFilter< TImageType >
     outputSpacing[i]    = inputSpacing[i] / m_ExpandFactors[i];
     outputSize[i]       = inputSize[i] * static_cast< SizeValueType >(m_ExpandFactors[i]);
     outputStartIndex[i] = inputStartIndex[i];
+    if ( i == 0 && this->m_HalfHermitian )
+      {
+      // Expand the full spectrum, store only its non-negative half.
+      const SizeValueType fullOutputSize = ( 2 * ( inputSize[0] - 1 ) + ( this->m_ActualXDimensionIsOdd ? 1 : 0 ) )
+        * static_cast< SizeValueType >(m_ExpandFactors[0]);
+      this->m_OutputActualXDimensionIsOdd = ( fullOutputSize % 2 == 1 );
+      outputSize[0] = fullOutputSize / 2 + 1;
+      }
     // outputStartIndex[i] = inputStartIndex[i] * (IndexValueType)m_ExpandFactors[i];
     // const double fraction = (double)( m_ExpandFactors[i] - 1 ) / (double)m_ExpandFactors[i];
     // inputOriginShift[i] = -( inputSpacing[i] / 2.0 ) * fraction;
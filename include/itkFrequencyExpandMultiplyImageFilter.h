@@ -0,0 +1,120 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFrequencyExpandMultiplyImageFilter_h
+#define itkFrequencyExpandMultiplyImageFilter_h
+
+#include <itkImageToImageFilter.h>
+#include <itkFixedArray.h>
+
+namespace itk
+{
+/** \class FrequencyExpandMultiplyImageFilter
+ * \brief Expand an image in the frequency domain, multiply it by a filter bank image of the expanded size
+ * and by a constant, in a single pass.
+ *
+ * Equivalent to FrequencyExpandImageFilter, MultiplyImageFilter by Scale and
+ * FrequencyFilterBankMultiplyImageFilter: each output bin is
+ * \f$ O(k) = s F(k) I(k \bmod M) \f$
+ * where M is the input size, F the filter bank and s the Scale.
+ * No image of the expanded size is allocated besides the output.
+ *
+ * Used for the low-pass of each level in WaveletFrequencyInverse, with the upsample correction as Scale.
+ * The filter bank (SetFilterBank) can have a real pixel type \sa Functor::FilterBankMultiply.
+ * Only its size has to match the output, its metadata is ignored.
+ * The output information is the same than in FrequencyExpandImageFilter.
+ * The half-hermitian layout is not supported.
+ *
+ * \sa FrequencyExpandImageFilter
+ * \sa FrequencyShrinkMultiplyImageFilter
+ * \ingroup IsotropicWavelets
+ */
+template< typename TImageType, typename TFilterBankImage = TImageType >
+class FrequencyExpandMultiplyImageFilter:
+  public ImageToImageFilter< TImageType, TImageType >
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(FrequencyExpandMultiplyImageFilter);
+
+  /** Standard class type alias. */
+  using Self = FrequencyExpandMultiplyImageFilter;
+  using Superclass = ImageToImageFilter< TImageType, TImageType >;
+  using Pointer = SmartPointer< Self >;
+  using ConstPointer = SmartPointer< const Self >;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(FrequencyExpandMultiplyImageFilter, ImageToImageFilter);
+
+  /** Typedef to images */
+  using ImageType = TImageType;
+  using PixelType = typename ImageType::PixelType;
+  using IndexType = typename ImageType::IndexType;
+  using OutputImageRegionType = typename Superclass::OutputImageRegionType;
+  using FilterBankImageType = TFilterBankImage;
+
+  static constexpr unsigned int ImageDimension = TImageType::ImageDimension;
+
+  using ExpandFactorsType = FixedArray< unsigned int, ImageDimension >;
+
+  /** Image of the filter bank multiplying the expanded input. */
+  itkSetInputMacro(FilterBank, FilterBankImageType);
+  itkGetInputMacro(FilterBank, FilterBankImageType);
+
+  /** Set the expand factors. Values are clamped to
+   * a minimum value of 1. Default is 2 for all dimensions. */
+  itkSetMacro(ExpandFactors, ExpandFactorsType);
+  void SetExpandFactors(unsigned int factor);
+  itkGetConstReferenceMacro(ExpandFactors, ExpandFactorsType);
+
+  /** Constant multiplying the output. 1 by default. */
+  itkSetMacro(Scale, double);
+  itkGetConstMacro(Scale, double);
+
+#ifdef ITK_USE_CONCEPT_CHECKING
+  itkConceptMacro( ImageTypeHasNumericTraitsCheck,
+                   ( Concept::HasNumericTraits< PixelType > ) );
+#endif
+
+protected:
+  FrequencyExpandMultiplyImageFilter();
+  ~FrequencyExpandMultiplyImageFilter() override {}
+  void PrintSelf(std::ostream & os, Indent indent) const override;
+
+  void GenerateOutputInformation() override;
+
+  /** The whole input and filter bank are needed, independently of the output requested region. */
+  void GenerateInputRequestedRegion() override;
+
+  /** The filter bank only has to match the size of the output. */
+  void VerifyInputInformation() ITKv5_CONST override;
+
+  void DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+private:
+  ExpandFactorsType m_ExpandFactors;
+  double            m_Scale;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkFrequencyExpandMultiplyImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,191 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFrequencyExpandMultiplyImageFilter_hxx
+#define itkFrequencyExpandMultiplyImageFilter_hxx
+
+#include "itkFrequencyExpandMultiplyImageFilter.h"
+#include "itkFrequencyFilterBankMultiplyImageFilter.h"
+#include <itkImageScanlineIterator.h>
+#include <itkNumericTraits.h>
+
+namespace itk
+{
+template< typename TImageType, typename TFilterBankImage >
+FrequencyExpandMultiplyImageFilter< TImageType, TFilterBankImage >
+::FrequencyExpandMultiplyImageFilter()
+  : m_Scale(1.0)
+{
+  this->m_ExpandFactors.Fill(2);
+  this->AddRequiredInputName("FilterBank");
+
+  this->DynamicMultiThreadingOn();
+}
+
+template< typename TImageType, typename TFilterBankImage >
+void
+FrequencyExpandMultiplyImageFilter< TImageType, TFilterBankImage >
+::SetExpandFactors(unsigned int factor)
+{
+  const unsigned int clampedFactor = factor < 1 ? 1 : factor;
+  for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
+    {
+    if ( this->m_ExpandFactors[dim] != clampedFactor )
+      {
+      this->m_ExpandFactors.Fill(clampedFactor);
+      this->Modified();
+      return;
+      }
+    }
+}
+
+template< typename TImageType, typename TFilterBankImage >
+void
+FrequencyExpandMultiplyImageFilter< TImageType, TFilterBankImage >
+::VerifyInputInformation() ITKv5_CONST
+{
+  const ImageType * input = this->GetInput();
+  const FilterBankImageType * filterBank = this->GetFilterBank();
+  if ( !input || !filterBank )
+    {
+    return;
+    }
+  typename ImageType::SizeType outputSize = input->GetLargestPossibleRegion().GetSize();
+  for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
+    {
+    outputSize[dim] *= static_cast< SizeValueType >( this->m_ExpandFactors[dim] );
+    }
+  if ( outputSize != filterBank->GetLargestPossibleRegion().GetSize() )
+    {
+    itkExceptionMacro(<< "The size of the filter bank: " << filterBank->GetLargestPossibleRegion().GetSize()
+                      << " is different than the size of the output: " << outputSize);
+    }
+}
+
+template< typename TImageType, typename TFilterBankImage >
+void
+FrequencyExpandMultiplyImageFilter< TImageType, TFilterBankImage >
+::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+
+  const ImageType * inputPtr = this->GetInput();
+  ImageType * outputPtr = this->GetOutput();
+  itkAssertInDebugAndIgnoreInReleaseMacro( inputPtr );
+  itkAssertInDebugAndIgnoreInReleaseMacro( outputPtr != nullptr );
+
+  // Same output information than FrequencyExpandImageFilter.
+  const typename ImageType::SizeType & inputSize = inputPtr->GetLargestPossibleRegion().GetSize();
+  typename ImageType::SpacingType outputSpacing(inputPtr->GetSpacing());
+  typename ImageType::SizeType outputSize;
+  for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
+    {
+    outputSpacing[dim] = outputSpacing[dim] / this->m_ExpandFactors[dim];
+    outputSize[dim] = inputSize[dim] * static_cast< SizeValueType >( this->m_ExpandFactors[dim] );
+    }
+  outputPtr->SetSpacing(outputSpacing);
+  outputPtr->SetOrigin(inputPtr->GetOrigin());
+
+  typename ImageType::RegionType outputLargestPossibleRegion;
+  outputLargestPossibleRegion.SetSize(outputSize);
+  outputLargestPossibleRegion.SetIndex(inputPtr->GetLargestPossibleRegion().GetIndex());
+  outputPtr->SetLargestPossibleRegion(outputLargestPossibleRegion);
+}
+
+template< typename TImageType, typename TFilterBankImage >
+void
+FrequencyExpandMultiplyImageFilter< TImageType, TFilterBankImage >
+::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  auto * inputPtr = const_cast< ImageType * >( this->GetInput() );
+  auto * filterBankPtr = const_cast< FilterBankImageType * >( this->GetFilterBank() );
+  if ( inputPtr )
+    {
+    inputPtr->SetRequestedRegionToLargestPossibleRegion();
+    }
+  if ( filterBankPtr )
+    {
+    filterBankPtr->SetRequestedRegionToLargestPossibleRegion();
+    }
+}
+
+template< typename TImageType, typename TFilterBankImage >
+void
+FrequencyExpandMultiplyImageFilter< TImageType, TFilterBankImage >
+::DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread)
+{
+  const ImageType * input = this->GetInput();
+  const FilterBankImageType * filterBank = this->GetFilterBank();
+  ImageType * output = this->GetOutput();
+
+  const typename ImageType::SizeType & inputSize = input->GetLargestPossibleRegion().GetSize();
+  const IndexType & outputStart = output->GetLargestPossibleRegion().GetIndex();
+  const IndexType & inputStart = input->GetLargestPossibleRegion().GetIndex();
+  const typename FilterBankImageType::IndexType & filterBankStart = filterBank->GetLargestPossibleRegion().GetIndex();
+  const auto inputSizeX = static_cast< IndexValueType >( inputSize[0] );
+
+  using ValueType = typename NumericTraits< PixelType >::ValueType;
+  const auto scale = static_cast< ValueType >( this->m_Scale );
+  const Functor::FilterBankMultiply< PixelType, typename FilterBankImageType::PixelType > multiply;
+  const typename FilterBankImageType::PixelType * filterBankBuffer = filterBank->GetBufferPointer();
+
+  ImageScanlineIterator< ImageType > outIt(output, outputRegionForThread);
+  while ( !outIt.IsAtEnd() )
+    {
+    const IndexType outputIndex = outIt.GetIndex();
+    IndexType inputIndex;
+    typename FilterBankImageType::IndexType filterBankIndex;
+    for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
+      {
+      // The output is tiled with copies of the input, as in FrequencyExpandImageFilter.
+      inputIndex[dim] = inputStart[dim]
+        + ( outputIndex[dim] - outputStart[dim] ) % static_cast< IndexValueType >( inputSize[dim] );
+      filterBankIndex[dim] = outputIndex[dim] - outputStart[dim] + filterBankStart[dim];
+      }
+    IndexValueType inputX = inputIndex[0] - inputStart[0];
+    inputIndex[0] = inputStart[0];
+    const PixelType * inputLine = input->GetBufferPointer() + input->ComputeOffset(inputIndex);
+    OffsetValueType filterBankOffset = filterBank->ComputeOffset(filterBankIndex);
+    while ( !outIt.IsAtEndOfLine() )
+      {
+      outIt.Set(multiply(inputLine[inputX], filterBankBuffer[filterBankOffset]) * scale);
+      ++outIt;
+      ++filterBankOffset;
+      if ( ++inputX == inputSizeX )
+        {
+        inputX = 0;
+        }
+      }
+    outIt.NextLine();
+    }
+}
+
+template< typename TImageType, typename TFilterBankImage >
+void
+FrequencyExpandMultiplyImageFilter< TImageType, TFilterBankImage >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "ExpandFactors: " << this->m_ExpandFactors << std::endl;
+  os << indent << "Scale: " << this->m_Scale << std::endl;
+}
+} // end namespace itk
+
+#endif
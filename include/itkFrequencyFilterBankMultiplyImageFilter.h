@@ -0,0 +1,116 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFrequencyFilterBankMultiplyImageFilter_h
+#define itkFrequencyFilterBankMultiplyImageFilter_h
+
+#include <itkBinaryFunctorImageFilter.h>
+#include <itkNumericTraits.h>
+#include <type_traits>
+
+namespace itk
+{
+namespace Functor
+{
+/** \class FilterBankMultiply
+ * \brief Multiply a frequency coefficient by the value of a filter bank.
+ *
+ * Real filter banks (float or double) are multiplied with the components of the coefficient,
+ * avoiding the full complex product. Complex filter banks are multiplied as complex numbers.
+ *
+ * \ingroup IsotropicWavelets
+ */
+template< typename TInputPixel, typename TFilterBankPixel, typename TOutputPixel = TInputPixel >
+class FilterBankMultiply
+{
+public:
+  using ValueType = typename NumericTraits< TInputPixel >::ValueType;
+
+  bool operator!=(const FilterBankMultiply &) const
+  {
+    return false;
+  }
+
+  bool operator==(const FilterBankMultiply & other) const
+  {
+    return !( *this != other );
+  }
+
+  inline TOutputPixel operator()(const TInputPixel & input, const TFilterBankPixel & filterBank) const
+  {
+    return this->Multiply(input, filterBank, std::is_arithmetic< TFilterBankPixel >());
+  }
+
+private:
+  inline TOutputPixel Multiply(const TInputPixel & input, const TFilterBankPixel & filterBank, std::true_type) const
+  {
+    return static_cast< TOutputPixel >( input * static_cast< ValueType >(filterBank) );
+  }
+
+  inline TOutputPixel Multiply(const TInputPixel & input, const TFilterBankPixel & filterBank, std::false_type) const
+  {
+    return static_cast< TOutputPixel >( input * static_cast< TInputPixel >(filterBank) );
+  }
+};
+} // end namespace Functor
+
+/** \class FrequencyFilterBankMultiplyImageFilter
+ * \brief Multiply a frequency image (input 1) by an image of a filter bank (input 2).
+ *
+ * The filter bank can be stored with a real pixel type, even float,
+ * while the frequency image is complex. \sa Functor::FilterBankMultiply
+ *
+ * The filter banks are generated with unit spacing and origin at zero,
+ * only the size has to match the frequency image, so the metadata of the inputs is not verified.
+ * The output has the metadata of the frequency image.
+ *
+ * \sa WaveletFrequencyFilterBankGenerator
+ * \ingroup IsotropicWavelets
+ */
+template< typename TInputImage, typename TFilterBankImage, typename TOutputImage = TInputImage >
+class FrequencyFilterBankMultiplyImageFilter:
+  public BinaryFunctorImageFilter< TInputImage, TFilterBankImage, TOutputImage,
+    Functor::FilterBankMultiply< typename TInputImage::PixelType,
+      typename TFilterBankImage::PixelType, typename TOutputImage::PixelType > >
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(FrequencyFilterBankMultiplyImageFilter);
+
+  /** Standard class type alias. */
+  using Self = FrequencyFilterBankMultiplyImageFilter;
+  using Superclass = BinaryFunctorImageFilter< TInputImage, TFilterBankImage, TOutputImage,
+    Functor::FilterBankMultiply< typename TInputImage::PixelType,
+      typename TFilterBankImage::PixelType, typename TOutputImage::PixelType > >;
+  using Pointer = SmartPointer< Self >;
+  using ConstPointer = SmartPointer< const Self >;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(FrequencyFilterBankMultiplyImageFilter, BinaryFunctorImageFilter);
+
+protected:
+  FrequencyFilterBankMultiplyImageFilter() {}
+  ~FrequencyFilterBankMultiplyImageFilter() override {}
+
+  /** The filter bank only has to match the size of the frequency image. */
+  void VerifyInputInformation() ITKv5_CONST override {}
+};
+} // end namespace itk
+
+#endif
@@ -0,0 +1,145 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFrequencyResamplingSelector_h
+#define itkFrequencyResamplingSelector_h
+
+#include <itkObject.h>
+#include <itkObjectFactory.h>
+#include <itkFixedArray.h>
+#include <itkImageToImageFilter.h>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace itk
+{
+/** \class FrequencyResamplingSelector
+ * \brief Choose between resampling in the frequency domain, or via inverse FFT, from a calibration benchmark.
+ *
+ * FrequencyShrinkImageFilter and FrequencyShrinkViaInverseFFTImageFilter give the same result for the spectrum
+ * of a real image when the size is a multiple of the shrink factor, as FrequencyExpandImageFilter
+ * and FrequencyExpandViaInverseFFTImageFilter do for any size. Their relative speed depends on the size,
+ * the factors, the number of threads and the FFT backend.
+ *
+ * The first time a size, factors and number of work units are requested, both filters are run on a synthetic
+ * image of that size (one warm-up run and NumberOfCalibrationRuns timed runs, keeping the fastest)
+ * and the fastest method is stored. Next requests return the stored method.
+ * The frequency method is chosen without calibration when the methods are not equivalent, or if the FFT
+ * does not support the size.
+ *
+ * Use GetInstance() to access the process-wide selector, or New() for a private one.
+ *
+ * \sa WaveletFrequencyForward::AutoSelectShrinkFilter
+ * \sa WaveletFrequencyInverse::AutoSelectExpandFilter
+ * \ingroup IsotropicWavelets
+ */
+template< typename TImageType >
+class FrequencyResamplingSelector:
+  public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(FrequencyResamplingSelector);
+
+  /** Standard type alias */
+  using Self = FrequencyResamplingSelector;
+  using Superclass = Object;
+  using Pointer = SmartPointer< Self >;
+  using ConstPointer = SmartPointer< const Self >;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(FrequencyResamplingSelector, Object);
+
+  using ImageType = TImageType;
+  using SizeType = typename ImageType::SizeType;
+  static constexpr unsigned int ImageDimension = ImageType::ImageDimension;
+  using FactorsType = FixedArray< unsigned int, ImageDimension >;
+  /** Common base of the resampling filters. */
+  using ResamplingFilterType = ImageToImageFilter< ImageType, ImageType >;
+
+  /** Frequency: FrequencyShrinkImageFilter or FrequencyExpandImageFilter.
+   * ViaInverseFFT: FrequencyShrinkViaInverseFFTImageFilter or FrequencyExpandViaInverseFFTImageFilter. */
+  enum class MethodType : uint8_t { Frequency, ViaInverseFFT };
+
+  /** Process-wide instance. */
+  static Pointer GetInstance();
+
+  /** Fastest method to shrink an image of inputSize by factors.
+   * numberOfWorkUnits of the filters, 0 for the global default. */
+  MethodType SelectShrinkMethod(const SizeType & inputSize, const FactorsType & factors,
+    unsigned int numberOfWorkUnits = 0);
+
+  /** Fastest method to expand an image of inputSize by factors. */
+  MethodType SelectExpandMethod(const SizeType & inputSize, const FactorsType & factors,
+    unsigned int numberOfWorkUnits = 0);
+
+  /** New shrink filter of the given method with factors set. */
+  static typename ResamplingFilterType::Pointer MakeShrinkFilter(MethodType method, const FactorsType & factors);
+
+  /** New expand filter of the given method with factors set. */
+  static typename ResamplingFilterType::Pointer MakeExpandFilter(MethodType method, const FactorsType & factors);
+
+  /** Timed runs of each method per calibration, the fastest one is compared. 3 by default. */
+  void SetNumberOfCalibrationRuns(unsigned int numberOfCalibrationRuns);
+  unsigned int GetNumberOfCalibrationRuns() const;
+
+  /** Number of calibrations performed, i.e. requests not found in the stored choices. */
+  SizeValueType GetNumberOfCalibrations() const;
+  SizeValueType GetNumberOfEntries() const;
+
+  /** Remove all the stored choices. */
+  void Clear();
+
+protected:
+  FrequencyResamplingSelector();
+  ~FrequencyResamplingSelector() override {}
+  void PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  struct KeyType
+  {
+    std::vector< SizeValueType > Size;
+    std::vector< unsigned int >  Factors;
+    unsigned int                 NumberOfWorkUnits;
+    bool                         Expand;
+
+    bool operator<(const KeyType & other) const;
+  };
+  using EntriesType = std::map< KeyType, MethodType >;
+
+  MethodType SelectMethod(const SizeType & inputSize, const FactorsType & factors,
+    unsigned int numberOfWorkUnits, bool expand);
+
+  /** Fastest wall time in seconds of updating filter, after a warm-up run. */
+  double TimeFilter(ResamplingFilterType * filter, unsigned int numberOfRuns) const;
+
+  mutable std::mutex m_Mutex;
+  EntriesType        m_Entries;
+  unsigned int       m_NumberOfCalibrationRuns;
+  SizeValueType      m_NumberOfCalibrations;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkFrequencyResamplingSelector.hxx"
+#endif
+
+#endif
@@ -0,0 +1,266 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFrequencyResamplingSelector_hxx
+#define itkFrequencyResamplingSelector_hxx
+
+#include "itkFrequencyResamplingSelector.h"
+#include "itkFrequencyShrinkImageFilter.h"
+#include "itkFrequencyShrinkViaInverseFFTImageFilter.h"
+#include "itkFrequencyExpandImageFilter.h"
+#include "itkFrequencyExpandViaInverseFFTImageFilter.h"
+#include <itkMultiThreaderBase.h>
+#include <itkNumericTraits.h>
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <tuple>
+
+namespace itk
+{
+template< typename TImageType >
+bool
+FrequencyResamplingSelector< TImageType >::KeyType
+::operator<(const KeyType & other) const
+{
+  return std::tie(this->Size, this->Factors, this->NumberOfWorkUnits, this->Expand)
+         < std::tie(other.Size, other.Factors, other.NumberOfWorkUnits, other.Expand);
+}
+
+template< typename TImageType >
+FrequencyResamplingSelector< TImageType >
+::FrequencyResamplingSelector()
+  : m_NumberOfCalibrationRuns(3),
+  m_NumberOfCalibrations(0)
+{
+}
+
+template< typename TImageType >
+typename FrequencyResamplingSelector< TImageType >::Pointer
+FrequencyResamplingSelector< TImageType >
+::GetInstance()
+{
+  // Initialization of function-local statics is thread-safe.
+  static Pointer instance = Self::New();
+  return instance;
+}
+
+template< typename TImageType >
+typename FrequencyResamplingSelector< TImageType >::MethodType
+FrequencyResamplingSelector< TImageType >
+::SelectShrinkMethod(const SizeType & inputSize, const FactorsType & factors, unsigned int numberOfWorkUnits)
+{
+  return this->SelectMethod(inputSize, factors, numberOfWorkUnits, false);
+}
+
+template< typename TImageType >
+typename FrequencyResamplingSelector< TImageType >::MethodType
+FrequencyResamplingSelector< TImageType >
+::SelectExpandMethod(const SizeType & inputSize, const FactorsType & factors, unsigned int numberOfWorkUnits)
+{
+  return this->SelectMethod(inputSize, factors, numberOfWorkUnits, true);
+}
+
+template< typename TImageType >
+typename FrequencyResamplingSelector< TImageType >::ResamplingFilterType::Pointer
+FrequencyResamplingSelector< TImageType >
+::MakeShrinkFilter(MethodType method, const FactorsType & factors)
+{
+  if ( method == MethodType::Frequency )
+    {
+    auto shrinkFilter = FrequencyShrinkImageFilter< ImageType >::New();
+    shrinkFilter->SetShrinkFactors(factors);
+    return shrinkFilter.GetPointer();
+    }
+  auto shrinkFilter = FrequencyShrinkViaInverseFFTImageFilter< ImageType >::New();
+  shrinkFilter->SetShrinkFactors(factors);
+  return shrinkFilter.GetPointer();
+}
+
+template< typename TImageType >
+typename FrequencyResamplingSelector< TImageType >::ResamplingFilterType::Pointer
+FrequencyResamplingSelector< TImageType >
+::MakeExpandFilter(MethodType method, const FactorsType & factors)
+{
+  if ( method == MethodType::Frequency )
+    {
+    auto expandFilter = FrequencyExpandImageFilter< ImageType >::New();
+    expandFilter->SetExpandFactors(factors);
+    return expandFilter.GetPointer();
+    }
+  auto expandFilter = FrequencyExpandViaInverseFFTImageFilter< ImageType >::New();
+  expandFilter->SetExpandFactors(factors);
+  return expandFilter.GetPointer();
+}
+
+template< typename TImageType >
+typename FrequencyResamplingSelector< TImageType >::MethodType
+FrequencyResamplingSelector< TImageType >
+::SelectMethod(const SizeType & inputSize, const FactorsType & factors, unsigned int numberOfWorkUnits, bool expand)
+{
+  KeyType key;
+  key.Size.assign(inputSize.GetSize(), inputSize.GetSize() + ImageDimension);
+  key.Factors.assign(factors.Begin(), factors.End());
+  key.NumberOfWorkUnits = numberOfWorkUnits > 0 ?
+    numberOfWorkUnits : MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  key.Expand = expand;
+
+  unsigned int numberOfRuns;
+    {
+    std::lock_guard< std::mutex > lock(this->m_Mutex);
+    auto entryIt = this->m_Entries.find(key);
+    if ( entryIt != this->m_Entries.end() )
+      {
+      return entryIt->second;
+      }
+    numberOfRuns = this->m_NumberOfCalibrationRuns;
+    }
+
+  // Calibrate without the lock, concurrent requests of other sizes are not blocked.
+  MethodType method = MethodType::Frequency;
+  // The spatial decimation only matches the frequency fold if each size is a multiple of its factor.
+  bool equivalentMethods = true;
+  for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
+    {
+    if ( !expand && inputSize[dim] % factors[dim] != 0 )
+      {
+      equivalentMethods = false;
+      }
+    }
+  if ( equivalentMethods )
+    {
+    auto input = ImageType::New();
+    input->SetRegions(inputSize);
+    input->Allocate();
+    input->FillBuffer(NumericTraits< typename ImageType::PixelType >::OneValue());
+
+    typename ResamplingFilterType::Pointer frequencyFilter = expand ?
+      Self::MakeExpandFilter(MethodType::Frequency, factors) : Self::MakeShrinkFilter(MethodType::Frequency, factors);
+    typename ResamplingFilterType::Pointer viaInverseFFTFilter = expand ?
+      Self::MakeExpandFilter(MethodType::ViaInverseFFT, factors) :
+      Self::MakeShrinkFilter(MethodType::ViaInverseFFT, factors);
+    frequencyFilter->SetNumberOfWorkUnits(key.NumberOfWorkUnits);
+    viaInverseFFTFilter->SetNumberOfWorkUnits(key.NumberOfWorkUnits);
+    frequencyFilter->SetInput(input);
+    viaInverseFFTFilter->SetInput(input);
+    try
+      {
+      const double frequencyTime = this->TimeFilter(frequencyFilter, numberOfRuns);
+      const double viaInverseFFTTime = this->TimeFilter(viaInverseFFTFilter, numberOfRuns);
+      itkDebugMacro(<< "Calibration of size " << inputSize << ", factors " << factors
+                    << ( expand ? ", expand: " : ", shrink: " )
+                    << frequencyTime << " s in the frequency domain, "
+                    << viaInverseFFTTime << " s via inverse FFT.");
+      if ( viaInverseFFTTime < frequencyTime )
+        {
+        method = MethodType::ViaInverseFFT;
+        }
+      }
+    catch ( ExceptionObject & )
+      {
+      // The FFT does not support this size.
+      method = MethodType::Frequency;
+      }
+    }
+
+  std::lock_guard< std::mutex > lock(this->m_Mutex);
+  ++this->m_NumberOfCalibrations;
+  // Other thread may have stored it first, keep its choice.
+  return this->m_Entries.emplace(key, method).first->second;
+}
+
+template< typename TImageType >
+double
+FrequencyResamplingSelector< TImageType >
+::TimeFilter(ResamplingFilterType * filter, unsigned int numberOfRuns) const
+{
+  // The first run creates the FFT plans and allocates the output.
+  auto * input = const_cast< ImageType * >( filter->GetInput() );
+  filter->Update();
+  double fastestTime = std::numeric_limits< double >::max();
+  for ( unsigned int run = 0; run < numberOfRuns; ++run )
+    {
+    // Modify the input, not the filter: the mini-pipelines of the filters have to run again too.
+    input->Modified();
+    const auto start = std::chrono::steady_clock::now();
+    filter->Update();
+    const std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - start;
+    fastestTime = std::min(fastestTime, elapsed.count());
+    }
+  return fastestTime;
+}
+
+template< typename TImageType >
+void
+FrequencyResamplingSelector< TImageType >
+::SetNumberOfCalibrationRuns(unsigned int numberOfCalibrationRuns)
+{
+  std::lock_guard< std::mutex > lock(this->m_Mutex);
+  this->m_NumberOfCalibrationRuns = std::max(numberOfCalibrationRuns, 1u);
+}
+
+template< typename TImageType >
+unsigned int
+FrequencyResamplingSelector< TImageType >
+::GetNumberOfCalibrationRuns() const
+{
+  std::lock_guard< std::mutex > lock(this->m_Mutex);
+  return this->m_NumberOfCalibrationRuns;
+}
+
+template< typename TImageType >
+SizeValueType
+FrequencyResamplingSelector< TImageType >
+::GetNumberOfCalibrations() const
+{
+  std::lock_guard< std::mutex > lock(this->m_Mutex);
+  return this->m_NumberOfCalibrations;
+}
+
+template< typename TImageType >
+SizeValueType
+FrequencyResamplingSelector< TImageType >
+::GetNumberOfEntries() const
+{
+  std::lock_guard< std::mutex > lock(this->m_Mutex);
+  return this->m_Entries.size();
+}
+
+template< typename TImageType >
+void
+FrequencyResamplingSelector< TImageType >
+::Clear()
+{
+  std::lock_guard< std::mutex > lock(this->m_Mutex);
+  this->m_Entries.clear();
+}
+
+template< typename TImageType >
+void
+FrequencyResamplingSelector< TImageType >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  std::lock_guard< std::mutex > lock(this->m_Mutex);
+  os << indent << "NumberOfCalibrationRuns: " << this->m_NumberOfCalibrationRuns << std::endl;
+  os << indent << "NumberOfCalibrations: " << this->m_NumberOfCalibrations << std::endl;
+  os << indent << "NumberOfEntries: " << this->m_Entries.size() << std::endl;
+}
+} // end namespace itk
+
+#endif
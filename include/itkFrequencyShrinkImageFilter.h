@@ -21,12 +21,13 @@
 #include <itkShrinkImageFilter.h>
 #include <itkFrequencyBandImageFilter.h>
 #include <itkEnableIf.h>
+#include <vector>
 
 namespace itk
 {
 /** \class FrequencyShrinkImageFilter
  * \brief Reduce the size of an image in the frequency domain by an integer
- * factor --fixed to 2 at the moment-- in each dimension.
+ * factor in each dimension.
  * This filter discard all the high frequency bins depending on the shrink factor
  * Example: N is even.
  * | 0        1   ... N/2-1   N/2             : N/2+1 ... N-1 |
@@ -68,6 +69,20 @@ namespace itk
  * The output image size in each dimension is given by:
  * outputSize[j] = std::floor(inputSize[j]/shrinkFactor[j]);
  *
+ * In general, the output is the average of shrinkFactor[j] regions of outputSize[j] bins per dimension,
+ * the aliases of each output bin: the regions start at m * outputSize[j], m < shrinkFactor[j] - 1,
+ * and the last one holds the negative frequencies, at inputSize[j] - outputSize[j].
+ * This is equivalent to decimating the image in the spatial domain when the sizes are divisible.
+ * A factor of 1 leaves the dimension untouched.
+ * Each output bin is computed in one multi-threaded pass gathering its aliases.
+ *
+ * With HalfHermitian on, input and output have the layout of RealToHalfHermitianForwardFFTImageFilter:
+ * only the non-negative frequencies of the x dimension are stored, the full size in x is
+ * 2*(inputSize[0] - 1) + 1 if ActualXDimensionIsOdd, 2*(inputSize[0] - 1) otherwise.
+ * The output is equal to the non-negative x half of the output of the full spectrum,
+ * the missing bins of the input are obtained from the hermitian symmetry.
+ * Use GetOutputActualXDimensionIsOdd to continue the pipeline.
+ *
  * This code was contributed in the Insight Journal paper:
  * https://hdl.handle.net....
  *
@@ -97,6 +112,7 @@ public:
   using ImagePointer = typename ImageType::Pointer;
   using ImageConstPointer = typename ImageType::ConstPointer;
   using IndexType = typename TImageType::IndexType;
+  using OffsetType = typename TImageType::OffsetType;
   using PixelType = typename TImageType::PixelType;
 
   /** Typedef to describe the output image region type. */
@@ -135,22 +151,57 @@ public:
   /** End concept checking */
 #endif
 
+  /** Flag to remove the frequencies above half the Nyquist frequency before folding,
+   * the band that a shrink factor of 2 would alias. Off by default.
+   * The band is defined by the parameters of FrequencyBandFilter, which is not run: its mask is applied
+   * to each aliased bin while folding. The frequency thresholds are relative to the sampling frequency,
+   * i.e. bin / size in [-0.5, 0.5], independently of the spacing. */
   itkGetConstReferenceMacro(ApplyBandFilter, bool);
   itkSetMacro(ApplyBandFilter, bool);
   itkBooleanMacro(ApplyBandFilter);
 
   itkGetMacro(FrequencyBandFilter, typename FrequencyBandFilterType::Pointer);
 
+  /** Flag for input and output with half-hermitian layout. Off by default.
+   * ApplyBandFilter is not supported with this layout. */
+  itkGetConstMacro(HalfHermitian, bool);
+  itkSetMacro(HalfHermitian, bool);
+  itkBooleanMacro(HalfHermitian);
+
+  /** Only used if HalfHermitian is On: the x size of the full spectrum of the input is odd. */
+  itkGetConstMacro(ActualXDimensionIsOdd, bool);
+  itkSetMacro(ActualXDimensionIsOdd, bool);
+  itkBooleanMacro(ActualXDimensionIsOdd);
+
+  /** The x size of the full spectrum of the output is odd. Computed in GenerateOutputInformation. */
+  itkGetConstMacro(OutputActualXDimensionIsOdd, bool);
+
 protected:
   FrequencyShrinkImageFilter();
   void PrintSelf(std::ostream & os, Indent indent) const override;
 
-  void GenerateData() override;
+  /** Compute the offsets of the aliases of the output bins. */
+  void BeforeThreadedGenerateData() override;
+
+  void DynamicThreadedGenerateData(const ImageRegionType & outputRegionForThread) override;
+
+  /** Direct computation of the output bins when HalfHermitian is On. */
+  void DynamicThreadedGenerateDataHalfHermitian(const ImageRegionType & outputRegionForThread);
+
+  /** True if the input bin at inputRelativeIndex (from the start of the input) passes the FrequencyBandFilter. */
+  bool IsInBand(const IndexType & inputRelativeIndex, const typename ImageType::SizeType & inputSize) const;
 
 private:
   ShrinkFactorsType                         m_ShrinkFactors;
   bool                                      m_ApplyBandFilter;
   typename FrequencyBandFilterType::Pointer m_FrequencyBandFilter;
+  bool                                      m_HalfHermitian;
+  bool                                      m_ActualXDimensionIsOdd;
+  bool                                      m_OutputActualXDimensionIsOdd;
+  /** Shift per dimension and offset in the input buffer of each alias of an output bin,
+   * in the order of \sa Ind2Sub. Computed in BeforeThreadedGenerateData. */
+  std::vector< OffsetType >                 m_AliasShifts;
+  std::vector< OffsetValueType >            m_AliasOffsets;
 };
 } // end namespace itk
 
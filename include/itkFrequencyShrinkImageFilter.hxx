@@ -19,22 +19,23 @@
 #define itkFrequencyShrinkImageFilter_hxx
 
 #include <itkFrequencyShrinkImageFilter.h>
-#include <itkProgressReporter.h>
-#include <numeric>
-#include <functional>
+#include <algorithm>
+#include <cmath>
 #include "itkInd2Sub.h"
-#include <itkPasteImageFilter.h>
-#include <itkAddImageFilter.h>
-#include <itkMultiplyImageFilter.h>
-// #include <itkGaussianSpatialFunction.h>
-// #include <itkFrequencyImageRegionIteratorWithIndex.h>
+#include <itkImageScanlineIterator.h>
+#include <itkImageRegionIteratorWithIndex.h>
+#include <itkNumericTraits.h>
+#include "itkWaveletUtilities.h"
 
 namespace itk
 {
 template< class TImageType >
 FrequencyShrinkImageFilter< TImageType >
 ::FrequencyShrinkImageFilter()
-  : m_ApplyBandFilter(false)
+  : m_ApplyBandFilter(false),
+  m_HalfHermitian(false),
+  m_ActualXDimensionIsOdd(false),
+  m_OutputActualXDimensionIsOdd(false)
 {
   for ( unsigned int j = 0; j < ImageDimension; j++ )
     {
@@ -51,6 +52,8 @@ FrequencyShrinkImageFilter< TImageType >
   this->m_FrequencyBandFilter->SetRadialBand(false);
   // Pass high positive freqs but stop negative high ones, to avoid overlaping.
   this->m_FrequencyBandFilter->SetPassNegativeHighFrequencyThreshold(false);
+
+  this->DynamicMultiThreadingOn();
 }
 
 template< class TImageType >
@@ -98,222 +101,245 @@ FrequencyShrinkImageFilter< TImageType >
 /**
  * Implementation Detail:
  * The implementation calculate the number of different regions in an image,
- * depending on the dimension:
- * numberOfRegions = 2^dim (positive and negative frequencies per dim)
+ * depending on the dimension and the shrink factors:
+ * numberOfRegions = prod(shrinkFactors) (2^dim with the default factors, positive and negative frequencies per dim)
  * then uses function to convert a linear array of regions [0, ..., numberOfRegions - 1]
- * to binary subindices (only two options: positive or negative region)
- * In 3D: numberOfRegions = Nr = 2^3 = 8
+ * to subindices, one per dimension in [0, shrinkFactor).
+ * In 3D with factor 2: numberOfRegions = Nr = 2^3 = 8
  * sizeOfSubindices = [2,2,2]
  * Region = 0       -----> Ind2Sub(   0, [2,2,2]) = [0,0,0]
  * Region = 1       -----> Ind2Sub(   1, [2,2,2]) = [1,0,0]
  * Region = Nr - 1  -----> Ind2Sub(Nr-1, [2,2,2]) = [1,1,1]
- * So, if the result of Ind2Sub is 0 we paste the positive frequencies, if 1, negative freq
+ * So, if the result of Ind2Sub is 0 the alias is in the positive frequencies, if shrinkFactor - 1,
+ * in the negative frequencies, and in the intermediate aliases otherwise.
+ * Each output bin is the average of the input bins at its index shifted to each region.
  */
 template< class TImageType >
 void
 FrequencyShrinkImageFilter< TImageType >
-::GenerateData()
+::BeforeThreadedGenerateData()
 {
-  // Get the input and output pointers
+  if ( this->m_HalfHermitian )
+    {
+    if ( this->m_ApplyBandFilter )
+      {
+      itkExceptionMacro(<< "ApplyBandFilter is not supported with HalfHermitian layout.");
+      }
+    return;
+    }
+
   const ImageType * inputPtr = this->GetInput();
+  const ImageType * outputPtr = this->GetOutput();
+  const typename TImageType::SizeType & inputSize = inputPtr->GetLargestPossibleRegion().GetSize();
+  const typename TImageType::SizeType & outputSize = outputPtr->GetLargestPossibleRegion().GetSize();
+  const OffsetValueType * inputOffsetTable = inputPtr->GetOffsetTable();
 
-  typename ImageType::Pointer outputPtr = this->GetOutput();
-  this->AllocateOutputs();
-  // outputPtr->SetBufferedRegion(outputPtr->GetLargestPossibleRegion());
-  outputPtr->FillBuffer(0);
+  FixedArray< unsigned int, ImageDimension > nsizes;
+  unsigned int numberOfRegions = 1;
+  for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
+    {
+    nsizes[dim]      = this->m_ShrinkFactors[dim];
+    numberOfRegions *= nsizes[dim];
+    }
 
-  // Output is the sum of the four(2D) or eight(3D) quadrants.
-  // We can do it only because high freqs are removed.
-  // This filter will remove it by default a BandPass Filter.
-  if ( this->m_ApplyBandFilter )
+  this->m_AliasShifts.assign(numberOfRegions, OffsetType());
+  this->m_AliasOffsets.assign(numberOfRegions, 0);
+  for ( unsigned int n = 0; n < numberOfRegions; ++n )
     {
-    typename ImageType::SpacingType inputSpacing = this->GetInput()->GetSpacing();
-    const typename ImageType::SpacingType::ValueType spacingValue = inputSpacing[0];
-    // Check that the spacing is the same in all directions.
+    const FixedArray< unsigned int, ImageDimension > subIndices = itk::Ind2Sub< ImageDimension >(n, nsizes);
+    for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
       {
-      bool all_equal = true;
-      for ( unsigned int i = 1; i < ImageDimension; ++i )
+      OffsetValueType shift;
+      if ( subIndices[dim] == 0 ) // positive frequencies
+        {
+        shift = 0;
+        }
+      else if ( subIndices[dim] == nsizes[dim] - 1 ) // negative frequencies
         {
-        if ( itk::Math::NotAlmostEquals(inputSpacing[i], spacingValue) )
+        shift = static_cast< OffsetValueType >( inputSize[dim] - outputSize[dim] );
+        }
+      else // intermediate aliases, only with shrink factors > 2
+        {
+        shift = static_cast< OffsetValueType >( subIndices[dim] * outputSize[dim] );
+        }
+      this->m_AliasShifts[n][dim] = shift;
+      this->m_AliasOffsets[n] += shift * inputOffsetTable[dim];
+      }
+    itkDebugMacro( << "n:" << n << " alias shift: " << this->m_AliasShifts[n]);
+    }
+}
+
+template< class TImageType >
+void
+FrequencyShrinkImageFilter< TImageType >
+::DynamicThreadedGenerateData(const ImageRegionType & outputRegionForThread)
+{
+  if ( this->m_HalfHermitian )
+    {
+    this->DynamicThreadedGenerateDataHalfHermitian(outputRegionForThread);
+    return;
+    }
+
+  const ImageType * inputPtr = this->GetInput();
+  ImageType * outputPtr = this->GetOutput();
+  const typename TImageType::SizeType & inputSize = inputPtr->GetLargestPossibleRegion().GetSize();
+  const IndexType & inputStart = inputPtr->GetLargestPossibleRegion().GetIndex();
+  const IndexType & outputStart = outputPtr->GetLargestPossibleRegion().GetIndex();
+
+  const auto numberOfRegions = static_cast< unsigned int >( this->m_AliasOffsets.size() );
+  using ValueType = typename NumericTraits< PixelType >::ValueType;
+  const auto scale = static_cast< ValueType >( 1.0 / numberOfRegions );
+  const PixelType * inputBuffer = inputPtr->GetBufferPointer();
+
+  ImageScanlineIterator< ImageType > outIt(outputPtr, outputRegionForThread);
+  while ( !outIt.IsAtEnd() )
+    {
+    // Index of the positive alias relative to the start of the input, the same than the output bin.
+    IndexType relativeIndex;
+    IndexType inputIndex;
+    const IndexType outputIndex = outIt.GetIndex();
+    for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
+      {
+      relativeIndex[dim] = outputIndex[dim] - outputStart[dim];
+      inputIndex[dim] = relativeIndex[dim] + inputStart[dim];
+      }
+    OffsetValueType inputOffset = inputPtr->ComputeOffset(inputIndex);
+    while ( !outIt.IsAtEndOfLine() )
+      {
+      PixelType sum = NumericTraits< PixelType >::ZeroValue();
+      for ( unsigned int n = 0; n < numberOfRegions; ++n )
+        {
+        if ( this->m_ApplyBandFilter && !this->IsInBand(relativeIndex + this->m_AliasShifts[n], inputSize) )
           {
-          all_equal = false;
+          continue;
           }
+        sum += inputBuffer[inputOffset + this->m_AliasOffsets[n]];
         }
-      if ( !all_equal )
+      outIt.Set(sum * scale);
+      ++outIt;
+      ++inputOffset;
+      ++relativeIndex[0];
+      }
+    outIt.NextLine();
+    }
+}
+
+template< class TImageType >
+bool
+FrequencyShrinkImageFilter< TImageType >
+::IsInBand(const IndexType & inputRelativeIndex, const typename ImageType::SizeType & inputSize) const
+{
+  using FrequencyValueType = typename FrequencyBandFilterType::FrequencyValueType;
+  const FrequencyBandFilterType * band = this->m_FrequencyBandFilter;
+  const FrequencyValueType lowThreshold = band->GetLowFrequencyThreshold();
+  const FrequencyValueType highThreshold = band->GetHighFrequencyThreshold();
+
+  // Frequency of the bin relative to the sampling frequency, as FrequencyFFTLayoutImageRegionIteratorWithIndex:
+  // bins above size/2 are negative.
+  FrequencyValueType frequency[ImageDimension];
+  FrequencyValueType moduleSquare = 0;
+  FrequencyValueType maxAbsFrequency = 0;
+  for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
+    {
+    const auto size = static_cast< IndexValueType >( inputSize[dim] );
+    const IndexValueType bin = ( inputRelativeIndex[dim] <= size / 2 ) ?
+      inputRelativeIndex[dim] : inputRelativeIndex[dim] - size;
+    frequency[dim] = static_cast< FrequencyValueType >( bin ) / static_cast< FrequencyValueType >( size );
+    moduleSquare += frequency[dim] * frequency[dim];
+    maxAbsFrequency = std::max(maxAbsFrequency, std::abs(frequency[dim]));
+    }
+  // Radial band, or cut-off box taking into account max absolute scalar frequency.
+  const FrequencyValueType f = band->GetRadialBand() ? std::sqrt(moduleSquare) : maxAbsFrequency;
+
+  const bool atLowThreshold = Math::FloatAlmostEqual(f, lowThreshold);
+  const bool atHighThreshold = Math::FloatAlmostEqual(f, highThreshold);
+  if ( ( !band->GetPassLowFrequencyThreshold() && atLowThreshold )
+       || ( !band->GetPassHighFrequencyThreshold() && atHighThreshold ) )
+    {
+    return false;
+    }
+  if ( band->GetPassBand() )
+    {
+    if ( f < lowThreshold || f > highThreshold )
+      {
+      return false;
+      }
+    }
+  else if ( f > lowThreshold && f < highThreshold ) // Stop band
+    {
+    return false;
+    }
+
+  // The box is not symmetric: the negative side of the thresholds can be stopped, to avoid overlapping aliases.
+  if ( !band->GetRadialBand() )
+    {
+    for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
+      {
+      if ( ( !band->GetPassNegativeLowFrequencyThreshold() && Math::FloatAlmostEqual(frequency[dim], -lowThreshold) )
+           || ( !band->GetPassNegativeHighFrequencyThreshold()
+                && Math::FloatAlmostEqual(frequency[dim], -highThreshold) ) )
         {
-        itkExceptionMacro(<< "Spacing of input image is not the same in all directions " << inputSpacing);
+        return false;
         }
       }
-
-    this->m_FrequencyBandFilter->SetInput(this->GetInput());
-    this->m_FrequencyBandFilter->SetFrequencyThresholds(
-      this->m_FrequencyBandFilter->GetLowFrequencyThreshold() * spacingValue,
-      this->m_FrequencyBandFilter->GetHighFrequencyThreshold() * spacingValue );
-    this->m_FrequencyBandFilter->Update();
-    inputPtr = this->m_FrequencyBandFilter->GetOutput();
     }
+  return true;
+}
+
+/**
+ * Half-hermitian layout: the negative x frequencies are not stored. Each output bin is the average
+ * of the prod(shrinkFactors) input bins of the full spectrum that are folded in DynamicThreadedGenerateData,
+ * fetching the conjugate of the symmetric bin when not stored.
+ */
+template< class TImageType >
+void
+FrequencyShrinkImageFilter< TImageType >
+::DynamicThreadedGenerateDataHalfHermitian(const ImageRegionType & outputRegionForThread)
+{
+  const ImageType * inputPtr = this->GetInput();
+  ImageType * outputPtr = this->GetOutput();
 
-  typename TImageType::SizeType inputSize  = inputPtr->GetLargestPossibleRegion().GetSize();
+  // Sizes of the full spectrum.
+  typename TImageType::SizeType inputSize = inputPtr->GetLargestPossibleRegion().GetSize();
   typename TImageType::SizeType outputSize = outputPtr->GetLargestPossibleRegion().GetSize();
+  inputSize[0] = 2 * ( inputSize[0] - 1 ) + ( this->m_ActualXDimensionIsOdd ? 1 : 0 );
+  outputSize[0] = 2 * ( outputSize[0] - 1 ) + ( this->m_OutputActualXDimensionIsOdd ? 1 : 0 );
   const typename TImageType::IndexType indexOrigOut = outputPtr->GetLargestPossibleRegion().GetIndex();
-  // Manage ImageDimension array linearly:{{{
+
   FixedArray< unsigned int, ImageDimension > nsizes;
   unsigned int numberOfRegions = 1;
   for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
     {
-    nsizes[dim]      = 2;
+    nsizes[dim]      = this->m_ShrinkFactors[dim];
     numberOfRegions *= nsizes[dim];
     }
-  FixedArray< unsigned int, ImageDimension > subIndices;
-  /// }}}
-
-  // Prepare filter to paste the different regions into output.
-  using PasteFilterType = itk::PasteImageFilter< ImageType >;
-  typename PasteFilterType::Pointer pasteFilter = PasteFilterType::New();
-  pasteFilter->SetSourceImage(inputPtr);
-  pasteFilter->SetDestinationImage(outputPtr);
-  // pasteFilter->InPlaceOn();
-
-  using RegionType = typename ImageType::RegionType;
-  ProgressReporter progress(this, 0, numberOfRegions );
-  for ( unsigned int n = 0; n < numberOfRegions; ++n )
+  const auto scale = static_cast< typename PixelType::value_type >(1.0 / numberOfRegions);
+
+  ImageRegionIteratorWithIndex< ImageType > outIt(outputPtr, outputRegionForThread);
+  for ( outIt.GoToBegin(); !outIt.IsAtEnd(); ++outIt )
     {
-    subIndices = itk::Ind2Sub< ImageDimension >(n, nsizes);
-    RegionType zoneRegion;
-    typename ImageType::SizeType zoneSize;
-    typename TImageType::IndexType inputIndex  = indexOrigOut;
-    typename TImageType::IndexType outputIndex = indexOrigOut;
-    // Note that lowFreqsOfInput is inputSize/2 if outputSize is even, (outputSize - 1)/2 if odd.
-    for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
+    const IndexType outputIndex = outIt.GetIndex();
+    PixelType sum = NumericTraits< PixelType >::ZeroValue();
+    for ( unsigned int n = 0; n < numberOfRegions; ++n )
       {
-      zoneSize[dim]    = outputSize[dim];
-      outputIndex[dim] = indexOrigOut[dim];
-      if ( subIndices[dim] == 0 ) // positive frequencies
-        {
-        inputIndex[dim] = indexOrigOut[dim];
-        }
-      else // negative frequencies
+      const FixedArray< unsigned int, ImageDimension > subIndices = itk::Ind2Sub< ImageDimension >(n, nsizes);
+      IndexType fullIndex;
+      for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
         {
-        inputIndex[dim] = indexOrigOut[dim] + inputSize[dim]  - zoneSize[dim];
+        fullIndex[dim] = outputIndex[dim] - indexOrigOut[dim];
+        if ( subIndices[dim] == nsizes[dim] - 1 ) // negative frequencies
+          {
+          fullIndex[dim] += inputSize[dim] - outputSize[dim];
+          }
+        else // positive frequencies and intermediate aliases
+          {
+          fullIndex[dim] += subIndices[dim] * outputSize[dim];
+          }
         }
+      sum += itk::utils::GetHalfHermitianPixel(inputPtr, fullIndex, inputSize);
       }
-    zoneRegion.SetIndex(inputIndex);
-    zoneRegion.SetSize(zoneSize);
-    itkDebugMacro( << "n:" << n << " region: " << zoneRegion);
-
-    pasteFilter->SetSourceRegion(zoneRegion);
-    pasteFilter->SetDestinationIndex(outputIndex);
-    pasteFilter->Update();
-    // Sum the quadrants.
-    using AddFilterType = itk::AddImageFilter< TImageType, TImageType >;
-    typename AddFilterType::Pointer addFilter = AddFilterType::New();
-    addFilter->SetInput1(outputPtr);
-    addFilter->SetInput2(pasteFilter->GetOutput());
-    addFilter->InPlaceOn();
-    if ( n == numberOfRegions - 1 ) // Graft the output.
-      {
-      addFilter->Update();
-      outputPtr = addFilter->GetOutput();
-      using MultiplyFilterType = itk::MultiplyImageFilter< TImageType, TImageType, TImageType >;
-      typename MultiplyFilterType::Pointer multiplyFilter = MultiplyFilterType::New();
-      multiplyFilter->SetInput(outputPtr);
-      multiplyFilter->SetConstant(static_cast< typename TImageType::PixelType::value_type >(1.0 / numberOfRegions));
-
-      multiplyFilter->GraftOutput(outputPtr);
-      multiplyFilter->Update();
-      this->GraftOutput(multiplyFilter->GetOutput());
-      // addFilter->GraftOutput(outputPtr);
-      // addFilter->Update();
-      // this->GraftOutput(addFilter->GetOutput());
-      }
-    else // update
-      {
-      addFilter->Update();
-      outputPtr = addFilter->GetOutput();
-      }
-    progress.CompletedPixel();
+    outIt.Set(sum * scale);
     }
-
-  /** Ensure image is hermitian in the Nyquist bands (even)
-   * Example: Image 2D size 8, index = [0,...,7]
-   * Each quadrant is a region pasted from the original image. The index refers to the input image of size 8. The input image is hermitian, so:
-   *   0
-   * 1 == 7
-   * 2 == 6  <- 6 is Nyq in new image.
-   * 3 == 5
-   *   4  <- Nyq original
-   * Hermitian table, using the equivalences above. (assuming imag part zero to avoid working with conjugates) . Note that index 6 is the new Nyquist.
-   *    0    1  |  6    7
-   * 0 0,0  1,0 | 2,0  1,0
-   * 1 0,1  1,1 | 2,1  1,1
-   * ---------------------
-   * 6 0,2  1,2 | 2,2  1,2
-   * 7 0,1  1,1 | 2,1  1,1
-   * /
-  */
-// Fix Nyquist band. Folding results for hermiticity.
-// {
-// typename TImageType::IndexType index = indexOrigOut + lowFreqsOfInput;
-// typename TImageType::IndexType modIndex = indexOrigOut + lowFreqsOfInput;
-// // typename TImageType::SizeType endSize = outputSize - lowFreqsOfInput;
-// for(unsigned int dim = 0; dim < ImageDimension; ++dim)
-//   {
-//   for(int i = 1; i < (int)lowFreqsOfInput[dim]; ++i)
-//     {
-//     index = indexOrigOut + lowFreqsOfInput;
-//     modIndex = indexOrigOut + lowFreqsOfInput;
-//     index.SetElement(dim, indexOrigOut[dim] + i );
-//     modIndex.SetElement(dim, indexOrigOut[dim] + outputSize[dim] - i );
-//     typename TImageType::PixelType value =
-//       std::conj(outputPtr->GetPixel(index));
-//     outputPtr->SetPixel(modIndex, value);
-//     // The stored nyquiist value corresponds to  the positive side.
-//     outputPtr->SetPixel(index, value);
-//     }
-//     // The stored nyquiist value corresponds to  the positive side.
-//     index.SetElement(dim, indexOrigOut[dim]);
-//     outputPtr->SetPixel(index, std::conj(outputPtr->GetPixel(index)));
-//   }
-// }
-
-  // // Apply a gaussian window of the size of the output.
-  // using FunctionType = itk::GaussianSpatialFunction<double, ImageDimension>;
-  // typename FunctionType::Pointer gaussian = FunctionType::New();
-  // using ArrayType = FixedArray< double, ImageDimension >;
-  // ArrayType m_Mean;
-  // ArrayType m_Sigma;
-  // double m_Scale = 1.0;
-  // bool m_Normalized = true;
-  // for (unsigned int i = 0; i<ImageDimension; ++i)
-  //   {
-  //   m_Mean[i] = indexOrigOut[i];
-  //   // 6.0 is equivalent to 3sigmas (border values are close to zero)
-  //   // m_Sigma[i] = outputSize[i]/(2*3.0);
-  //   m_Sigma[i] = outputSize[i]/(2.0*2.35);
-  //   }
-  // gaussian->SetSigma(m_Sigma);
-  // gaussian->SetMean(m_Mean);
-  // gaussian->SetScale(m_Scale);
-  // gaussian->SetNormalized(m_Normalized);
-  //
-  // // Create an iterator that will walk the output region
-  // using OutputIterator = itk::FrequencyImageRegionIteratorWithIndex< TImageType >;
-  // OutputIterator outIt = OutputIterator( outputPtr,
-  //     outputPtr->GetRequestedRegion() );
-  // outIt.GoToBegin();
-  // while( !outIt.IsAtEnd() )
-  //   {
-  //   typename TImageType::IndexType ind = outIt.GetFrequencyBin();
-  //   typename FunctionType::InputType f;
-  //   for (unsigned int i = 0; i<ImageDimension; ++i)
-  //     {
-  //     f[i] = static_cast<typename FunctionType::InputType::ValueType>(ind[i]);
-  //     }
-  //   const double value = gaussian->Evaluate(f);
-  //   // Set the pixel value to the function value
-  //   outIt.Set( outIt.Get() * static_cast<typename TImageType::PixelType::value_type>(value) );
-  //   ++outIt;
-  //   }
 }
 
 template< class TImageType >
@@ -385,6 +411,18 @@ FrequencyShrinkImageFilter< TImageType >
         static_cast< double >( inputSize[i] )
         / static_cast< double >(m_ShrinkFactors[i])
         );
+    if ( i == 0 && this->m_HalfHermitian )
+      {
+      // Shrink the full spectrum, store only its non-negative half.
+      const SizeValueType fullInputSize = 2 * ( inputSize[0] - 1 ) + ( this->m_ActualXDimensionIsOdd ? 1 : 0 );
+      const SizeValueType fullOutputSize = fullInputSize / m_ShrinkFactors[0];
+      this->m_OutputActualXDimensionIsOdd = ( fullOutputSize % 2 == 1 );
+      outputSize[0] = fullOutputSize / 2 + 1;
+      if ( fullOutputSize < 1 )
+        {
+        outputSize[0] = 0;
+        }
+      }
 
     if ( outputSize[i] < 1 )
       {
@@ -420,6 +458,9 @@ FrequencyShrinkImageFilter< TImageType >
     }
   os << std::endl;
   os << "ApplyBandFilter: " << this->m_ApplyBandFilter << std::endl;
+  os << indent << "HalfHermitian: " << this->m_HalfHermitian << std::endl;
+  os << indent << "ActualXDimensionIsOdd: " << this->m_ActualXDimensionIsOdd << std::endl;
+  os << indent << "OutputActualXDimensionIsOdd: " << this->m_OutputActualXDimensionIsOdd << std::endl;
 
   itkPrintSelfObjectMacro(FrequencyBandFilter);
 }
@@ -0,0 +1,117 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFrequencyShrinkMultiplyImageFilter_h
+#define itkFrequencyShrinkMultiplyImageFilter_h
+
+#include <itkImageToImageFilter.h>
+#include <itkFixedArray.h>
+
+namespace itk
+{
+/** \class FrequencyShrinkMultiplyImageFilter
+ * \brief Multiply a frequency image by a filter bank image and shrink the product in the frequency domain,
+ * in a single pass.
+ *
+ * Equivalent to FrequencyFilterBankMultiplyImageFilter followed by FrequencyShrinkImageFilter
+ * (without band filter): each output bin is the average of the products input * filterBank
+ * of the regions folded into it, 2^ImageDimension with the default factors of 2,
+ * \f$ O(k) = 2^{-d} \sum_{s \in \{0,1\}^d} I(k + s(N - M)) F(k + s(N - M)) \f$
+ * where N is the input size and M the output size.
+ * With a shrink factor f per dimension, the f regions start at m * M, m < f - 1, and N - M.
+ * No image of the size of the input is allocated.
+ *
+ * Used for the low-pass of each level in WaveletFrequencyForward.
+ * The filter bank (SetFilterBank) can have a real pixel type \sa Functor::FilterBankMultiply.
+ * Only its size has to match the input, its metadata is ignored.
+ * The output information is the same than in FrequencyShrinkImageFilter.
+ * The half-hermitian layout is not supported.
+ *
+ * \sa FrequencyShrinkImageFilter
+ * \sa FrequencyFilterBankMultiplyImageFilter
+ * \ingroup IsotropicWavelets
+ */
+template< typename TImageType, typename TFilterBankImage = TImageType >
+class FrequencyShrinkMultiplyImageFilter:
+  public ImageToImageFilter< TImageType, TImageType >
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(FrequencyShrinkMultiplyImageFilter);
+
+  /** Standard class type alias. */
+  using Self = FrequencyShrinkMultiplyImageFilter;
+  using Superclass = ImageToImageFilter< TImageType, TImageType >;
+  using Pointer = SmartPointer< Self >;
+  using ConstPointer = SmartPointer< const Self >;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(FrequencyShrinkMultiplyImageFilter, ImageToImageFilter);
+
+  /** Typedef to images */
+  using ImageType = TImageType;
+  using PixelType = typename ImageType::PixelType;
+  using IndexType = typename ImageType::IndexType;
+  using OutputImageRegionType = typename Superclass::OutputImageRegionType;
+  using FilterBankImageType = TFilterBankImage;
+
+  static constexpr unsigned int ImageDimension = TImageType::ImageDimension;
+
+  using ShrinkFactorsType = FixedArray< unsigned int, ImageDimension >;
+
+  /** Image of the filter bank multiplying the input. */
+  itkSetInputMacro(FilterBank, FilterBankImageType);
+  itkGetInputMacro(FilterBank, FilterBankImageType);
+
+  /** Set the shrink factors. Values are clamped to
+   * a minimum value of 1. Default is 2 for all dimensions. */
+  itkSetMacro(ShrinkFactors, ShrinkFactorsType);
+  void SetShrinkFactors(unsigned int factor);
+  itkGetConstReferenceMacro(ShrinkFactors, ShrinkFactorsType);
+
+#ifdef ITK_USE_CONCEPT_CHECKING
+  itkConceptMacro( ImageTypeHasNumericTraitsCheck,
+                   ( Concept::HasNumericTraits< PixelType > ) );
+#endif
+
+protected:
+  FrequencyShrinkMultiplyImageFilter();
+  ~FrequencyShrinkMultiplyImageFilter() override {}
+  void PrintSelf(std::ostream & os, Indent indent) const override;
+
+  void GenerateOutputInformation() override;
+
+  /** The whole input and filter bank are needed, independently of the output requested region. */
+  void GenerateInputRequestedRegion() override;
+
+  /** The filter bank only has to match the size of the input. */
+  void VerifyInputInformation() ITKv5_CONST override;
+
+  void DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+private:
+  ShrinkFactorsType m_ShrinkFactors;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkFrequencyShrinkMultiplyImageFilter.hxx"
+#endif
+
+#endif
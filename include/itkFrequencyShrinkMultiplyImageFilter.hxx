@@ -0,0 +1,215 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFrequencyShrinkMultiplyImageFilter_hxx
+#define itkFrequencyShrinkMultiplyImageFilter_hxx
+
+#include "itkFrequencyShrinkMultiplyImageFilter.h"
+#include "itkFrequencyFilterBankMultiplyImageFilter.h"
+#include "itkInd2Sub.h"
+#include <itkImageScanlineIterator.h>
+#include <itkNumericTraits.h>
+#include <vector>
+
+namespace itk
+{
+template< typename TImageType, typename TFilterBankImage >
+FrequencyShrinkMultiplyImageFilter< TImageType, TFilterBankImage >
+::FrequencyShrinkMultiplyImageFilter()
+{
+  this->m_ShrinkFactors.Fill(2);
+  this->AddRequiredInputName("FilterBank");
+
+  this->DynamicMultiThreadingOn();
+}
+
+template< typename TImageType, typename TFilterBankImage >
+void
+FrequencyShrinkMultiplyImageFilter< TImageType, TFilterBankImage >
+::SetShrinkFactors(unsigned int factor)
+{
+  const unsigned int clampedFactor = factor < 1 ? 1 : factor;
+  for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
+    {
+    if ( this->m_ShrinkFactors[dim] != clampedFactor )
+      {
+      this->m_ShrinkFactors.Fill(clampedFactor);
+      this->Modified();
+      return;
+      }
+    }
+}
+
+template< typename TImageType, typename TFilterBankImage >
+void
+FrequencyShrinkMultiplyImageFilter< TImageType, TFilterBankImage >
+::VerifyInputInformation() ITKv5_CONST
+{
+  const ImageType * input = this->GetInput();
+  const FilterBankImageType * filterBank = this->GetFilterBank();
+  if ( input && filterBank
+       && input->GetLargestPossibleRegion().GetSize() != filterBank->GetLargestPossibleRegion().GetSize() )
+    {
+    itkExceptionMacro(<< "The size of the filter bank: " << filterBank->GetLargestPossibleRegion().GetSize()
+                      << " is different than the size of the input: " << input->GetLargestPossibleRegion().GetSize());
+    }
+}
+
+template< typename TImageType, typename TFilterBankImage >
+void
+FrequencyShrinkMultiplyImageFilter< TImageType, TFilterBankImage >
+::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+
+  const ImageType * inputPtr = this->GetInput();
+  ImageType * outputPtr = this->GetOutput();
+  itkAssertInDebugAndIgnoreInReleaseMacro( inputPtr );
+  itkAssertInDebugAndIgnoreInReleaseMacro( outputPtr != nullptr );
+
+  // Same output information than FrequencyShrinkImageFilter.
+  const typename ImageType::SizeType & inputSize = inputPtr->GetLargestPossibleRegion().GetSize();
+  typename ImageType::SpacingType outputSpacing(inputPtr->GetSpacing());
+  typename ImageType::SizeType outputSize;
+  for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
+    {
+    outputSpacing[dim] = outputSpacing[dim] * this->m_ShrinkFactors[dim];
+    outputSize[dim] = Math::Floor< SizeValueType >(
+        static_cast< double >( inputSize[dim] ) / static_cast< double >( this->m_ShrinkFactors[dim] ));
+    if ( outputSize[dim] < 1 )
+      {
+      itkExceptionMacro("InputImage is too small! An output pixel does not map to a whole input bin.");
+      }
+    }
+  outputPtr->SetSpacing(outputSpacing);
+  outputPtr->SetOrigin(inputPtr->GetOrigin());
+
+  typename ImageType::RegionType outputLargestPossibleRegion;
+  outputLargestPossibleRegion.SetSize(outputSize);
+  outputLargestPossibleRegion.SetIndex(inputPtr->GetLargestPossibleRegion().GetIndex());
+  outputPtr->SetLargestPossibleRegion(outputLargestPossibleRegion);
+}
+
+template< typename TImageType, typename TFilterBankImage >
+void
+FrequencyShrinkMultiplyImageFilter< TImageType, TFilterBankImage >
+::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  auto * inputPtr = const_cast< ImageType * >( this->GetInput() );
+  auto * filterBankPtr = const_cast< FilterBankImageType * >( this->GetFilterBank() );
+  if ( inputPtr )
+    {
+    inputPtr->SetRequestedRegionToLargestPossibleRegion();
+    }
+  if ( filterBankPtr )
+    {
+    filterBankPtr->SetRequestedRegionToLargestPossibleRegion();
+    }
+}
+
+template< typename TImageType, typename TFilterBankImage >
+void
+FrequencyShrinkMultiplyImageFilter< TImageType, TFilterBankImage >
+::DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread)
+{
+  const ImageType * input = this->GetInput();
+  const FilterBankImageType * filterBank = this->GetFilterBank();
+  ImageType * output = this->GetOutput();
+
+  const typename ImageType::SizeType & inputSize = input->GetLargestPossibleRegion().GetSize();
+  const typename ImageType::SizeType & outputSize = output->GetLargestPossibleRegion().GetSize();
+  const IndexType & outputStart = output->GetLargestPossibleRegion().GetIndex();
+  const IndexType & inputStart = input->GetLargestPossibleRegion().GetIndex();
+  const typename FilterBankImageType::IndexType & filterBankStart = filterBank->GetLargestPossibleRegion().GetIndex();
+
+  // Offsets of each of the folded regions with respect to the positive frequencies,
+  // in the same order than the regions are added in FrequencyShrinkImageFilter (\sa Ind2Sub).
+  FixedArray< unsigned int, ImageDimension > nsizes;
+  unsigned int numberOfRegions = 1;
+  for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
+    {
+    nsizes[dim] = this->m_ShrinkFactors[dim];
+    numberOfRegions *= nsizes[dim];
+    }
+  std::vector< OffsetValueType > inputRegionOffsets(numberOfRegions, 0);
+  std::vector< OffsetValueType > filterBankRegionOffsets(numberOfRegions, 0);
+  const OffsetValueType * inputOffsetTable = input->GetOffsetTable();
+  const OffsetValueType * filterBankOffsetTable = filterBank->GetOffsetTable();
+  for ( unsigned int n = 0; n < numberOfRegions; ++n )
+    {
+    const FixedArray< unsigned int, ImageDimension > subIndices = Ind2Sub< ImageDimension >(n, nsizes);
+    for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
+      {
+      // The last region holds the negative frequencies, the intermediate aliases only exist with factors > 2.
+      const auto shift = ( subIndices[dim] == nsizes[dim] - 1 ) ?
+        static_cast< OffsetValueType >( inputSize[dim] - outputSize[dim] ) :
+        static_cast< OffsetValueType >( subIndices[dim] * outputSize[dim] );
+      inputRegionOffsets[n] += shift * inputOffsetTable[dim];
+      filterBankRegionOffsets[n] += shift * filterBankOffsetTable[dim];
+      }
+    }
+
+  using ValueType = typename NumericTraits< PixelType >::ValueType;
+  const auto scale = static_cast< ValueType >( 1.0 / numberOfRegions );
+  const Functor::FilterBankMultiply< PixelType, typename FilterBankImageType::PixelType > multiply;
+  const PixelType * inputBuffer = input->GetBufferPointer();
+  const typename FilterBankImageType::PixelType * filterBankBuffer = filterBank->GetBufferPointer();
+
+  ImageScanlineIterator< ImageType > outIt(output, outputRegionForThread);
+  while ( !outIt.IsAtEnd() )
+    {
+    const IndexType outputIndex = outIt.GetIndex();
+    IndexType inputIndex;
+    typename FilterBankImageType::IndexType filterBankIndex;
+    for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
+      {
+      inputIndex[dim] = outputIndex[dim] - outputStart[dim] + inputStart[dim];
+      filterBankIndex[dim] = outputIndex[dim] - outputStart[dim] + filterBankStart[dim];
+      }
+    OffsetValueType inputOffset = input->ComputeOffset(inputIndex);
+    OffsetValueType filterBankOffset = filterBank->ComputeOffset(filterBankIndex);
+    while ( !outIt.IsAtEndOfLine() )
+      {
+      PixelType sum = NumericTraits< PixelType >::ZeroValue();
+      for ( unsigned int n = 0; n < numberOfRegions; ++n )
+        {
+        sum += multiply(inputBuffer[inputOffset + inputRegionOffsets[n]],
+          filterBankBuffer[filterBankOffset + filterBankRegionOffsets[n]]);
+        }
+      outIt.Set(sum * scale);
+      ++outIt;
+      ++inputOffset;
+      ++filterBankOffset;
+      }
+    outIt.NextLine();
+    }
+}
+
+template< typename TImageType, typename TFilterBankImage >
+void
+FrequencyShrinkMultiplyImageFilter< TImageType, TFilterBankImage >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "ShrinkFactors: " << this->m_ShrinkFactors << std::endl;
+}
+} // end namespace itk
+
+#endif
@@ -76,6 +76,10 @@ public:
   itkSetMacro(PolynomialOrder, unsigned int);
   itkGetConstMacro(PolynomialOrder, unsigned int);
 
+  /** Parameters of the superclass followed by PolynomialOrder. */
+  using ParametersType = typename Superclass::ParametersType;
+  ParametersType GetWaveletParameters() const override;
+
   FunctionValueType ComputePolynom(const FunctionValueType & freq_norm_in_hz,
                                    const unsigned int & order) const;
 
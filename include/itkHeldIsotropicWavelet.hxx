@@ -47,6 +47,16 @@ HeldIsotropicWavelet< TFunctionValue, VImageDimension, TInput >
   os << indent << "PolynomialOrder: " << this->m_PolynomialOrder << std::endl;
 }
 
+template< typename TFunctionValue, unsigned int VImageDimension, typename TInput >
+typename HeldIsotropicWavelet< TFunctionValue, VImageDimension, TInput >::ParametersType
+HeldIsotropicWavelet< TFunctionValue, VImageDimension, TInput >
+::GetWaveletParameters() const
+{
+  ParametersType parameters = Superclass::GetWaveletParameters();
+  parameters.push_back(static_cast< double >(this->m_PolynomialOrder));
+  return parameters;
+}
+
 template< typename TFunctionValue, unsigned int VImageDimension, typename TInput >
 typename HeldIsotropicWavelet< TFunctionValue, VImageDimension, TInput >::FunctionValueType
 HeldIsotropicWavelet< TFunctionValue, VImageDimension, TInput >
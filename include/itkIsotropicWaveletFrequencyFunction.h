@@ -19,6 +19,7 @@
 #define itkIsotropicWaveletFrequencyFunction_h
 
 #include "itkIsotropicFrequencyFunction.h"
+#include <vector>
 
 namespace itk
 {
@@ -111,6 +112,14 @@ public:
    * Default to 0.25 Hz ( pi/2 rad/s ) but can be changed in child classes. */
   itkGetConstMacro(FreqCutOff, FunctionValueType);
   // itkSetMacro(FreqCutOff, FunctionValueType);
+
+  /** Values of the parameters that define the shape of the wavelet:
+   * FreqCutOff followed by the parameters of child classes.
+   * HighPassSubBands is not included, it is set by the filter bank generator.
+   * Two wavelets of the same class with equal parameters have the same response.
+   * \sa WaveletFilterBankCache */
+  using ParametersType = std::vector< double >;
+  virtual ParametersType GetWaveletParameters() const;
 protected:
   IsotropicWaveletFrequencyFunction();
   ~IsotropicWaveletFrequencyFunction() override;
@@ -60,6 +60,16 @@ IsotropicWaveletFrequencyFunction< TFunctionValue, VImageDimension, TInput >
   this->m_HighPassSubBands = high_pass_bands;
 }
 
+template< typename TFunctionValue, unsigned int VImageDimension, typename TInput >
+typename IsotropicWaveletFrequencyFunction< TFunctionValue, VImageDimension, TInput >::ParametersType
+IsotropicWaveletFrequencyFunction< TFunctionValue, VImageDimension, TInput >
+::GetWaveletParameters() const
+{
+  ParametersType parameters;
+  parameters.push_back(static_cast< double >(this->m_FreqCutOff));
+  return parameters;
+}
+
 template< typename TFunctionValue, unsigned int VImageDimension, typename TInput >
 typename IsotropicWaveletFrequencyFunction< TFunctionValue, VImageDimension, TInput >::FunctionValueType
 IsotropicWaveletFrequencyFunction< TFunctionValue, VImageDimension, TInput >
@@ -56,7 +56,7 @@ MonogenicSignalFrequencyImageFilter< TInputImage, TFrequencyImageRegionConstIter
   typename OutputImageType::PixelType out_value;
   for ( inFreqIt.GoToBegin(), outIt.GoToBegin(); !inFreqIt.IsAtEnd(); ++inFreqIt, ++outIt )
     {
-    evaluatedArray = this->m_Evaluator->EvaluateAllComponents(inFreqIt.GetFrequency());
+    this->m_Evaluator->EvaluateAllComponents(inFreqIt.GetFrequency(), evaluatedArray);
     out_value = outIt.Get();
     out_value[0] = inFreqIt.Get();
     for ( unsigned int dir = 0; dir < ImageDimension; ++dir )
@@ -32,6 +32,13 @@ namespace itk
  *
  * \f$ M := p(N,d) = \frac{(N+d-1)!}{(d-1)! N!} \f$
  *
+ * The frequency layout of the outputs is given by TFrequencyRegionIterator.
+ * Use FrequencyHalfHermitianFFTLayoutImageRegionIteratorWithIndex and ActualXDimensionIsOdd
+ * to match the output of RealToHalfHermitianForwardFFTImageFilter.
+ *
+ * All the components are generated in the same multi-threaded pass over the frequency grid.
+ * Each thread evaluates the components in a reused buffer, without heap allocations per pixel.
+ *
  * \sa RieszFrequencyFunction
  *
  * \ingroup IsotropicWavelets
@@ -107,6 +114,12 @@ public:
     }
   itkGetConstReferenceMacro(Order, unsigned int);
 
+  /** Flag for frequency iterators with half-hermitian layout: the size in the x dimension
+   * of the full spectrum is odd. Ignored by iterators of full layouts. Default: false */
+  itkSetMacro(ActualXDimensionIsOdd, bool);
+  itkGetConstMacro(ActualXDimensionIsOdd, bool);
+  itkBooleanMacro(ActualXDimensionIsOdd);
+
   /** Modifiable pointer to the Generalized RieszFunction */
   itkGetModifiableObjectMacro(Evaluator, RieszFunctionType);
 protected:
@@ -114,12 +127,15 @@ protected:
   ~RieszFrequencyFilterBankGenerator() override {}
   void PrintSelf(std::ostream & os, Indent indent) const override;
 
-  /** Generate data */
-  void GenerateData() override;
+  /** All the outputs share the metadata (size, spacing, ...) of the primary output. */
+  void GenerateOutputInformation() override;
+
+  void DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 
 private:
   unsigned int         m_Order;
   RieszFunctionPointer m_Evaluator;
+  bool                 m_ActualXDimensionIsOdd;
 }; // end of class
 } // end namespace itk
 #ifndef ITK_MANUAL_INSTANTIATION
@@ -19,16 +19,20 @@
 #define itkRieszFrequencyFilterBankGenerator_hxx
 #include "itkRieszFrequencyFilterBankGenerator.h"
 #include "itkNumericTraits.h"
+#include "itkWaveletUtilities.h"
 
 namespace itk
 {
 template< typename TOutputImage, typename TRieszFunction, typename TFrequencyRegionIterator >
 RieszFrequencyFilterBankGenerator< TOutputImage, TRieszFunction, TFrequencyRegionIterator >
 ::RieszFrequencyFilterBankGenerator()
-  : m_Order(0)
+  : m_Order(0),
+  m_ActualXDimensionIsOdd(false)
 {
   this->m_Evaluator = RieszFunctionType::New();
   this->SetOrder(1);
+
+  this->DynamicMultiThreadingOn();
 }
 
 template< typename TOutputImage, typename TRieszFunction, typename TFrequencyRegionIterator >
@@ -38,6 +42,7 @@ RieszFrequencyFilterBankGenerator< TOutputImage, TRieszFunction, TFrequencyRegio
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "m_Order: " << this->m_Order << std::endl;
+  os << indent << "ActualXDimensionIsOdd: " << (this->m_ActualXDimensionIsOdd ? "true" : "false") << std::endl;
   itkPrintSelfObjectMacro(Evaluator)
 }
 
@@ -59,39 +64,51 @@ RieszFrequencyFilterBankGenerator< TOutputImage, TRieszFunction, TFrequencyRegio
 template< typename TOutputImage, typename TRieszFunction, typename TFrequencyRegionIterator >
 void
 RieszFrequencyFilterBankGenerator< TOutputImage, TRieszFunction, TFrequencyRegionIterator >
-::GenerateData()
+::GenerateOutputInformation()
 {
-  /***************** Allocate Outputs *****************/
-  std::vector< OutputImagePointer > outputList;
-  std::vector< OutputRegionIterator > outputItList;
-  for ( unsigned int comp = 0; comp < this->GetNumberOfOutputs(); ++comp )
+  // GenerateImageSource only sets the information of the primary output.
+  Superclass::GenerateOutputInformation();
+
+  const OutputImageType * primaryOutput = this->GetOutput(0);
+  for ( unsigned int comp = 1; comp < this->GetNumberOfOutputs(); ++comp )
     {
-    outputList.push_back(this->GetOutput(comp));
-    OutputImagePointer& outputPtr = outputList.back();
-    // GenerateImageSource superclass allocates primary output, so use its region.
-    outputPtr->SetRegions(outputList[0]->GetLargestPossibleRegion());
-    outputPtr->Allocate();
-    outputPtr->FillBuffer(0);
-    outputItList.push_back(OutputRegionIterator(outputPtr, outputPtr->GetRequestedRegion()));
+    OutputImageType * outputPtr = this->GetOutput(comp);
+    if ( outputPtr )
+      {
+      outputPtr->CopyInformation(primaryOutput);
+      }
+    }
+}
+
+template< typename TOutputImage, typename TRieszFunction, typename TFrequencyRegionIterator >
+void
+RieszFrequencyFilterBankGenerator< TOutputImage, TRieszFunction, TFrequencyRegionIterator >
+::DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread)
+{
+  using OutputPixelType = typename OutputImageType::PixelType;
+  const unsigned int numberOfComponents = this->GetNumberOfOutputs();
+
+  // One iterator per component, all walking the same region.
+  std::vector< ImageRegionIterator< OutputImageType > > outputItList;
+  outputItList.reserve(numberOfComponents);
+  for ( unsigned int comp = 0; comp < numberOfComponents; ++comp )
+    {
+    outputItList.emplace_back(this->GetOutput(comp), outputRegionForThread);
     outputItList.back().GoToBegin();
     }
 
-  /***************** Set Outputs *****************/
-  OutputRegionIterator frequencyIt(outputList[0], outputList[0]->GetRequestedRegion());
+  // Buffer reused for every pixel of the region, evaluation is const and thread safe.
+  typename RieszFunctionType::OutputComponentsType evaluatedArray(numberOfComponents);
+  OutputRegionIterator frequencyIt(this->GetOutput(0), outputRegionForThread);
+  itk::utils::SetActualXDimensionIsOdd(frequencyIt, this->m_ActualXDimensionIsOdd);
   for ( frequencyIt.GoToBegin(); !frequencyIt.IsAtEnd(); ++frequencyIt )
     {
-    typename TRieszFunction::OutputComponentsType evaluatedArray =
-      this->m_Evaluator->EvaluateAllComponents(frequencyIt.GetFrequency());
-    for ( unsigned int comp = 0; comp < this->GetNumberOfOutputs(); ++comp )
+    this->m_Evaluator->EvaluateAllComponents(frequencyIt.GetFrequency(), evaluatedArray);
+    for ( unsigned int comp = 0; comp < numberOfComponents; ++comp )
       {
-      outputItList[comp].Set( static_cast< typename OutputImageType::PixelType >(evaluatedArray[comp]) );
+      outputItList[comp].Set( static_cast< OutputPixelType >(evaluatedArray[comp]) );
       ++outputItList[comp];
       }
-    itkDebugMacro(<< "w_vector: " << frequencyIt.GetFrequency()
-                  << " w2: " << frequencyIt.GetFrequencyModuloSquare()
-                  << "  frequencyItIndex: " << frequencyIt.GetIndex()
-// << "  Evaluated Riesz Components: " << evaluatedArray
-                  << " outputIndex: " << outputItList[0].GetIndex());
     }
 }
 } // end namespace itk
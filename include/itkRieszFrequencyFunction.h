@@ -143,6 +143,16 @@ public:
    */
   virtual OutputComponentsType EvaluateAllComponents(const TInput & frequency_point) const;
 
+  /**
+   * Evaluate all the components at the frequency point, writing them in \c out.
+   * \c out is only resized if its size is not the number of components, so reusing the same vector
+   * across evaluations avoids any heap allocation. Thread safe, it can be called from multiple threads.
+   *
+   * @param frequency_point point in the frequency space.
+   * @param out vector holding the values for all the components at the frequency point.
+   */
+  virtual void EvaluateAllComponents(const TInput & frequency_point, OutputComponentsType & out) const;
+
   /**
    * Compute normalizing factor given an index = (n1,n2,...,nVImageDimension)
    * Also takes into account this->m_Order = N
@@ -176,8 +186,10 @@ public:
     if ( this->m_Order != inputOrder )
       {
       this->m_Order = inputOrder;
-      // Calculate all the possible indices.
-      this->m_Indices = Self::ComputeAllPossibleIndices(this->m_Order);
+      // All the possible indices, generated once per order and already sorted.
+      const auto & indices = itk::utils::GetAllPossibleIndices< VImageDimension >(this->m_Order);
+      this->m_Indices = SetType(indices.begin(), indices.end());
+      this->ComputeComponentTables();
       this->Modified();
       }
     }
@@ -187,6 +199,10 @@ public:
    * Calculated when SetOrder */
   itkGetConstReferenceMacro(Indices, SetType);
 
+  /** Normalizing factor of each component, in the order of Indices.
+   * Calculated when SetOrder. \sa ComputeNormalizingFactor */
+  itkGetConstReferenceMacro(NormalizingFactors, OutputComponentsType);
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   itkConceptMacro( OutputTypeIsComplexCheck,
                    ( Concept::IsFloatingPoint< typename TFunctionValue::value_type > ) );
@@ -198,8 +214,15 @@ protected:
   void PrintSelf(std::ostream & os, Indent indent) const override;
 
 private:
+  /** Fill m_NormalizingFactors and m_IndicesTable from m_Indices. */
+  void ComputeComponentTables();
+
   unsigned int m_Order;
   SetType      m_Indices;
+  /** Normalizing factor per component: (-j)^N * sqrt(N!/(n1!*n2!...nd!)) */
+  OutputComponentsType m_NormalizingFactors;
+  /** Indices of all the components stored contiguously, VImageDimension values per component. */
+  std::vector< unsigned int > m_IndicesTable;
 };
 } // end namespace itk
 
@@ -112,46 +112,88 @@ RieszFrequencyFunction< TFunctionValue, VImageDimension, TInput >
   return powComplex * normalizeFactor;
 }
 
+template< typename TFunctionValue, unsigned int VImageDimension, typename TInput >
+void
+RieszFrequencyFunction< TFunctionValue, VImageDimension, TInput >
+::ComputeComponentTables()
+{
+  this->m_NormalizingFactors.clear();
+  this->m_IndicesTable.clear();
+  this->m_NormalizingFactors.reserve(this->m_Indices.size());
+  this->m_IndicesTable.reserve(this->m_Indices.size() * VImageDimension);
+  for(const auto & index : this->m_Indices)
+    {
+    this->m_NormalizingFactors.push_back(this->ComputeNormalizingFactor(index));
+    this->m_IndicesTable.insert(this->m_IndicesTable.end(), index.begin(), index.begin() + VImageDimension);
+    }
+}
+
 template< typename TFunctionValue, unsigned int VImageDimension, typename TInput >
 typename RieszFrequencyFunction< TFunctionValue, VImageDimension, TInput>::OutputComponentsType
 RieszFrequencyFunction< TFunctionValue, VImageDimension, TInput >
 ::EvaluateAllComponents( const TInput & frequency_point) const
 {
+  OutputComponentsType out;
+  this->EvaluateAllComponents(frequency_point, out);
+  return out;
+}
+
+template< typename TFunctionValue, unsigned int VImageDimension, typename TInput >
+void
+RieszFrequencyFunction< TFunctionValue, VImageDimension, TInput >
+::EvaluateAllComponents( const TInput & frequency_point, OutputComponentsType & out) const
+{
+  const size_t numberOfComponents = this->m_NormalizingFactors.size();
+  if ( out.size() != numberOfComponents )
+    {
+    out.resize(numberOfComponents);
+    }
+
   double magn(this->Magnitude(frequency_point));
 
   // Precondition:
   if(itk::Math::FloatAlmostEqual(magn, 0.0) )
     {
-    // return empty vector of length equal to NumberOfComponents.
-    return OutputComponentsType(RieszFrequencyFunction::ComputeNumberOfComponents(this->m_Order));
+    std::fill(out.begin(), out.end(), OutputComplexType(0));
+    return;
     }
 
-  const SetType &allIndices = this->m_Indices;
-
-  OutputComponentsType out;
-  for(auto index : allIndices)
+  // w1^n1...wd^nd / ||w||^m_Order = u1^n1...ud^nd, with u = w / ||w||, because n1 + ... + nd = m_Order.
+  // Table of powers u_d^k, k = 0..m_Order, shared by all the components.
+  // It lives on the stack for the usual orders, to avoid heap allocations per evaluation.
+  constexpr unsigned int MaxStackOrder = 15;
+  const unsigned int tableStride = this->m_Order + 1;
+  double stackPowerTable[VImageDimension * ( MaxStackOrder + 1 )];
+  std::vector< double > heapPowerTable;
+  double * powerTable = stackPowerTable;
+  if ( this->m_Order > MaxStackOrder )
     {
-    // freqProduct = w1^n1...wd^nd
-    double freqProduct(1);
-    for( unsigned int dim = 0; dim < VImageDimension; ++dim)
+    heapPowerTable.resize(VImageDimension * tableStride);
+    powerTable = heapPowerTable.data();
+    }
+  for( unsigned int dim = 0; dim < VImageDimension; ++dim)
+    {
+    const double u = static_cast<double>(frequency_point[dim]) / magn;
+    double * powers = powerTable + dim * tableStride;
+    powers[0] = 1.0;
+    for ( unsigned int k = 1; k < tableStride; ++k )
       {
-        if( index[dim] > 0 )
-          {
-          freqProduct *= std::pow(static_cast<double>(frequency_point[dim]), static_cast<double>(index[dim]));
-          }
-      // for (unsigned int n = 0; n<index[dim]; ++n)
-      //   {
-      //   freqProduct *= frequency_point[dim];
-      //   }
+      powers[k] = powers[k - 1] * u;
       }
-    // rieszComponent = (-j)^{m_Order} * sqrt(m_Order!/(n1!n2!...nd!)) * w1^n1...wd^nd / ||w||^m_Order
-    OutputComplexType outPerIndex = this->ComputeNormalizingFactor(index);
-    outPerIndex *= static_cast<typename OutputComplexType::value_type>(
-        freqProduct / std::pow(magn, static_cast<double>(this->m_Order)) );
-    out.push_back(outPerIndex);
     }
 
-  return out;
+  // rieszComponent = (-j)^{m_Order} * sqrt(m_Order!/(n1!n2!...nd!)) * w1^n1...wd^nd / ||w||^m_Order
+  const unsigned int * index = this->m_IndicesTable.data();
+  for ( size_t comp = 0; comp < numberOfComponents; ++comp, index += VImageDimension )
+    {
+    double monomial = powerTable[index[0]];
+    for( unsigned int dim = 1; dim < VImageDimension; ++dim)
+      {
+      monomial *= powerTable[dim * tableStride + index[dim]];
+      }
+    out[comp] = this->m_NormalizingFactors[comp]
+      * static_cast<typename OutputComplexType::value_type>(monomial);
+    }
 }
 
 template< typename TFunctionValue, unsigned int VImageDimension, typename TInput >
@@ -18,6 +18,7 @@
 #ifndef itkRieszRotationMatrix_h
 #define itkRieszRotationMatrix_h
 #include "itkVariableSizeMatrix.h"
+#include <memory>
 #include <vector>
 #include "itkMatrix.h"
 #include "itkRieszUtilities.h"
@@ -60,6 +61,9 @@ public:
   /** Matrix by std::vector<TImage> multiplication.
    * To perform the rotation with the output of
    * \ref RieszFrequencyFilterBankGenerator.
+   * Computed in a single multi-threaded pass: each pixel of the input images is read once,
+   * and the small matrix-vector product is written to all the output images.
+   * The images can be real or complex, and must have the same largest possible region.
    */
   template <typename TImage>
   std::vector< typename TImage::Pointer > MultiplyWithVectorOfImages(const std::vector< typename TImage::Pointer > & vect) const;
@@ -112,6 +116,24 @@ public:
    */
   IndicesMatrix GenerateIndicesMatrix();
 
+  /** Terms of the steerable matrix for a given order, independent of the rotation.
+   * Each term adds to S[i][j] (Entries: i * Components + j) the product
+   * Coefficients * prod_ab r_ab^Exponents_ab, where r_ab are the entries of the spatial rotation matrix.
+   * Exponents are stored with VImageDimension * VImageDimension values per term. */
+  struct SteerableMatrixTermTable
+    {
+    unsigned int                Order{ 0 };
+    unsigned int                Components{ 0 };
+    std::vector< unsigned int > Entries;
+    std::vector< long double >  Coefficients;
+    std::vector< unsigned int > Exponents;
+    };
+  using SteerableMatrixTermTableConstPointer = std::shared_ptr< const SteerableMatrixTermTable >;
+
+  /** Get the table of terms of the order, built the first time it is requested and
+   * shared by all the RieszRotationMatrix of the process with the same dimension. Thread safe. */
+  static SteerableMatrixTermTableConstPointer GetSteerableMatrixTermTable(const unsigned int & order);
+
   /** Default constructor. */
   RieszRotationMatrix();
   /** Copy constructor. */
@@ -209,6 +231,9 @@ public:
 #endif
 
 private:
+  /** Enumerate the combinations of multi-indices contributing to each entry of the steerable matrix. */
+  static SteerableMatrixTermTableConstPointer BuildSteerableMatrixTermTable(const unsigned int & order);
+
   SpatialRotationMatrixType m_SpatialRotationMatrix;
   unsigned int              m_Order;
   unsigned int              m_Components;
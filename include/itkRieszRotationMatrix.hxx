@@ -20,8 +20,11 @@
 
 #include "itkRieszRotationMatrix.h"
 #include "itkNumericTraits.h"
-#include "itkMultiplyImageFilter.h"
-#include "itkAddImageFilter.h"
+#include "itkMultiThreaderBase.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionConstIterator.h"
+#include <map>
+#include <mutex>
 
 namespace itk
 {
@@ -70,8 +73,8 @@ std::vector< typename TImage::Pointer >
 RieszRotationMatrix< T, VImageDimension >
 ::MultiplyWithVectorOfImages(const std::vector< typename TImage::Pointer > & vect) const
 {
-  unsigned int rows = this->Rows();
-  unsigned int cols = this->Cols();
+  const unsigned int rows = this->Rows();
+  const unsigned int cols = this->Cols();
 
   if ( vect.size() != cols )
     {
@@ -81,36 +84,85 @@ RieszRotationMatrix< T, VImageDimension >
 
   using ImageType = TImage;
   using ImagePointer = typename ImageType::Pointer;
+  using PixelType = typename ImageType::PixelType;
+  // Real type of the pixel components, T is converted to it to also allow complex images.
+  using PixelValueType = typename NumericTraits< PixelType >::ValueType;
+  using RegionType = typename ImageType::RegionType;
+
+  const RegionType region = vect[0]->GetLargestPossibleRegion();
+  for ( unsigned int c = 1; c < cols; c++ )
+    {
+    if ( vect[c]->GetLargestPossibleRegion() != region )
+      {
+      itkGenericExceptionMacro( << "Image " << c << " of the vector has region "
+                                << vect[c]->GetLargestPossibleRegion()
+                                << ", different than the region of the first image: " << region );
+      }
+    }
+
   std::vector< ImagePointer > result(rows);
   for ( unsigned int r = 0; r < rows; r++ )
     {
-    // Init result image to zero.
-    ImagePointer sum = ImageType::New();
-    sum->SetRegions(vect[r]->GetLargestPossibleRegion());
-    sum->Allocate();
-    sum->FillBuffer(NumericTraits< typename ImageType::PixelType >::ZeroValue());
+    result[r] = ImageType::New();
+    result[r]->CopyInformation(vect[0]);
+    result[r]->SetRegions(region);
+    result[r]->Allocate();
+    }
 
+  // Row-major copy of the matrix, read in the inner loop.
+  std::vector< PixelValueType > matrix(rows * cols);
+  for ( unsigned int r = 0; r < rows; r++ )
+    {
     for ( unsigned int c = 0; c < cols; c++ )
       {
-      // sum += this->m_Matrix(r, c) * vect[r];
-      using MultiplyImageFilterType = itk::MultiplyImageFilter<ImageType>;
-      typename MultiplyImageFilterType::Pointer multiplyImageFilter =
-        MultiplyImageFilterType::New();
-      multiplyImageFilter->SetInput(vect[c]);
-      multiplyImageFilter->SetConstant(this->GetVnlMatrix()(r, c));
-
-      using AddImageFilterType = itk::AddImageFilter<ImageType>;
-      typename AddImageFilterType::Pointer addImageFilter =
-        AddImageFilterType::New();
-      // Note that inPlace uses input1
-      addImageFilter->SetInput1(sum);
-      addImageFilter->SetInput2(multiplyImageFilter->GetOutput());
-      addImageFilter->InPlaceOn();
-      addImageFilter->Update();
-      sum = addImageFilter->GetOutput();
+      matrix[r * cols + c] = static_cast< PixelValueType >(this->GetVnlMatrix()(r, c));
       }
-    result[r] = sum;
     }
+
+  // Single pass over the images: each pixel of the input vector is read once,
+  // multiplied by the matrix, and written to every output.
+  MultiThreaderBase::Pointer multiThreader = MultiThreaderBase::New();
+  multiThreader->ParallelizeImageRegion< ImageType::ImageDimension >(
+    region,
+    [&vect, &result, &matrix, rows, cols](const RegionType & regionForThread)
+    {
+    std::vector< ImageRegionConstIterator< ImageType > > inputItList;
+    inputItList.reserve(cols);
+    for ( unsigned int c = 0; c < cols; c++ )
+      {
+      inputItList.emplace_back(vect[c], regionForThread);
+      }
+    std::vector< ImageRegionIterator< ImageType > > outputItList;
+    outputItList.reserve(rows);
+    for ( unsigned int r = 0; r < rows; r++ )
+      {
+      outputItList.emplace_back(result[r], regionForThread);
+      }
+
+    std::vector< PixelType > inputValues(cols);
+    const SizeValueType numberOfPixels = regionForThread.GetNumberOfPixels();
+    for ( SizeValueType pixel = 0; pixel < numberOfPixels; ++pixel )
+      {
+      for ( unsigned int c = 0; c < cols; c++ )
+        {
+        inputValues[c] = inputItList[c].Get();
+        ++inputItList[c];
+        }
+      const PixelValueType * matrixRow = matrix.data();
+      for ( unsigned int r = 0; r < rows; r++, matrixRow += cols )
+        {
+        PixelType sum = NumericTraits< PixelType >::ZeroValue();
+        for ( unsigned int c = 0; c < cols; c++ )
+          {
+          sum += inputValues[c] * matrixRow[c];
+          }
+        outputItList[r].Set(sum);
+        ++outputItList[r];
+        }
+      }
+    },
+    nullptr);
+
   return result;
 }
 
@@ -129,8 +181,7 @@ RieszRotationMatrix< T, VImageDimension >
     LocalIndicesArrayType(VImageDimension) // dimension of the indices.
     )));
 
-  using SetType = std::set< LocalIndicesArrayType, std::greater< LocalIndicesArrayType > >;
-  SetType allIndices = itk::utils::ComputeAllPossibleIndices< LocalIndicesArrayType, VImageDimension >(this->m_Order);
+  const LocalIndicesVector & allIndices = itk::utils::GetAllPossibleIndices< VImageDimension >(this->m_Order);
 
   // Populate LocalIndicesMatrix.
     {
@@ -152,56 +203,50 @@ RieszRotationMatrix< T, VImageDimension >
 }
 
 template< typename T, unsigned int VImageDimension >
-const typename RieszRotationMatrix< T, VImageDimension >::InternalMatrixType &
+typename RieszRotationMatrix< T, VImageDimension >::SteerableMatrixTermTableConstPointer
 RieszRotationMatrix< T, VImageDimension >
-::ComputeSteerableMatrix()
-  {
-  // precondition
-  if ( this->m_Order == 0 )
-    {
-    itkGenericExceptionMacro( << "RieszRotationMatrix has order zero, use SetOrder(n),"
-        " and SetSpatialRotationMatrix(R) before computing the steerable matrix" );
-    }
-  InternalMatrixType & S = this->GetVnlMatrix();
-  if ( this->m_Order == 1 )
-    {
-    S = this->GetSpatialRotationMatrix().GetVnlMatrix();
-    return this->GetVnlMatrix();
-    }
-
-  using SetType = std::set< IndicesArrayType, std::greater< IndicesArrayType > >;
-
-  // Create map between i,j matrix indices and n,m multiindex.
-  IndicesMatrix allIndicesPairs(this->GenerateIndicesMatrix());
+::GetSteerableMatrixTermTable(const unsigned int & order)
+{
+  // Tables only depend on order and dimension, share them between all the matrices of the process.
+  static std::mutex tablesMutex;
+  static std::map< unsigned int, SteerableMatrixTermTableConstPointer > tables;
 
-  std::vector< SetType > allIndicesOrder(this->m_Order + 1);
-  for ( unsigned int ord = 1; ord < this->m_Order + 1; ++ord )
+  std::lock_guard< std::mutex > lock(tablesMutex);
+  auto it = tables.find(order);
+  if ( it != tables.end() )
     {
-    allIndicesOrder[ord] = itk::utils::ComputeAllPossibleIndices< IndicesArrayType, VImageDimension >(ord);
+    return it->second;
     }
-  for ( unsigned int i = 0; i < this->m_Components; ++i )
+  SteerableMatrixTermTableConstPointer table = Self::BuildSteerableMatrixTermTable(order);
+  tables[order] = table;
+  return table;
+}
+
+template< typename T, unsigned int VImageDimension >
+typename RieszRotationMatrix< T, VImageDimension >::SteerableMatrixTermTableConstPointer
+RieszRotationMatrix< T, VImageDimension >
+::BuildSteerableMatrixTermTable(const unsigned int & order)
+{
+  auto table = std::make_shared< SteerableMatrixTermTable >();
+  table->Order = order;
+  const IndicesVector & allIndices = itk::utils::GetAllPossibleIndices< VImageDimension >(order);
+  table->Components = static_cast< unsigned int >( allIndices.size() );
+  for ( unsigned int i = 0; i < table->Components; ++i )
     {
-    for ( unsigned int j = 0; j < this->m_Components; ++j )
+    for ( unsigned int j = 0; j < table->Components; ++j )
       {
-      const IndicesArrayType & n = allIndicesPairs[i][j][0];
-      const IndicesArrayType & m = allIndicesPairs[i][j][1];
+      const IndicesArrayType & n = allIndices[i];
+      const IndicesArrayType & m = allIndices[j];
       // Set initial valid indices based on n and m.
-      std::vector< SetType > kValidInitialIndices(VImageDimension);
+      std::vector< IndicesVector > kValidInitialIndices(VImageDimension);
       for ( unsigned int dim = 0; dim < VImageDimension; ++dim )
         {
-        const unsigned int & kOrder = n[dim];
-        if ( kOrder == 0 )
-          {
-          kValidInitialIndices[dim].insert(IndicesArrayType(VImageDimension));
-          continue;
-          }
-        for ( auto itN = allIndicesOrder[kOrder].begin();
-              itN != allIndicesOrder[kOrder].end();
-              ++itN )
+        // Order zero has the single index (0,...,0).
+        for ( const auto & kIndex : itk::utils::GetAllPossibleIndices< VImageDimension >(n[dim]) )
           {
-          if ( itk::utils::LessOrEqualIndiceComparisson< IndicesArrayType, VImageDimension >(*itN, m) )
+          if ( itk::utils::LessOrEqualIndiceComparisson< IndicesArrayType, VImageDimension >(kIndex, m) )
             {
-            kValidInitialIndices[dim].insert(*itN);
+            kValidInitialIndices[dim].push_back(kIndex);
             }
           }
         }
@@ -216,9 +261,6 @@ RieszRotationMatrix< T, VImageDimension >
       ValidIndicesType kValidIndices;
       for (const auto & itValid0 : kValidInitialIndices[0])
         {
-        // IndicesVector tmp;
-        // tmp.push_back(*itValid0);
-        // kValidIndices.push_back( tmp );
         kValidIndices.push_back( IndicesVector(1, itValid0) );
         }
 
@@ -230,7 +272,6 @@ RieszRotationMatrix< T, VImageDimension >
           {
           for (const auto & itKIni : kValidInitialIndices[combineIndex + 1])
             {
-            // ---verbose sum---
             IndicesArrayType sumKIndices = itKIni;
             for (auto & kIndex : kValidIndex)
               {
@@ -239,7 +280,6 @@ RieszRotationMatrix< T, VImageDimension >
                 sumKIndices[dim] += kIndex[dim];
                 }
               }
-            // --- end verbose sum:---
             // if sum is valid: append index to tmpValidIndices.
             if ( itk::utils::LessOrEqualIndiceComparisson< IndicesArrayType, VImageDimension >(sumKIndices, m) )
               {
@@ -255,12 +295,8 @@ RieszRotationMatrix< T, VImageDimension >
       // kValidIndices at current i,j matrix positions
       // The vector kValidIndices holds a vector of valid sets of k vectors (k1,k2,k3),(k'1,k'2,k'3) ,...
       // where k_i is a multiindex: k1 = (k11, k12, ..., k1d)
-      //
-      // we calculate now r11^k11*...*r1d^k1d
-      // matrix R = [r1,...,rd], where r_i are columns of the rotation matrix.
-      // we sum and normalize them.
-      S[i][j] = 0;
-      long double result = 0;
+      // Each one is a term: n!/(k1!...kd!) * r11^k11*...*r1d^k1d * ... normalized by sqrt(m!/n!)
+      // where r_i are the rows of the rotation matrix.
       long nFactorial = 1;
       long mFactorial = 1;
       for ( unsigned int dim = 0; dim < VImageDimension; ++dim )
@@ -269,9 +305,9 @@ RieszRotationMatrix< T, VImageDimension >
         mFactorial *= itk::utils::Factorial(m[dim]);
         }
       auto nFactorialReal = static_cast< double >(nFactorial);
+      const long double normalizingFactor = sqrt( mFactorial / nFactorialReal);
       for (auto & kValidIndex : kValidIndices)
         {
-        long double rotationFactor = 1;
         long kFactorialMultiplication = 1;
         // There are always VImageDimension indices. (k1,k2,...,kd)
         for ( unsigned int kIndex = 0; kIndex < VImageDimension; ++kIndex )
@@ -279,33 +315,75 @@ RieszRotationMatrix< T, VImageDimension >
           for ( unsigned int dim = 0; dim < VImageDimension; ++dim )
             {
             const unsigned int & k = kValidIndex[kIndex][dim];
-            // k1! = k11!*k12!*...*k1d!
             kFactorialMultiplication *= itk::utils::Factorial(k);
-            // r11^k11*...*r1d^k1d
-            // switch to avoid unnecesary calls to std::pow.
-            if ( k == 0 )
-              {
-              continue;
-              }
-            else if ( k == 1 )
-              {
-              rotationFactor *=
-                this->m_SpatialRotationMatrix[kIndex][dim];
-              }
-            else
-              {
-              rotationFactor *= std::pow(
-                  this->m_SpatialRotationMatrix[kIndex][dim], static_cast< int >(k) );
-              }
+            table->Exponents.push_back(k);
             }
           }
-        result += nFactorialReal / kFactorialMultiplication
-          * rotationFactor;
+        table->Entries.push_back(i * table->Components + j);
+        table->Coefficients.push_back(nFactorialReal / kFactorialMultiplication * normalizingFactor);
+        }
+      } // end j
+    } // end i
+
+  return table;
+}
+
+template< typename T, unsigned int VImageDimension >
+const typename RieszRotationMatrix< T, VImageDimension >::InternalMatrixType &
+RieszRotationMatrix< T, VImageDimension >
+::ComputeSteerableMatrix()
+  {
+  // precondition
+  if ( this->m_Order == 0 )
+    {
+    itkGenericExceptionMacro( << "RieszRotationMatrix has order zero, use SetOrder(n),"
+        " and SetSpatialRotationMatrix(R) before computing the steerable matrix" );
+    }
+  InternalMatrixType & S = this->GetVnlMatrix();
+  if ( this->m_Order == 1 )
+    {
+    S = this->GetSpatialRotationMatrix().GetVnlMatrix();
+    return this->GetVnlMatrix();
+    }
+
+  const SteerableMatrixTermTableConstPointer table = Self::GetSteerableMatrixTermTable(this->m_Order);
+
+  // Powers of the entries of the rotation matrix: r_ab^p, p = 0..m_Order.
+  constexpr unsigned int RotationEntries = VImageDimension * VImageDimension;
+  const unsigned int powerStride = this->m_Order + 1;
+  std::vector< long double > powers(RotationEntries * powerStride);
+  for ( unsigned int a = 0; a < VImageDimension; ++a )
+    {
+    for ( unsigned int b = 0; b < VImageDimension; ++b )
+      {
+      long double * entryPowers = powers.data() + ( a * VImageDimension + b ) * powerStride;
+      entryPowers[0] = 1;
+      for ( unsigned int p = 1; p < powerStride; ++p )
+        {
+        entryPowers[p] = entryPowers[p - 1] * this->m_SpatialRotationMatrix[a][b];
         }
+      }
+    }
 
-      // normalize by sqrt(m!/n!):
-      result *= sqrt( mFactorial / nFactorialReal);
-      S[i][j] = static_cast< ValueType >(result);
+  // Flat loop over the terms: coefficient * prod_ab r_ab^k_ab
+  const unsigned int components = table->Components;
+  std::vector< long double > result(components * components, 0);
+  const unsigned int * exponents = table->Exponents.data();
+  for ( size_t term = 0; term < table->Entries.size(); ++term, exponents += RotationEntries )
+    {
+    long double rotationFactor = table->Coefficients[term];
+    for ( unsigned int entry = 0; entry < RotationEntries; ++entry )
+      {
+      rotationFactor *= powers[entry * powerStride + exponents[entry]];
+      }
+    result[table->Entries[term]] += rotationFactor;
+    }
+
+  for ( unsigned int i = 0; i < components; ++i )
+    {
+    for ( unsigned int j = 0; j < components; ++j )
+      {
+      S[i][j] = static_cast< ValueType >(result[i * components + j]);
       // Try to fix close to zero float errors
       if ( itk::Math::FloatAlmostEqual(S[i][j],
              static_cast< ValueType >(0),
@@ -314,72 +392,16 @@ RieszRotationMatrix< T, VImageDimension >
         {
         S[i][j] = 0;
         }
-
-      if ( this->GetDebug() )
-        {
-        std::cout << "\n" << std::endl;
-        std::cout << "i, j: " << i << ", " << j << std::endl;
-        std::cout << "n, m: ";
-        for ( unsigned int p = 0; p < 2; ++p )
-          {
-          std::cout << "( ";
-          for ( unsigned int dim = 0; dim < VImageDimension; ++dim )
-            {
-            std::cout << allIndicesPairs[i][j][p][dim] << ", ";
-            }
-          std::cout << ") , ";
-          }
-        std::cout << std::endl;
-
-        std::cout << "kValidIndices.size(): " << kValidIndices.size() << std::endl;
-        for (auto & kValidIndex : kValidIndices)
-          {
-          for (auto & v : kValidIndex)
-            {
-            std::cout << "( ";
-            for ( unsigned int dim = 0; dim < VImageDimension; ++dim )
-              {
-              std::cout << v[dim] << ", ";
-              }
-            std::cout << ") , ";
-            }
-          std::cout << "    ";
-          }
-
-        std::cout << "\n InitialValidIndices" << std::endl;
-        for ( unsigned int dim = 0; dim < VImageDimension; ++dim )
-          {
-          std::cout << "dim:" << dim << std::endl;
-          for (const auto & it : kValidInitialIndices[dim])
-            {
-            std::cout << "( ";
-            for ( unsigned int innerDim = 0; innerDim < VImageDimension; ++innerDim )
-              {
-              std::cout << it[innerDim] << ", ";
-              }
-            std::cout << ")";
-            }
-          std::cout << std::endl;
-          }
-        } // end Debug
-      } // end j
-    } // end i
+      }
+    }
 
   // ----- PRINT ---- //
   // Print allIndicesPairs
   if ( this->GetDebug() )
     {
-    // for(typename SetType::const_iterator it = allIndices.begin(); it != allIndices.end(); ++it)
-    //   {
-    //   std::cout <<"( ";
-    //   for (unsigned int i = 0; i<VImageDimension; ++i)
-    //     {
-    //     std::cout << (*it)[i] << ", ";
-    //     }
-    //   std::cout <<")";
-    //   }
-    //   std::cout << std::endl;;
+    IndicesMatrix allIndicesPairs(this->GenerateIndicesMatrix());
     std::cout << std::endl;
+    std::cout << "Number of terms: " << table->Entries.size() << std::endl;
     std::cout << "All Indices:" << std::endl;
     for ( unsigned int i = 0; i < this->m_Components; ++i )
       {
@@ -398,19 +420,6 @@ RieszRotationMatrix< T, VImageDimension >
         }
       std::cout << "\n";
       }
-    // for (unsigned int c = 0; c < kValidIndices.size(); ++c)
-    //   {
-    //   for (unsigned int v = 0; v < kValidIndices[c].size(); ++v)
-    //     {
-    //     std::cout <<"( ";
-    //     for (unsigned int dim = 0; dim<VImageDimension; ++dim)
-    //       {
-    //       std::cout << kValidIndices[c][v][dim] << ", ";
-    //       }
-    //     std::cout <<") , ";
-    //     }
-    //   std::cout <<"    ";
-    //   }
     } // end Debug
 
   return this->GetVnlMatrix(); // return S;
@@ -0,0 +1,149 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkRieszSteeringImageFilter_h
+#define itkRieszSteeringImageFilter_h
+
+#include <itkImageToImageFilter.h>
+#include <itkMatrix.h>
+#include <itkVector.h>
+#include <vector>
+
+namespace itk
+{
+/** \class RieszSteeringImageFilter
+ * \brief Steer the components of a generalized Riesz transform voxel by voxel.
+ *
+ * The inputs are the M components of a Riesz transform of order N,
+ * in the order of RieszFrequencyFunction::GetIndices (i.e. the outputs of RieszFrequencyFilterBankGenerator
+ * multiplied with an image, or of a wavelet band).
+ * The orientation image (SetOrientation) holds a direction \f$ u \f$ per voxel,
+ * for example the eigenvector with largest eigenvalue of the StructureTensor
+ * of the first order Riesz components.
+ *
+ * At each voxel the spatial rotation R with first row \f$ u \f$ is built in closed form
+ * (\sa ComputeRotationMatrixFromDirection), and the outputs are \f$ S_R \cdot I \f$,
+ * where \f$ S_R \f$ is the steerable matrix of RieszRotationMatrix for R.
+ * The first output is the response of the Riesz transform along \f$ u \f$.
+ *
+ * The steerable matrix is not computed with the combinatorial RieszRotationMatrix::ComputeSteerableMatrix.
+ * Row n of \f$ S_R \f$ holds the coefficients of the polynomial \f$ \prod_d (r_d \cdot x)^{n_d} \f$,
+ * where \f$ r_d \f$ are the rows of R, normalized by \f$ \sqrt{m!/n!} \f$.
+ * The polynomial is expanded with precomputed monomial tables, with no allocations per voxel.
+ *
+ * Voxels with a null orientation are copied without steering.
+ *
+ * \sa RieszRotationMatrix
+ * \sa StructureTensor
+ * \sa RieszFrequencyFilterBankGenerator
+ *
+ * \ingroup IsotropicWavelets
+ */
+template< typename TInputImage,
+  typename TOrientationImage = Image< Vector< double, TInputImage::ImageDimension >, TInputImage::ImageDimension > >
+class RieszSteeringImageFilter:
+  public ImageToImageFilter< TInputImage, TInputImage >
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(RieszSteeringImageFilter);
+
+  /** Standard class type alias. */
+  using Self = RieszSteeringImageFilter;
+  using Superclass = ImageToImageFilter< TInputImage, TInputImage >;
+  using Pointer = SmartPointer< Self >;
+  using ConstPointer = SmartPointer< const Self >;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(RieszSteeringImageFilter, ImageToImageFilter);
+
+  static constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
+
+  /** Inherit types from Superclass. */
+  using InputImageType = TInputImage;
+  using InputImagePointer = typename InputImageType::Pointer;
+  using OutputImageType = TInputImage;
+  using OutputImageRegionType = typename Superclass::OutputImageRegionType;
+  using InputsType = std::vector< InputImagePointer >;
+  using OutputsType = std::vector< InputImagePointer >;
+
+  using OrientationImageType = TOrientationImage;
+  using OrientationPixelType = typename OrientationImageType::PixelType;
+  using SpatialRotationMatrixType = Matrix< double, ImageDimension, ImageDimension >;
+
+  /** Set the M component images of the Riesz transform. */
+  void SetInputs(const InputsType & inputs);
+
+  /** Image with a direction per voxel, does not need to be normalized. */
+  itkSetInputMacro(Orientation, OrientationImageType);
+  itkGetInputMacro(Orientation, OrientationImageType);
+
+  /** Order of the generalized Riesz transform of the inputs. */
+  virtual void SetOrder(const unsigned int order);
+  itkGetConstMacro(Order, unsigned int);
+
+  /** Number of components M of the Riesz transform of the current order. */
+  itkGetConstMacro(NumberOfComponents, unsigned int);
+
+  /** Return the steered components. */
+  OutputsType GetOutputs();
+
+  /** Rotation matrix with \c direction (normalized) as the first row.
+   * Computed with a Householder reflection mapping the first axis to \c direction,
+   * with the sign of the last row changed to get a rotation (determinant 1).
+   * The identity is returned for directions close to the first axis or null. */
+  static SpatialRotationMatrixType ComputeRotationMatrixFromDirection(const OrientationPixelType & direction);
+
+protected:
+  RieszSteeringImageFilter();
+  ~RieszSteeringImageFilter() override {}
+  void PrintSelf(std::ostream & os, Indent indent) const override;
+
+  void BeforeThreadedGenerateData() override;
+
+  void DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+  /** Compute the MxM steerable matrix of the rotation, row-major.
+   * \c buffer1 and \c buffer2 are scratch vectors of size NumberOfComponents. */
+  void ComputeSteerableMatrix(const SpatialRotationMatrixType & rotation,
+    std::vector< double > & steerableMatrix,
+    std::vector< double > & buffer1,
+    std::vector< double > & buffer2) const;
+
+private:
+  unsigned int m_Order;
+  unsigned int m_NumberOfComponents;
+
+  /** Number of monomials of each degree 0..Order. */
+  std::vector< unsigned int > m_NumberOfMonomials;
+  /** For each degree k < Order, index in degree k+1 of the monomial idx times x_j,
+   * stored at [idx * ImageDimension + j]. */
+  std::vector< std::vector< unsigned int > > m_MultiplyByVariableTable;
+  /** Per component n, the Order rows of the rotation to multiply: n_0 times 0, n_1 times 1, ... */
+  std::vector< unsigned int > m_RowFactors;
+  /** sqrt(n1!...nd!) per component. */
+  std::vector< double > m_SqrtMultiFactorials;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkRieszSteeringImageFilter.hxx"
+#endif
+
+#endif
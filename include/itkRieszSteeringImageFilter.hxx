@@ -0,0 +1,342 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkRieszSteeringImageFilter_hxx
+#define itkRieszSteeringImageFilter_hxx
+
+#include "itkRieszSteeringImageFilter.h"
+#include "itkRieszUtilities.h"
+#include <itkImageRegionIterator.h>
+#include <itkImageRegionConstIterator.h>
+#include <itkNumericTraits.h>
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+namespace itk
+{
+template< typename TInputImage, typename TOrientationImage >
+RieszSteeringImageFilter< TInputImage, TOrientationImage >
+::RieszSteeringImageFilter()
+  : m_Order(0),
+  m_NumberOfComponents(0)
+{
+  this->AddRequiredInputName("Orientation");
+  this->SetOrder(1);
+
+  this->DynamicMultiThreadingOn();
+}
+
+template< typename TInputImage, typename TOrientationImage >
+void
+RieszSteeringImageFilter< TInputImage, TOrientationImage >
+::SetInputs(const InputsType & inputs)
+{
+  for ( unsigned int nin = 0; nin < inputs.size(); ++nin )
+    {
+    if ( this->GetInput(nin) != inputs[nin] )
+      {
+      this->SetNthInput(nin, inputs[nin]);
+      }
+    }
+}
+
+template< typename TInputImage, typename TOrientationImage >
+void
+RieszSteeringImageFilter< TInputImage, TOrientationImage >
+::SetOrder(const unsigned int order)
+{
+  if ( order < 1 )
+    {
+    itkExceptionMacro(<< "Error: order = " << order << ". It has to be greater than 0.");
+    }
+  if ( this->m_Order == order )
+    {
+    return;
+    }
+  this->m_Order = order;
+
+  // Monomials of each degree, components are the monomials of degree Order.
+  using IndicesArrayType = std::vector< unsigned int >;
+  std::vector< std::vector< IndicesArrayType > > monomials(order + 1);
+  monomials[0].assign(1, IndicesArrayType(ImageDimension, 0));
+  for ( unsigned int degree = 1; degree <= order; ++degree )
+    {
+    monomials[degree] = itk::utils::GetAllPossibleIndices< ImageDimension >(degree);
+    }
+
+  this->m_NumberOfMonomials.resize(order + 1);
+  for ( unsigned int degree = 0; degree <= order; ++degree )
+    {
+    this->m_NumberOfMonomials[degree] = static_cast< unsigned int >( monomials[degree].size() );
+    }
+
+  this->m_MultiplyByVariableTable.assign(order, std::vector< unsigned int >());
+  for ( unsigned int degree = 0; degree < order; ++degree )
+    {
+    std::map< IndicesArrayType, unsigned int > nextPositions;
+    for ( unsigned int idx = 0; idx < monomials[degree + 1].size(); ++idx )
+      {
+      nextPositions[monomials[degree + 1][idx]] = idx;
+      }
+    std::vector< unsigned int > & table = this->m_MultiplyByVariableTable[degree];
+    table.resize(monomials[degree].size() * ImageDimension);
+    for ( unsigned int idx = 0; idx < monomials[degree].size(); ++idx )
+      {
+      for ( unsigned int j = 0; j < ImageDimension; ++j )
+        {
+        IndicesArrayType next = monomials[degree][idx];
+        ++next[j];
+        table[idx * ImageDimension + j] = nextPositions[next];
+        }
+      }
+    }
+
+  const std::vector< IndicesArrayType > & components = monomials[order];
+  this->m_NumberOfComponents = static_cast< unsigned int >( components.size() );
+  this->m_RowFactors.clear();
+  this->m_RowFactors.reserve(this->m_NumberOfComponents * order);
+  this->m_SqrtMultiFactorials.resize(this->m_NumberOfComponents);
+  for ( unsigned int comp = 0; comp < this->m_NumberOfComponents; ++comp )
+    {
+    double multiFactorial = 1;
+    for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
+      {
+      this->m_RowFactors.insert(this->m_RowFactors.end(), components[comp][dim], dim);
+      multiFactorial *= static_cast< double >( itk::utils::Factorial(components[comp][dim]) );
+      }
+    this->m_SqrtMultiFactorials[comp] = std::sqrt(multiFactorial);
+    }
+
+  this->SetNumberOfRequiredOutputs(this->m_NumberOfComponents);
+  for ( unsigned int comp = 0; comp < this->m_NumberOfComponents; ++comp )
+    {
+    this->SetNthOutput(comp, this->MakeOutput(comp));
+    }
+  this->Modified();
+}
+
+template< typename TInputImage, typename TOrientationImage >
+typename RieszSteeringImageFilter< TInputImage, TOrientationImage >::OutputsType
+RieszSteeringImageFilter< TInputImage, TOrientationImage >
+::GetOutputs()
+{
+  OutputsType outputList;
+  for ( unsigned int comp = 0; comp < this->m_NumberOfComponents; ++comp )
+    {
+    outputList.push_back(this->GetOutput(comp));
+    }
+  return outputList;
+}
+
+template< typename TInputImage, typename TOrientationImage >
+typename RieszSteeringImageFilter< TInputImage, TOrientationImage >::SpatialRotationMatrixType
+RieszSteeringImageFilter< TInputImage, TOrientationImage >
+::ComputeRotationMatrixFromDirection(const OrientationPixelType & direction)
+{
+  SpatialRotationMatrixType rotation;
+  rotation.SetIdentity();
+
+  double normSquare = 0;
+  for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
+    {
+    normSquare += static_cast< double >( direction[dim] ) * static_cast< double >( direction[dim] );
+    }
+  if ( normSquare < NumericTraits< double >::epsilon() )
+    {
+    return rotation;
+    }
+  const double norm = std::sqrt(normSquare);
+
+  // Householder vector v = e0 - u, H = I - 2 v v^T / (v^T v) maps e0 to u, and H is symmetric: first row is u.
+  double v[ImageDimension];
+  double vNormSquare = 0;
+  for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
+    {
+    v[dim] = ( dim == 0 ? 1.0 : 0.0 ) - static_cast< double >( direction[dim] ) / norm;
+    vNormSquare += v[dim] * v[dim];
+    }
+  if ( vNormSquare < NumericTraits< double >::epsilon() )
+    {
+    return rotation;
+    }
+  for ( unsigned int r = 0; r < ImageDimension; ++r )
+    {
+    for ( unsigned int c = 0; c < ImageDimension; ++c )
+      {
+      rotation[r][c] -= 2.0 * v[r] * v[c] / vNormSquare;
+      }
+    }
+  // H is a reflection, change the sign of the last row to get a rotation.
+  if ( ImageDimension > 1 )
+    {
+    for ( unsigned int c = 0; c < ImageDimension; ++c )
+      {
+      rotation[ImageDimension - 1][c] = -rotation[ImageDimension - 1][c];
+      }
+    }
+  return rotation;
+}
+
+template< typename TInputImage, typename TOrientationImage >
+void
+RieszSteeringImageFilter< TInputImage, TOrientationImage >
+::ComputeSteerableMatrix(const SpatialRotationMatrixType & rotation,
+  std::vector< double > & steerableMatrix,
+  std::vector< double > & buffer1,
+  std::vector< double > & buffer2) const
+{
+  const unsigned int numberOfComponents = this->m_NumberOfComponents;
+  const unsigned int * rowFactors = this->m_RowFactors.data();
+  for ( unsigned int n = 0; n < numberOfComponents; ++n, rowFactors += this->m_Order )
+    {
+    // Expand prod_d (r_d . x)^{n_d}, one linear factor at a time.
+    buffer1[0] = 1.0;
+    for ( unsigned int degree = 0; degree < this->m_Order; ++degree )
+      {
+      const unsigned int row = rowFactors[degree];
+      const unsigned int * table = this->m_MultiplyByVariableTable[degree].data();
+      std::fill(buffer2.begin(), buffer2.begin() + this->m_NumberOfMonomials[degree + 1], 0.0);
+      for ( unsigned int idx = 0; idx < this->m_NumberOfMonomials[degree]; ++idx )
+        {
+        const double coefficient = buffer1[idx];
+        if ( coefficient == 0.0 )
+          {
+          continue;
+          }
+        for ( unsigned int j = 0; j < ImageDimension; ++j )
+          {
+          buffer2[table[idx * ImageDimension + j]] += coefficient * rotation[row][j];
+          }
+        }
+      std::swap(buffer1, buffer2);
+      }
+    // Normalize by sqrt(m!/n!)
+    double * steerableRow = steerableMatrix.data() + n * numberOfComponents;
+    const double inverseSqrtNFactorial = 1.0 / this->m_SqrtMultiFactorials[n];
+    for ( unsigned int m = 0; m < numberOfComponents; ++m )
+      {
+      steerableRow[m] = buffer1[m] * this->m_SqrtMultiFactorials[m] * inverseSqrtNFactorial;
+      }
+    }
+}
+
+template< typename TInputImage, typename TOrientationImage >
+void
+RieszSteeringImageFilter< TInputImage, TOrientationImage >
+::BeforeThreadedGenerateData()
+{
+  if ( this->GetNumberOfIndexedInputs() != this->m_NumberOfComponents )
+    {
+    itkExceptionMacro(<< "The Riesz transform of order " << this->m_Order << " has " << this->m_NumberOfComponents
+                      << " components, but the number of inputs is " << this->GetNumberOfIndexedInputs()
+                      << ". Use SetInputs.");
+    }
+}
+
+template< typename TInputImage, typename TOrientationImage >
+void
+RieszSteeringImageFilter< TInputImage, TOrientationImage >
+::DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread)
+{
+  using PixelType = typename InputImageType::PixelType;
+  using PixelValueType = typename NumericTraits< PixelType >::ValueType;
+  const unsigned int numberOfComponents = this->m_NumberOfComponents;
+
+  std::vector< ImageRegionConstIterator< InputImageType > > inputItList;
+  std::vector< ImageRegionIterator< OutputImageType > > outputItList;
+  inputItList.reserve(numberOfComponents);
+  outputItList.reserve(numberOfComponents);
+  for ( unsigned int comp = 0; comp < numberOfComponents; ++comp )
+    {
+    inputItList.emplace_back(this->GetInput(comp), outputRegionForThread);
+    outputItList.emplace_back(this->GetOutput(comp), outputRegionForThread);
+    }
+  ImageRegionConstIterator< OrientationImageType > orientationIt(this->GetOrientation(), outputRegionForThread);
+
+  // Scratch buffers of the thread, reused for every voxel.
+  std::vector< double > steerableMatrix(numberOfComponents * numberOfComponents);
+  std::vector< double > buffer1(numberOfComponents);
+  std::vector< double > buffer2(numberOfComponents);
+  std::vector< PixelType > inputValues(numberOfComponents);
+  // Neighbor voxels often share the orientation, reuse the steerable matrix.
+  OrientationPixelType previousDirection = orientationIt.Get();
+  bool steerableMatrixIsValid = false;
+  bool steer = true;
+
+  for ( orientationIt.GoToBegin(); !orientationIt.IsAtEnd(); ++orientationIt )
+    {
+    for ( unsigned int comp = 0; comp < numberOfComponents; ++comp )
+      {
+      inputValues[comp] = inputItList[comp].Get();
+      ++inputItList[comp];
+      }
+
+    const OrientationPixelType & direction = orientationIt.Get();
+    if ( !steerableMatrixIsValid || direction != previousDirection )
+      {
+      double normSquare = 0;
+      for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
+        {
+        normSquare += static_cast< double >( direction[dim] ) * static_cast< double >( direction[dim] );
+        }
+      steer = normSquare >= NumericTraits< double >::epsilon();
+      if ( steer )
+        {
+        this->ComputeSteerableMatrix(Self::ComputeRotationMatrixFromDirection(direction),
+          steerableMatrix, buffer1, buffer2);
+        }
+      previousDirection = direction;
+      steerableMatrixIsValid = true;
+      }
+
+    if ( !steer )
+      {
+      for ( unsigned int comp = 0; comp < numberOfComponents; ++comp )
+        {
+        outputItList[comp].Set(inputValues[comp]);
+        ++outputItList[comp];
+        }
+      continue;
+      }
+
+    const double * steerableRow = steerableMatrix.data();
+    for ( unsigned int n = 0; n < numberOfComponents; ++n, steerableRow += numberOfComponents )
+      {
+      PixelType sum = NumericTraits< PixelType >::ZeroValue();
+      for ( unsigned int m = 0; m < numberOfComponents; ++m )
+        {
+        sum += inputValues[m] * static_cast< PixelValueType >( steerableRow[m] );
+        }
+      outputItList[n].Set(sum);
+      ++outputItList[n];
+      }
+    }
+}
+
+template< typename TInputImage, typename TOrientationImage >
+void
+RieszSteeringImageFilter< TInputImage, TOrientationImage >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Order: " << this->m_Order << std::endl;
+  os << indent << "NumberOfComponents: " << this->m_NumberOfComponents << std::endl;
+}
+} // end namespace itk
+
+#endif
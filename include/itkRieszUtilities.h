@@ -19,10 +19,15 @@
 #define itkRieszUtilities_h
 
 #include <algorithm>
+#include <array>
 #include <functional>
+#include <map>
+#include <mutex>
 #include <set>
+#include <utility>
 #include <vector>
 
+#include "itkFixedArray.h"
 #include "itkMacro.h"
 
 #include "IsotropicWaveletsExport.h"
@@ -122,11 +127,124 @@ ComputeAllPermutations(
   return out;
 }
 
+/**
+ * Replace \c index by the next index of the same order in decreasing lexicographic order,
+ * the order of the sets of ComputeAllPossibleIndices.
+ * Example (order 2): (2,0,0) -> (1,1,0) -> (1,0,1) -> (0,2,0) -> (0,1,1) -> (0,0,2)
+ *
+ * @return false if \c index was the last one: (0,...,0,order).
+ */
+template< typename TIndicesArrayType, unsigned int VImageDimension >
+bool NextIndexSameOrder(TIndicesArrayType & index)
+{
+  // Last position before the last dimension with a non-zero value.
+  for ( int pos = static_cast< int >( VImageDimension ) - 2; pos >= 0; --pos )
+    {
+    if ( index[pos] > 0 )
+      {
+      --index[pos];
+      const unsigned int remainder = index[VImageDimension - 1] + 1;
+      index[VImageDimension - 1] = 0;
+      index[pos + 1] = remainder;
+      return true;
+      }
+    }
+  return false;
+}
+
+namespace detail
+{
+/** p(N,d) = p(N,d-1) + p(N-1,d), evaluated at compile time. */
+constexpr unsigned int NumberOfComponents(unsigned int order, unsigned int dimension)
+{
+  return ( order == 0 || dimension < 2 ) ? 1 :
+         NumberOfComponents(order, dimension - 1) + NumberOfComponents(order - 1, dimension);
+}
+
+template< typename TIndicesContainer, unsigned int VImageDimension >
+void FillAllPossibleIndices(const unsigned int & order, TIndicesContainer & indices)
+{
+  // Copy to get an index of the right size.
+  typename TIndicesContainer::value_type index = indices[0];
+  for ( unsigned int dim = 0; dim < VImageDimension; ++dim )
+    {
+    index[dim] = 0;
+    }
+  index[0] = order;
+  unsigned int position = 0;
+  do
+    {
+    indices[position++] = index;
+    }
+  while ( NextIndexSameOrder< typename TIndicesContainer::value_type, VImageDimension >(index) );
+}
+} // end namespace detail
+
+/** Types and number of components of the generalized Riesz transform of order VOrder,
+ * known at compile time. */
+template< unsigned int VOrder, unsigned int VImageDimension >
+struct RieszIndicesTraits
+{
+  static constexpr unsigned int NumberOfComponents = detail::NumberOfComponents(VOrder, VImageDimension);
+  using IndexType = FixedArray< unsigned int, VImageDimension >;
+  using IndicesType = std::array< IndexType, NumberOfComponents >;
+};
+
+template< unsigned int VOrder, unsigned int VImageDimension >
+constexpr unsigned int RieszIndicesTraits< VOrder, VImageDimension >::NumberOfComponents;
+
+/**
+ * Indices of all the components for a fixed order and dimension, with the same ordering as
+ * ComputeAllPossibleIndices. The std::array is sized at compile time and generated
+ * only once, without intermediate sets.
+ */
+template< unsigned int VOrder, unsigned int VImageDimension >
+const typename RieszIndicesTraits< VOrder, VImageDimension >::IndicesType &
+GetAllPossibleIndices()
+{
+  using IndicesType = typename RieszIndicesTraits< VOrder, VImageDimension >::IndicesType;
+  static const IndicesType indices = []() {
+    IndicesType out{};
+    detail::FillAllPossibleIndices< IndicesType, VImageDimension >(VOrder, out);
+    return out;
+  }();
+  return indices;
+}
+
+/**
+ * Indices of all the components for a run-time order, with the same ordering as
+ * ComputeAllPossibleIndices.
+ * Each order is generated once and cached for the whole process, the returned reference
+ * stays valid. Thread safe.
+ */
+template< unsigned int VImageDimension >
+const std::vector< std::vector< unsigned int > > &
+GetAllPossibleIndices(const unsigned int & order)
+{
+  using IndicesVector = std::vector< std::vector< unsigned int > >;
+  static std::mutex cacheMutex;
+  static std::map< unsigned int, IndicesVector > cache;
+
+  std::lock_guard< std::mutex > lock(cacheMutex);
+  auto it = cache.find(order);
+  if ( it == cache.end() )
+    {
+    IndicesVector indices(ComputeNumberOfComponents(order, VImageDimension),
+      std::vector< unsigned int >(VImageDimension));
+    detail::FillAllPossibleIndices< IndicesVector, VImageDimension >(order, indices);
+    it = cache.emplace(order, std::move(indices)).first;
+    }
+  return it->second;
+}
+
 /**
  * Compute all possible indices given an order.
  * The order imposes the constain:
  * \f[ \sum_{i}^{ImageDimension} \text{index}[i] = \text{order} \f]
  * where \f$ \text{index}[i]>=0 \f$
+ *
+ * The indices are generated in order, without the recursion and permutations of
+ * ComputeUniqueIndices and ComputeAllPermutations. \sa GetAllPossibleIndices
  */
 template< typename TIndicesArrayType, unsigned int VImageDimension >
 ITK_TEMPLATE_EXPORT
@@ -134,12 +252,14 @@ std::set< TIndicesArrayType, std::greater< TIndicesArrayType > >
 ComputeAllPossibleIndices(const unsigned int & order)
 {
   using SetType = std::set< TIndicesArrayType, std::greater< TIndicesArrayType > >;
-  SetType uniqueIndices;
-  TIndicesArrayType index(VImageDimension);
-  index[0] = order;
-  itk::utils::ComputeUniqueIndices< TIndicesArrayType, VImageDimension >(
-    index, uniqueIndices, 0);
-  return itk::utils::ComputeAllPermutations< TIndicesArrayType >(uniqueIndices);
+  const std::vector< std::vector< unsigned int > > & indices = GetAllPossibleIndices< VImageDimension >(order);
+  SetType out;
+  for ( const auto & index : indices )
+    {
+    // Indices are already sorted, insert at the end.
+    out.emplace_hint(out.end(), index.begin(), index.end());
+    }
+  return out;
 }
 
 template< typename TIndicesArrayType, unsigned int VImageDimension >
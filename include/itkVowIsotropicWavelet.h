@@ -82,6 +82,10 @@ public:
   itkSetMacro(Kappa, TFunctionValue);
   itkGetConstMacro(Kappa, TFunctionValue);
 
+  /** Parameters of the superclass followed by Kappa. */
+  using ParametersType = typename Superclass::ParametersType;
+  ParametersType GetWaveletParameters() const override;
+
 protected:
   VowIsotropicWavelet();
   ~VowIsotropicWavelet() override;
@@ -47,6 +47,16 @@ VowIsotropicWavelet< TFunctionValue, VImageDimension, TInput >
   os << indent << "Kappa: " << this->m_Kappa << std::endl;
 }
 
+template< typename TFunctionValue, unsigned int VImageDimension, typename TInput >
+typename VowIsotropicWavelet< TFunctionValue, VImageDimension, TInput >::ParametersType
+VowIsotropicWavelet< TFunctionValue, VImageDimension, TInput >
+::GetWaveletParameters() const
+{
+  ParametersType parameters = Superclass::GetWaveletParameters();
+  parameters.push_back(static_cast< double >(this->m_Kappa));
+  return parameters;
+}
+
 template< typename TFunctionValue, unsigned int VImageDimension, typename TInput >
 typename VowIsotropicWavelet< TFunctionValue, VImageDimension, TInput >::FunctionValueType
 VowIsotropicWavelet< TFunctionValue, VImageDimension, TInput >
@@ -0,0 +1,166 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWaveletFilterBankCache_h
+#define itkWaveletFilterBankCache_h
+
+#include <itkObject.h>
+#include <itkObjectFactory.h>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace itk
+{
+/** \class WaveletFilterBankCache
+ * \brief Thread-safe, size-bounded cache of wavelet filter banks.
+ *
+ * Stores the outputs of a \sa WaveletFrequencyFilterBankGenerator: [low-pass, high-pass bands...],
+ * indexed by the image size, the wavelet type and its parameters, the number of high pass sub-bands,
+ * the pyramid level, the level factor of the generator and the forward/inverse flag.
+ *
+ * The cache keeps the least recently used entries within MaximumNumberOfEntries and MaximumSizeInBytes.
+ * Use GetInstance() to access the process-wide cache, or New() for a private one.
+ *
+ * Insert stores, and Find returns, new images grafted on the buffers of the bank: the pipeline of each user
+ * only writes the regions of its own images, and releasing their data does not release the cached buffers.
+ * @note The pixel buffers are shared by all the users of the cache: they are read-only.
+ *
+ * \sa WaveletFrequencyForward
+ * \sa WaveletFrequencyInverse
+ * \ingroup IsotropicWavelets
+ */
+template< typename TImage >
+class WaveletFilterBankCache:
+  public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(WaveletFilterBankCache);
+
+  /** Standard type alias */
+  using Self = WaveletFilterBankCache;
+  using Superclass = Object;
+  using Pointer = SmartPointer< Self >;
+  using ConstPointer = SmartPointer< const Self >;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(WaveletFilterBankCache, Object);
+
+  using ImageType = TImage;
+  using ImagePointer = typename ImageType::Pointer;
+  using SizeType = typename ImageType::SizeType;
+  /** Bank: low-pass at index 0, followed by the high pass sub-bands. */
+  using BankType = std::vector< ImagePointer >;
+  using ParametersType = std::vector< double >;
+
+  /** Identifier of a bank.
+   * Level is the number of decimations applied to the generated bank,
+   * LevelFactor is the dilation applied by the generator (undecimated wavelets). */
+  struct KeyType
+  {
+    std::vector< SizeValueType > Size;
+    std::string                  WaveletName;
+    ParametersType               WaveletParameters;
+    unsigned int                 HighPassSubBands;
+    unsigned int                 Level;
+    double                       LevelFactor;
+    bool                         InverseBank;
+
+    bool operator<(const KeyType & other) const;
+  };
+
+  /** Process-wide instance. */
+  static Pointer GetInstance();
+
+  /** Build the key of the bank generated by waveletFilterBank with size, and decimated level times.
+   * TWaveletFilterBank is a \sa WaveletFrequencyFilterBankGenerator */
+  template< typename TWaveletFilterBank >
+  static KeyType MakeKey(TWaveletFilterBank * waveletFilterBank, const SizeType & size, unsigned int level);
+
+  /** Return true and set bank if the key is cached, with new images sharing the cached buffers.
+   * Updates the hit/miss counters. */
+  bool Find(const KeyType & key, BankType & bank);
+
+  /** Store images sharing the buffers of the bank, evicting the least recently used entries if needed.
+   * A bank bigger than MaximumSizeInBytes is not stored. */
+  void Insert(const KeyType & key, const BankType & bank);
+
+  /** Remove all the entries. */
+  void Clear();
+
+  /** Reset hit and miss counters. */
+  void ResetStatistics();
+
+  SizeValueType GetNumberOfHits() const;
+  SizeValueType GetNumberOfMisses() const;
+  SizeValueType GetNumberOfEvictions() const;
+  SizeValueType GetNumberOfEntries() const;
+  SizeValueType GetSizeInBytes() const;
+
+  /** Eviction policy: least recently used entries are removed first.
+   * Default to 64 entries and 1 GiB. */
+  void SetMaximumNumberOfEntries(SizeValueType maximumNumberOfEntries);
+  SizeValueType GetMaximumNumberOfEntries() const;
+  void SetMaximumSizeInBytes(SizeValueType maximumSizeInBytes);
+  SizeValueType GetMaximumSizeInBytes() const;
+
+protected:
+  WaveletFilterBankCache();
+  ~WaveletFilterBankCache() override {}
+  void PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  using KeyListType = std::list< KeyType >;
+  struct EntryType
+  {
+    BankType                        Bank;
+    SizeValueType                   SizeInBytes;
+    typename KeyListType::iterator  LeastRecentlyUsedPosition;
+  };
+  using EntriesType = std::map< KeyType, EntryType >;
+
+  /** Remove least recently used entries until the limits are met. Requires the lock. */
+  void EvictUnlocked();
+
+  static SizeValueType ComputeSizeInBytes(const BankType & bank);
+
+  /** New images grafted on the images of the bank: same buffers, information and regions. */
+  static BankType GraftBank(const BankType & bank);
+
+  mutable std::mutex m_Mutex;
+  EntriesType        m_Entries;
+  /** Most recently used at the front. */
+  KeyListType        m_LeastRecentlyUsed;
+  SizeValueType      m_SizeInBytes;
+  SizeValueType      m_MaximumNumberOfEntries;
+  SizeValueType      m_MaximumSizeInBytes;
+  SizeValueType      m_NumberOfHits;
+  SizeValueType      m_NumberOfMisses;
+  SizeValueType      m_NumberOfEvictions;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkWaveletFilterBankCache.hxx"
+#endif
+
+#endif
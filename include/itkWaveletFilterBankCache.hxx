@@ -0,0 +1,318 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWaveletFilterBankCache_hxx
+#define itkWaveletFilterBankCache_hxx
+
+#include "itkWaveletFilterBankCache.h"
+#include <tuple>
+
+namespace itk
+{
+template< typename TImage >
+bool
+WaveletFilterBankCache< TImage >::KeyType
+::operator<(const KeyType & other) const
+{
+  return std::tie(this->Size, this->WaveletName, this->WaveletParameters,
+    this->HighPassSubBands, this->Level, this->LevelFactor, this->InverseBank)
+         < std::tie(other.Size, other.WaveletName, other.WaveletParameters,
+    other.HighPassSubBands, other.Level, other.LevelFactor, other.InverseBank);
+}
+
+template< typename TImage >
+WaveletFilterBankCache< TImage >
+::WaveletFilterBankCache()
+  : m_SizeInBytes(0),
+  m_MaximumNumberOfEntries(64),
+  m_MaximumSizeInBytes(static_cast< SizeValueType >(1) << 30),
+  m_NumberOfHits(0),
+  m_NumberOfMisses(0),
+  m_NumberOfEvictions(0)
+{
+}
+
+template< typename TImage >
+typename WaveletFilterBankCache< TImage >::Pointer
+WaveletFilterBankCache< TImage >
+::GetInstance()
+{
+  // Initialization of function-local statics is thread-safe.
+  static Pointer instance = Self::New();
+  return instance;
+}
+
+template< typename TImage >
+template< typename TWaveletFilterBank >
+typename WaveletFilterBankCache< TImage >::KeyType
+WaveletFilterBankCache< TImage >
+::MakeKey(TWaveletFilterBank * waveletFilterBank, const SizeType & size, unsigned int level)
+{
+  KeyType key;
+  key.Size.assign(size.GetSize(), size.GetSize() + SizeType::Dimension);
+  auto waveletFunction = waveletFilterBank->GetModifiableWaveletFunction();
+  key.WaveletName = waveletFunction->GetNameOfClass();
+  key.WaveletParameters = waveletFunction->GetWaveletParameters();
+  // The radial lookup table changes the values of the bank.
+  key.WaveletParameters.push_back(waveletFilterBank->GetUseRadialLookupTable() ?
+    static_cast< double >(waveletFilterBank->GetRadialLookupTableSize()) : 0.0);
+  key.HighPassSubBands = waveletFilterBank->GetHighPassSubBands();
+  key.Level = level;
+  key.LevelFactor = waveletFilterBank->GetLevelFactor();
+  key.InverseBank = waveletFilterBank->GetInverseBank();
+  return key;
+}
+
+template< typename TImage >
+bool
+WaveletFilterBankCache< TImage >
+::Find(const KeyType & key, BankType & bank)
+{
+  std::lock_guard< std::mutex > lock(this->m_Mutex);
+  auto entryIt = this->m_Entries.find(key);
+  if ( entryIt == this->m_Entries.end() )
+    {
+    ++this->m_NumberOfMisses;
+    return false;
+    }
+  ++this->m_NumberOfHits;
+  // Move to the front of the least recently used list.
+  this->m_LeastRecentlyUsed.splice(this->m_LeastRecentlyUsed.begin(),
+    this->m_LeastRecentlyUsed, entryIt->second.LeastRecentlyUsedPosition);
+  bank = Self::GraftBank(entryIt->second.Bank);
+  return true;
+}
+
+template< typename TImage >
+void
+WaveletFilterBankCache< TImage >
+::Insert(const KeyType & key, const BankType & bank)
+{
+  const SizeValueType bankSizeInBytes = Self::ComputeSizeInBytes(bank);
+
+  std::lock_guard< std::mutex > lock(this->m_Mutex);
+  if ( bankSizeInBytes > this->m_MaximumSizeInBytes || this->m_MaximumNumberOfEntries == 0 )
+    {
+    return;
+    }
+
+  auto entryIt = this->m_Entries.find(key);
+  if ( entryIt != this->m_Entries.end() )
+    {
+    // Other thread stored it first, replace it.
+    this->m_SizeInBytes -= entryIt->second.SizeInBytes;
+    this->m_LeastRecentlyUsed.erase(entryIt->second.LeastRecentlyUsedPosition);
+    this->m_Entries.erase(entryIt);
+    }
+
+  this->m_LeastRecentlyUsed.push_front(key);
+  EntryType entry;
+  // The images of the caller are not shared, only their buffers.
+  entry.Bank = Self::GraftBank(bank);
+  entry.SizeInBytes = bankSizeInBytes;
+  entry.LeastRecentlyUsedPosition = this->m_LeastRecentlyUsed.begin();
+  this->m_Entries.emplace(key, entry);
+  this->m_SizeInBytes += bankSizeInBytes;
+
+  this->EvictUnlocked();
+}
+
+template< typename TImage >
+void
+WaveletFilterBankCache< TImage >
+::EvictUnlocked()
+{
+  while ( !this->m_LeastRecentlyUsed.empty()
+          && ( this->m_Entries.size() > this->m_MaximumNumberOfEntries
+               || this->m_SizeInBytes > this->m_MaximumSizeInBytes ) )
+    {
+    auto entryIt = this->m_Entries.find(this->m_LeastRecentlyUsed.back());
+    this->m_SizeInBytes -= entryIt->second.SizeInBytes;
+    this->m_Entries.erase(entryIt);
+    this->m_LeastRecentlyUsed.pop_back();
+    ++this->m_NumberOfEvictions;
+    }
+}
+
+template< typename TImage >
+void
+WaveletFilterBankCache< TImage >
+::Clear()
+{
+  std::lock_guard< std::mutex > lock(this->m_Mutex);
+  this->m_Entries.clear();
+  this->m_LeastRecentlyUsed.clear();
+  this->m_SizeInBytes = 0;
+}
+
+template< typename TImage >
+void
+WaveletFilterBankCache< TImage >
+::ResetStatistics()
+{
+  std::lock_guard< std::mutex > lock(this->m_Mutex);
+  this->m_NumberOfHits = 0;
+  this->m_NumberOfMisses = 0;
+  this->m_NumberOfEvictions = 0;
+}
+
+template< typename TImage >
+SizeValueType
+WaveletFilterBankCache< TImage >
+::GetNumberOfHits() const
+{
+  std::lock_guard< std::mutex > lock(this->m_Mutex);
+  return this->m_NumberOfHits;
+}
+
+template< typename TImage >
+SizeValueType
+WaveletFilterBankCache< TImage >
+::GetNumberOfMisses() const
+{
+  std::lock_guard< std::mutex > lock(this->m_Mutex);
+  return this->m_NumberOfMisses;
+}
+
+template< typename TImage >
+SizeValueType
+WaveletFilterBankCache< TImage >
+::GetNumberOfEvictions() const
+{
+  std::lock_guard< std::mutex > lock(this->m_Mutex);
+  return this->m_NumberOfEvictions;
+}
+
+template< typename TImage >
+SizeValueType
+WaveletFilterBankCache< TImage >
+::GetNumberOfEntries() const
+{
+  std::lock_guard< std::mutex > lock(this->m_Mutex);
+  return this->m_Entries.size();
+}
+
+template< typename TImage >
+SizeValueType
+WaveletFilterBankCache< TImage >
+::GetSizeInBytes() const
+{
+  std::lock_guard< std::mutex > lock(this->m_Mutex);
+  return this->m_SizeInBytes;
+}
+
+template< typename TImage >
+void
+WaveletFilterBankCache< TImage >
+::SetMaximumNumberOfEntries(SizeValueType maximumNumberOfEntries)
+{
+  {
+  std::lock_guard< std::mutex > lock(this->m_Mutex);
+  if ( this->m_MaximumNumberOfEntries == maximumNumberOfEntries )
+    {
+    return;
+    }
+  this->m_MaximumNumberOfEntries = maximumNumberOfEntries;
+  this->EvictUnlocked();
+  }
+  this->Modified();
+}
+
+template< typename TImage >
+SizeValueType
+WaveletFilterBankCache< TImage >
+::GetMaximumNumberOfEntries() const
+{
+  std::lock_guard< std::mutex > lock(this->m_Mutex);
+  return this->m_MaximumNumberOfEntries;
+}
+
+template< typename TImage >
+void
+WaveletFilterBankCache< TImage >
+::SetMaximumSizeInBytes(SizeValueType maximumSizeInBytes)
+{
+  {
+  std::lock_guard< std::mutex > lock(this->m_Mutex);
+  if ( this->m_MaximumSizeInBytes == maximumSizeInBytes )
+    {
+    return;
+    }
+  this->m_MaximumSizeInBytes = maximumSizeInBytes;
+  this->EvictUnlocked();
+  }
+  this->Modified();
+}
+
+template< typename TImage >
+SizeValueType
+WaveletFilterBankCache< TImage >
+::GetMaximumSizeInBytes() const
+{
+  std::lock_guard< std::mutex > lock(this->m_Mutex);
+  return this->m_MaximumSizeInBytes;
+}
+
+template< typename TImage >
+SizeValueType
+WaveletFilterBankCache< TImage >
+::ComputeSizeInBytes(const BankType & bank)
+{
+  SizeValueType sizeInBytes = 0;
+  for ( const auto & image : bank )
+    {
+    sizeInBytes += image->GetBufferedRegion().GetNumberOfPixels()
+      * sizeof( typename ImageType::PixelType );
+    }
+  return sizeInBytes;
+}
+
+template< typename TImage >
+typename WaveletFilterBankCache< TImage >::BankType
+WaveletFilterBankCache< TImage >
+::GraftBank(const BankType & bank)
+{
+  BankType graftedBank;
+  graftedBank.reserve(bank.size());
+  for ( const auto & image : bank )
+    {
+    ImagePointer graftedImage = ImageType::New();
+    graftedImage->Graft(image.GetPointer());
+    graftedBank.push_back(graftedImage);
+    }
+  return graftedBank;
+}
+
+template< typename TImage >
+void
+WaveletFilterBankCache< TImage >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  std::lock_guard< std::mutex > lock(this->m_Mutex);
+  os << indent << "NumberOfEntries: " << this->m_Entries.size() << std::endl;
+  os << indent << "SizeInBytes: " << this->m_SizeInBytes << std::endl;
+  os << indent << "MaximumNumberOfEntries: " << this->m_MaximumNumberOfEntries << std::endl;
+  os << indent << "MaximumSizeInBytes: " << this->m_MaximumSizeInBytes << std::endl;
+  os << indent << "NumberOfHits: " << this->m_NumberOfHits << std::endl;
+  os << indent << "NumberOfMisses: " << this->m_NumberOfMisses << std::endl;
+  os << indent << "NumberOfEvictions: " << this->m_NumberOfEvictions << std::endl;
+}
+} // end namespace itk
+
+#endif
@@ -20,6 +20,7 @@
 
 #include <itkImageRegionIterator.h>
 #include <complex>
+#include <vector>
 #include <itkGenerateImageSource.h>
 #include <itkFrequencyFFTLayoutImageRegionIteratorWithIndex.h>
 
@@ -38,6 +39,16 @@ namespace itk
  * using TWaveletFunction::EvaluateForwardSubBand, or EvaluateInverseSubBand,
  * where SubBand can be: LowPass, HighPass, or any HighPassSubBand.
  * Also accepts a template FrequencyIterator, to generate images with different frequency layouts.
+ * With FrequencyHalfHermitianFFTLayoutImageRegionIteratorWithIndex the bank matches the output of
+ * RealToHalfHermitianForwardFFTImageFilter, set ActualXDimensionIsOdd accordingly.
+ *
+ * The wavelet functions are real, so TOutputImage can have a real pixel type (float or double)
+ * to reduce the memory of the bank, or complex to match the type of the frequency images.
+ *
+ * All the sub-bands are generated in the same multi-threaded pass over the frequency grid,
+ * the frequency modulo is computed only once per pixel and shared by all the bands.
+ * With UseRadialLookupTable on, the wavelet function is evaluated only on a 1D radial
+ * grid and the bank is filled by interpolation.
  *
  * \sa WaveletFrequencyForward
  * \sa FrequencyFunction
@@ -97,6 +108,8 @@ public:
    * /sa WaveletFrequencyForwardUndecimated
    */
   itkGetMacro(Level, unsigned int);
+  /** ScaleFactor^Level, dilation applied to the frequency. */
+  itkGetConstMacro(LevelFactor, double);
   virtual void SetLevel(const unsigned int & level)
   {
     this->m_Level = level;
@@ -104,8 +117,32 @@ public:
     this->Modified();
   }
 
+  /** Flag to evaluate the radial profile of each band only once, on a regular grid
+   * of RadialLookupTableSize samples covering the frequency range of the output,
+   * and fill the bank with a linear interpolation of that table.
+   * Valid for isotropic (purely radial) wavelet functions. Off by default.
+   * @note The Shannon wavelet is discontinuous, pixels closer than one table sample
+   * to the discontinuity might differ from the exact evaluation. */
+  itkSetMacro(UseRadialLookupTable, bool);
+  itkGetConstMacro(UseRadialLookupTable, bool);
+  itkBooleanMacro(UseRadialLookupTable);
+
+  /** Number of samples of the radial lookup table, controls its accuracy.
+   * Only used when UseRadialLookupTable is on. Default: 4096 */
+  itkSetClampMacro(RadialLookupTableSize, unsigned int, 2, NumericTraits< unsigned int >::max());
+  itkGetConstMacro(RadialLookupTableSize, unsigned int);
+
+  /** Flag for frequency iterators with half-hermitian layout: the size in the x dimension
+   * of the full spectrum is odd. Ignored by iterators of full layouts. Default: false */
+  itkSetMacro(ActualXDimensionIsOdd, bool);
+  itkGetConstMacro(ActualXDimensionIsOdd, bool);
+  itkBooleanMacro(ActualXDimensionIsOdd);
+
   /** Get pointer to the instance of the wavelet function in order to access and change wavelet parameters */
   itkGetModifiableObjectMacro(WaveletFunction, WaveletFunctionType);
+  /** Share the wavelet function of other generator, i.e. to generate banks of different sizes concurrently.
+   * The evaluation is const, but the HighPassSubBands of the function are set before each generation. */
+  itkSetObjectMacro(WaveletFunction, WaveletFunctionType);
 
   /** Get Outputs *****/
   OutputImagePointer GetOutputLowPass();
@@ -121,9 +158,9 @@ public:
   OutputsType GetOutputsHighPassBands();
 
 #ifdef ITK_USE_CONCEPT_CHECKING
-  /// This ensure that OutputPixelType is complex<float||double>
-  itkConceptMacro( OutputPixelTypeIsComplexAndFloatCheck,
-                   ( Concept::IsFloatingPoint< typename OutputImageType::PixelType::value_type > ) );
+  /// This ensure that OutputPixelType is float, double, complex<float> or complex<double>
+  itkConceptMacro( OutputPixelTypeIsFloatCheck,
+                   ( Concept::IsFloatingPoint< typename NumericTraits< typename OutputImageType::PixelType >::ValueType > ) );
 #endif
 
 protected:
@@ -131,7 +168,12 @@ protected:
   ~WaveletFrequencyFilterBankGenerator() override {}
   void PrintSelf(std::ostream & os, Indent indent) const override;
 
-  void GenerateData() override;
+  /** All the outputs share the metadata (size, spacing, ...) of the primary output. */
+  void GenerateOutputInformation() override;
+
+  void BeforeThreadedGenerateData() override;
+
+  void DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 
 private:
   unsigned int           m_HighPassSubBands;
@@ -142,6 +184,12 @@ private:
   unsigned int           m_ScaleFactor;
   /** m_ScaleFactor^m_Level */
   double                 m_LevelFactor;
+  bool                   m_UseRadialLookupTable;
+  unsigned int           m_RadialLookupTableSize;
+  /** Radial profile per band, with one extra sample to interpolate at the upper end. */
+  std::vector< std::vector< FunctionValueType > > m_RadialLookupTable;
+  double                 m_RadialLookupTableInverseStep;
+  bool                   m_ActualXDimensionIsOdd;
 }; // end of class
 } // end namespace itk
 #ifndef ITK_MANUAL_INSTANTIATION
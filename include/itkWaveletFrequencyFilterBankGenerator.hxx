@@ -19,6 +19,7 @@
 #define itkWaveletFrequencyFilterBankGenerator_hxx
 #include "itkWaveletFrequencyFilterBankGenerator.h"
 #include "itkNumericTraits.h"
+#include "itkWaveletUtilities.h"
 
 namespace itk
 {
@@ -29,10 +30,16 @@ WaveletFrequencyFilterBankGenerator< TOutputImage, TWaveletFunction, TFrequencyR
   m_InverseBank(false),
   m_Level(0),
   m_ScaleFactor(2),
-  m_LevelFactor(1)
+  m_LevelFactor(1),
+  m_UseRadialLookupTable(false),
+  m_RadialLookupTableSize(4096),
+  m_RadialLookupTableInverseStep(0),
+  m_ActualXDimensionIsOdd(false)
 {
   this->SetHighPassSubBands(1);
   m_WaveletFunction = TWaveletFunction::New();
+
+  this->DynamicMultiThreadingOn();
 }
 
 template< typename TOutputImage, typename TWaveletFunction, typename TFrequencyRegionIterator >
@@ -65,6 +72,9 @@ WaveletFrequencyFilterBankGenerator< TOutputImage, TWaveletFunction, TFrequencyR
      << indent << "InverseBank: " << (this->m_InverseBank ? "true" : "false")
      << indent << "Level: " << this->m_Level
      << indent << "LevelFactor: " << this->m_LevelFactor
+     << indent << "UseRadialLookupTable: " << (this->m_UseRadialLookupTable ? "true" : "false")
+     << indent << "RadialLookupTableSize: " << this->m_RadialLookupTableSize
+     << indent << "ActualXDimensionIsOdd: " << (this->m_ActualXDimensionIsOdd ? "true" : "false")
      << std::endl;
 }
 
@@ -135,56 +145,135 @@ WaveletFrequencyFilterBankGenerator< TOutputImage, TWaveletFunction, TFrequencyR
 template< typename TOutputImage, typename TWaveletFunction, typename TFrequencyRegionIterator >
 void
 WaveletFrequencyFilterBankGenerator< TOutputImage, TWaveletFunction, TFrequencyRegionIterator >
-::GenerateData()
+::GenerateOutputInformation()
 {
+  // GenerateImageSource only sets the information of the primary output.
+  Superclass::GenerateOutputInformation();
+
+  const OutputImageType * primaryOutput = this->GetOutput(0);
+  for ( unsigned int band = 1; band < this->m_HighPassSubBands + 1; ++band )
+    {
+    OutputImageType * outputPtr = this->GetOutput(band);
+    if ( outputPtr )
+      {
+      outputPtr->CopyInformation(primaryOutput);
+      }
+    }
+}
+
+template< typename TOutputImage, typename TWaveletFunction, typename TFrequencyRegionIterator >
+void
+WaveletFrequencyFilterBankGenerator< TOutputImage, TWaveletFunction, TFrequencyRegionIterator >
+::BeforeThreadedGenerateData()
+{
+  // Modify the wavelet function before the threads start, evaluation is const.
   this->m_WaveletFunction->SetHighPassSubBands(this->m_HighPassSubBands);
 
-  /***************** Allocate Outputs *****************/
-  std::vector< OutputImagePointer > outputList;
-  std::vector< OutputRegionIterator > outputItList;
-  for ( unsigned int band = 0; band < this->m_HighPassSubBands + 1; ++band )
+  this->m_RadialLookupTable.clear();
+  if ( !this->m_UseRadialLookupTable )
+    {
+    return;
+    }
+
+  // Highest frequency modulo of the grid: corner of the Nyquist box, 0.5/spacing per axis.
+  const typename OutputImageType::SpacingType & spacing = this->GetOutput(0)->GetSpacing();
+  double maxFrequencyModuloSquare = 0;
+  for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
+    {
+    const double nyquist = 0.5 / spacing[dim];
+    maxFrequencyModuloSquare += nyquist * nyquist;
+    }
+  const double maxW = this->m_LevelFactor * std::sqrt(maxFrequencyModuloSquare);
+  const unsigned int samples = this->m_RadialLookupTableSize;
+  const double step = maxW / ( samples - 1 );
+  this->m_RadialLookupTableInverseStep = step > 0 ? 1.0 / step : 0.0;
+
+  const unsigned int numberOfBands = this->m_HighPassSubBands + 1;
+  this->m_RadialLookupTable.assign(numberOfBands, std::vector< FunctionValueType >(samples + 1));
+  for ( unsigned int l = 0; l < numberOfBands; ++l )
     {
-    outputList.push_back(this->GetOutput(band));
-    OutputImagePointer& outputPtr = outputList.back();
-    // TODO maybe you need a GenerateOutputInformation instead of setting here metadata.
-    // outputPtr->SetOrigin(this->GetOrigin());
-    // outputPtr->SetSpacing(this->GetSpacing());
-    // outputPtr->SetDirection(this->GetDirection());
-    // GenerateImageSource superclass allocates primary output, so use its region.
-    outputPtr->SetRegions(outputList[0]->GetLargestPossibleRegion());
-    outputPtr->Allocate();
-    outputPtr->FillBuffer(0);
-    outputItList.push_back(OutputRegionIterator(outputPtr, outputPtr->GetRequestedRegion()));
+    std::vector< FunctionValueType > & profile = this->m_RadialLookupTable[l];
+    for ( unsigned int s = 0; s < samples; ++s )
+      {
+      const auto w = static_cast< FunctionValueType >(s * step);
+      profile[s] = this->m_InverseBank ?
+        this->m_WaveletFunction->EvaluateInverseSubBand(w, l) :
+        this->m_WaveletFunction->EvaluateForwardSubBand(w, l);
+      }
+    profile[samples] = profile[samples - 1];
+    }
+}
+
+template< typename TOutputImage, typename TWaveletFunction, typename TFrequencyRegionIterator >
+void
+WaveletFrequencyFilterBankGenerator< TOutputImage, TWaveletFunction, TFrequencyRegionIterator >
+::DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread)
+{
+  using OutputPixelType = typename OutputImageType::PixelType;
+  // Component type of complex pixels, or the pixel type itself if real.
+  using OutputValueType = typename NumericTraits< OutputPixelType >::ValueType;
+  const unsigned int numberOfBands = this->m_HighPassSubBands + 1;
+
+  // One iterator per band, all walking the same region.
+  std::vector< ImageRegionIterator< OutputImageType > > outputItList;
+  outputItList.reserve(numberOfBands);
+  for ( unsigned int band = 0; band < numberOfBands; ++band )
+    {
+    outputItList.emplace_back(this->GetOutput(band), outputRegionForThread);
     outputItList.back().GoToBegin();
     }
 
-  /***************** Set Outputs *****************/
-  FunctionValueType w(0);
   // Iterator to calculate frequency modulo only once (optimization)
-  OutputRegionIterator frequencyIt(outputList[0], outputList[0]->GetRequestedRegion());
+  OutputRegionIterator frequencyIt(this->GetOutput(0), outputRegionForThread);
+  itk::utils::SetActualXDimensionIsOdd(frequencyIt, this->m_ActualXDimensionIsOdd);
+
+  if ( this->m_UseRadialLookupTable )
+    {
+    const size_t lastSample = this->m_RadialLookupTableSize - 1;
+    for ( frequencyIt.GoToBegin(); !frequencyIt.IsAtEnd(); ++frequencyIt )
+      {
+      const double position = this->m_LevelFactor * std::sqrt(frequencyIt.GetFrequencyModuloSquare())
+        * this->m_RadialLookupTableInverseStep;
+      size_t sample = static_cast< size_t >(position);
+      FunctionValueType fraction(0);
+      if ( sample < lastSample )
+        {
+        fraction = static_cast< FunctionValueType >(position - sample);
+        }
+      else
+        {
+        sample = lastSample;
+        }
+
+      for ( unsigned int l = 0; l < numberOfBands; ++l )
+        {
+        const std::vector< FunctionValueType > & profile = this->m_RadialLookupTable[l];
+        const FunctionValueType evaluatedSubBand =
+          profile[sample] + fraction * ( profile[sample + 1] - profile[sample] );
+        outputItList[l].Set( static_cast< OutputPixelType >( static_cast< OutputValueType >(evaluatedSubBand) ) );
+        ++outputItList[l];
+        }
+      }
+    return;
+    }
+
+  FunctionValueType w(0);
   for ( frequencyIt.GoToBegin(); !frequencyIt.IsAtEnd(); ++frequencyIt )
     {
     w = static_cast< FunctionValueType >(
-        sqrt(frequencyIt.GetFrequencyModuloSquare())
+        this->m_LevelFactor * sqrt(frequencyIt.GetFrequencyModuloSquare())
         );
 
-    FunctionValueType evaluatedSubBand;
     // l = 0 is low pass filter, l = m_HighPassSubBands is high-pass filter.
-    for ( unsigned int l = 0; l < m_HighPassSubBands + 1; ++l )
+    for ( unsigned int l = 0; l < numberOfBands; ++l )
       {
-      evaluatedSubBand = this->m_InverseBank ?
-        this->m_WaveletFunction->EvaluateInverseSubBand(this->m_LevelFactor * w, l) :
-        this->m_WaveletFunction->EvaluateForwardSubBand(this->m_LevelFactor * w, l);
+      const FunctionValueType evaluatedSubBand = this->m_InverseBank ?
+        this->m_WaveletFunction->EvaluateInverseSubBand(w, l) :
+        this->m_WaveletFunction->EvaluateForwardSubBand(w, l);
 
-      outputItList[l].Set( outputItList[l].Get()
-        + static_cast< typename OutputImageType::PixelType::value_type >(evaluatedSubBand));
+      outputItList[l].Set( static_cast< OutputPixelType >( static_cast< OutputValueType >(evaluatedSubBand) ) );
       ++outputItList[l];
       }
-    itkDebugMacro(<< "w_vector: " << frequencyIt.GetFrequency()
-                  << " w: " << w
-                  << "  frequencyItIndex: " << frequencyIt.GetIndex()
-                  << "  Evaluate highest subband: " << evaluatedSubBand
-                  << " outputIndex: " << outputItList[m_HighPassSubBands].GetIndex());
     }
 }
 } // end namespace itk
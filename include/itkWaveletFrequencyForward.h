@@ -22,10 +22,14 @@
 #include <itkImageRegionIterator.h>
 #include <itkImageConstIterator.h>
 #include <complex>
+#include <functional>
 #include <itkFixedArray.h>
 #include <itkImageToImageFilter.h>
+#include <itkWaveletFilterBankCache.h>
+#include <itkWaveletPyramid.h>
 #include <itkFrequencyShrinkImageFilter.h>
 #include <itkFrequencyShrinkViaInverseFFTImageFilter.h>
+#include <itkFrequencyResamplingSelector.h>
 
 namespace itk
 {
@@ -37,6 +41,18 @@ namespace itk
  * [0,..,HighPassBands): Wavelet coef of first level.
  * [HighPassBands,..,l*HighPassBands]: Wavelet coef of l level.
  *
+ * The input can be the full spectrum of a ForwardFFTImageFilter, or, with HalfHermitian On,
+ * the half spectrum of a RealToHalfHermitianForwardFFTImageFilter. The outputs then have the same
+ * half-hermitian layout, and the wavelet filter bank must use a half-hermitian frequency iterator,
+ * i.e. FrequencyHalfHermitianFFTLayoutImageRegionIteratorWithIndex.
+ *
+ * The low-pass band of each level is shrunk with TFrequencyShrinkFilterType, a filter with a
+ * SetShrinkFactors(FixedArray) method as FrequencyShrinkImageFilter (the default) or
+ * FrequencyShrinkViaInverseFFTImageFilter. With the default the multiplication by the low-pass filter
+ * and the shrink are done in one pass, \sa FrequencyShrinkMultiplyImageFilter.
+ * With AutoSelectShrinkFilter On, the fastest of both filters is chosen instead, \sa FrequencyResamplingSelector.
+ * The half-hermitian layout is always shrunk with FrequencyShrinkImageFilter.
+ *
  * @note The information/metadata of input image is ignored.
  * It can be restored after reconstruction @sa WaveletFrequencyInverse
  * with a @sa ChangeInformationFilter using the input image as a reference.
@@ -48,7 +64,6 @@ template< typename TInputImage,
  typename TWaveletFilterBank,
  typename TFrequencyShrinkFilterType =
    FrequencyShrinkImageFilter<TOutputImage> >
-   // FrequencyShrinkViaInverseFFTImageFilter<TOutputImage> >
 class WaveletFrequencyForward:
   public ImageToImageFilter< TInputImage, TOutputImage>
 {
@@ -79,8 +94,19 @@ public:
   using WaveletFilterBankPointer = typename WaveletFilterBankType::Pointer;
   using WaveletFunctionType = typename WaveletFilterBankType::WaveletFunctionType;
   using FunctionValueType = typename WaveletFilterBankType::FunctionValueType;
+  /** The images of the filter bank can have a real pixel type, cheaper than the complex output. */
+  using FilterBankImageType = typename WaveletFilterBankType::OutputImageType;
+  using FilterBankImagePointer = typename FilterBankImageType::Pointer;
+  using FilterBankOutputsType = std::vector< FilterBankImagePointer >;
+  using WaveletFilterBankCacheType = WaveletFilterBankCache< FilterBankImageType >;
+  /** Contiguous storage of the outputs, and scratch buffers of the intermediate images. */
+  using PyramidType = WaveletPyramid< OutputImageType >;
+  using FilterBankScratchType = WaveletPyramid< FilterBankImageType >;
 
   using FrequencyShrinkFilterType = TFrequencyShrinkFilterType;
+  /** Common base of the shrink filters. */
+  using ShrinkFilterBaseType = ImageToImageFilter< OutputImageType, OutputImageType >;
+  using FrequencyResamplingSelectorType = FrequencyResamplingSelector< OutputImageType >;
 
   /** ImageDimension constants */
   static constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
@@ -99,10 +125,20 @@ public:
   itkGetConstReferenceMacro(HighPassSubBands, unsigned int);
   itkGetConstReferenceMacro(TotalOutputs, unsigned int);
 
-  /** ScaleFactor for each level in the pyramid.
-   * Set to 2 (dyadic) at constructor and not modifiable, but provides future flexibility */
-  itkGetConstReferenceMacro(ScaleFactor, unsigned int);
-  // itkSetMacro(ScaleFactor, unsigned int);
+  /** Shrink factor of each axis between consecutive levels of the pyramid. 2 (dyadic) by default.
+   * An axis with a factor of 1 is not decimated, i.e. the short z axis of a stack can keep its size
+   * while the pyramid continues in-plane, \sa ComputeMaxNumberOfLevels.
+   * Only factors of 1 and 2 are accepted, SetScaleFactors throws otherwise: the wavelets of this module
+   * are dyadic, their low-pass band reaches half the Nyquist frequency and larger factors alias it.
+   * The bands are normalized with the geometric mean of the factors, \sa utils::ComputeMeanScaleFactor.
+   * The same factors have to be set in \sa WaveletFrequencyInverse. */
+  using ScaleFactorsType = FixedArray< unsigned int, ImageDimension >;
+  virtual void SetScaleFactors(const ScaleFactorsType & factors);
+  itkGetConstReferenceMacro(ScaleFactors, ScaleFactorsType);
+  /** Set the same scale factor for all the axes. */
+  virtual void SetScaleFactor(unsigned int factor);
+  /** Scale factor shared by all the axes. Throws if the axes have different factors, use GetScaleFactors. */
+  unsigned int GetScaleFactor() const;
 
   /** Return modifiable pointer of the wavelet filter bank member. */
   itkGetModifiableObjectMacro(WaveletFilterBank, WaveletFilterBankType);
@@ -112,19 +148,109 @@ public:
     return this->GetModifiableWaveletFilterBank()->GetModifiableWaveletFunction();
   }
 
+  /** Flag to choose the shrink filter of each level between FrequencyShrinkImageFilter and
+   * FrequencyShrinkViaInverseFFTImageFilter, the fastest for its size and number of work units
+   * according to a calibration benchmark, instead of TFrequencyShrinkFilterType.
+   * The choices are stored in a FrequencyResamplingSelector, the process-wide instance is used
+   * if no other selector has been set. Off by default. */
+  itkSetMacro(AutoSelectShrinkFilter, bool)
+  itkGetMacro(AutoSelectShrinkFilter, bool)
+  itkBooleanMacro(AutoSelectShrinkFilter);
+
+  itkSetObjectMacro(FrequencyResamplingSelector, FrequencyResamplingSelectorType);
+  itkGetModifiableObjectMacro(FrequencyResamplingSelector, FrequencyResamplingSelectorType);
+
   /** Flag to store the wavelet Filter Bank Pyramid, for all levels and all bands.
    * Access to it with GetWaveletFilterBankPyramid()*/
   itkSetMacro(StoreWaveletFilterBankPyramid, bool)
   itkGetMacro(StoreWaveletFilterBankPyramid, bool)
   itkBooleanMacro(StoreWaveletFilterBankPyramid);
 
-  itkGetMacro(WaveletFilterBankPyramid, OutputsType);
+  itkGetMacro(WaveletFilterBankPyramid, FilterBankOutputsType);
+
+  /** Flag to reuse the filter banks of previous runs with the same size and wavelet parameters.
+   * The banks are stored in a WaveletFilterBankCache, the process-wide instance
+   * is used if no other cache has been set. Off by default. */
+  itkSetMacro(UseWaveletFilterBankCache, bool)
+  itkGetMacro(UseWaveletFilterBankCache, bool)
+  itkBooleanMacro(UseWaveletFilterBankCache);
+
+  itkSetObjectMacro(WaveletFilterBankCache, WaveletFilterBankCacheType);
+  itkGetModifiableObjectMacro(WaveletFilterBankCache, WaveletFilterBankCacheType);
+
+  /** Flag to evaluate the wavelet at each frequency bin while multiplying it with the input,
+   * in one multi-threaded pass per level, instead of generating the images
+   * of the filter bank of each level. Off by default.
+   * Ignored when StoreWaveletFilterBankPyramid or UseWaveletFilterBankCache are On,
+   * because they require the images of the filter bank.
+   * \sa WaveletFrequencyMultiplyImageFilter */
+  itkSetMacro(ComputeFilterBankOnTheFly, bool)
+  itkGetMacro(ComputeFilterBankOnTheFly, bool)
+  itkBooleanMacro(ComputeFilterBankOnTheFly);
+
+  /** Flag for input and outputs with the half-hermitian layout of RealToHalfHermitianForwardFFTImageFilter.
+   * Requires a half-hermitian frequency iterator in the wavelet filter bank.
+   * The wavelet is always evaluated on the fly, \sa ComputeFilterBankOnTheFly, and UseWaveletFilterBankCache
+   * is ignored. Off by default. */
+  itkSetMacro(HalfHermitian, bool)
+  itkGetMacro(HalfHermitian, bool)
+  itkBooleanMacro(HalfHermitian);
+
+  /** Only used if HalfHermitian is On: the x size of the full spectrum of the input is odd.
+   * \sa RealToHalfHermitianForwardFFTImageFilter::GetActualXDimensionIsOdd */
+  itkSetMacro(ActualXDimensionIsOdd, bool)
+  itkGetMacro(ActualXDimensionIsOdd, bool)
+  itkBooleanMacro(ActualXDimensionIsOdd);
+
+  /** Flag to compute the products of the bands of a level, its low-pass and the generation of the
+   * filter bank for the next level as concurrent tasks of the ITK thread pool, each one single-threaded,
+   * instead of one after the other with multi-threaded filters.
+   * Most useful with many bands, or in coarse levels where each filter has few pixels to split in threads.
+   * Ignored in streaming mode (\sa SetBandCallback), and when the filter bank is computed on the fly,
+   * which computes all the bands of a level in one multi-threaded pass. Off by default. */
+  itkSetMacro(UseTaskParallelism, bool)
+  itkGetMacro(UseTaskParallelism, bool)
+  itkBooleanMacro(UseTaskParallelism);
+
+  /** Flag to allocate all the outputs in a single arena of the Pyramid, \sa WaveletPyramid.
+   * Each run allocates a new arena, outputs of previous runs are not overwritten.
+   * The intermediate images of each level reuse the scratch buffers of the Pyramid independently of this flag.
+   * On by default. */
+  itkSetMacro(UseContiguousPyramid, bool)
+  itkGetMacro(UseContiguousPyramid, bool)
+  itkBooleanMacro(UseContiguousPyramid);
+  itkGetModifiableObjectMacro(Pyramid, PyramidType);
+
+  /** Function receiving a high-pass band (level, band, image) as soon as it is computed. */
+  using BandCallbackType = std::function< void (unsigned int, unsigned int, const OutputImageType *) >;
+
+  /** Streaming mode: if a callback is set, each high-pass band is handed to it as soon as it is computed,
+   * instead of being stored in its output. The outputs of the high-pass bands are left without buffer,
+   * only the low-pass output is generated.
+   * The image is only valid during the call: its buffer is recycled for the next bands, so copy it
+   * (or its pixels) if it is needed afterwards.
+   * The peak memory is the input of the level, the bands in flight (one, or the bands of a level when
+   * the filter bank is computed on the fly) and the low-pass, instead of the whole pyramid.
+   * Set an empty function to store all the outputs again (the default). */
+  virtual void SetBandCallback(const BandCallbackType & callback)
+  {
+    this->m_BandCallback = callback;
+    this->Modified();
+  }
+  const BandCallbackType & GetBandCallback() const
+  {
+    return this->m_BandCallback;
+  }
 
   /** Compute max number of levels depending on the size of the image.
    * Return J: $ J = \text{min_element}\{J_0,\ldots, J_d\} $;
    * where each $J_i$ is the  number of integer divisions that can be done with the $i$ size and the scale factor.
    */
   static unsigned int ComputeMaxNumberOfLevels(const typename InputImageType::SizeType & input_size, const unsigned int scaleFactor = 2);
+  /** Compute max number of levels with a scale factor per axis.
+   * The axes with a scale factor of 1 are not decimated and do not limit the number of levels. */
+  static unsigned int ComputeMaxNumberOfLevels(const typename InputImageType::SizeType & input_size,
+    const ScaleFactorsType & scaleFactors);
 
   /** (Level, band) pair.
    * Level from: [0, m_Levels), and equal to m_Levels only for the low_pass image.
@@ -149,9 +275,37 @@ protected:
   ~WaveletFrequencyForward() override {}
   void PrintSelf(std::ostream & os, Indent indent) const override;
 
-  /** Single-threaded version of GenerateData. */
+  /** Decompose the input level by level. By default each step (band products, low-pass shrink, filter bank
+   * of the next level) is a multi-threaded filter run one after the other. With UseTaskParallelism the
+   * steps of a level are tasks of the ThreadPool, each one with a single work unit, joined before
+   * the next level. \sa UseTaskParallelism, GenerateDataWithFilterBankOnTheFly */
   void GenerateData() override;
 
+  /** Generate the filter bank [low-pass, high-pass bands...] of a level directly at its reduced size,
+   * equivalent to decimating the bank of the previous level. The images have the metadata of \c reference,
+   * the input of the level. A new generator sharing the wavelet function is used, so the bank of the next level
+   * can be generated while the current level is processed.
+   * \c numberOfWorkUnits of the generator, 0 to use the default. */
+  FilterBankOutputsType GenerateFilterBankAtLevel(const OutputImageType * reference,
+    unsigned int numberOfWorkUnits = 0) const;
+
+  /** True if the low-pass band of a level of inputSize is shrunk with FrequencyShrinkImageFilter,
+   * either because it is TFrequencyShrinkFilterType or because it is faster, \sa AutoSelectShrinkFilter.
+   * \c numberOfWorkUnits of the filters, 0 to use the default. */
+  bool UseFrequencyShrinkImageFilter(const typename OutputImageType::SizeType & inputSize,
+    unsigned int numberOfWorkUnits);
+
+  /** New filter to shrink the low-pass band of a level with the scale factors:
+   * FrequencyShrinkImageFilter if frequencyShrink, the other method of the selector with AutoSelectShrinkFilter,
+   * or TFrequencyShrinkFilterType. */
+  typename ShrinkFilterBaseType::Pointer MakeShrinkFilter(bool frequencyShrink) const;
+
+  /** GenerateData evaluating the wavelet on the fly, \sa ComputeFilterBankOnTheFly. */
+  void GenerateDataWithFilterBankOnTheFly(OutputImagePointer inputPerLevel);
+
+  /** Allocate the outputs in the arena of the Pyramid, \sa UseContiguousPyramid. */
+  void AllocateOutputs() override;
+
   /************ Information *************/
 
   /** WaveletFrequencyForward produces images which are of
@@ -184,10 +338,22 @@ private:
   unsigned int             m_Levels;
   unsigned int             m_HighPassSubBands;
   unsigned int             m_TotalOutputs;
-  unsigned int             m_ScaleFactor;
+  ScaleFactorsType         m_ScaleFactors;
   WaveletFilterBankPointer m_WaveletFilterBank;
   bool                     m_StoreWaveletFilterBankPyramid;
-  OutputsType              m_WaveletFilterBankPyramid;
+  FilterBankOutputsType    m_WaveletFilterBankPyramid;
+  bool                     m_UseWaveletFilterBankCache;
+  typename WaveletFilterBankCacheType::Pointer m_WaveletFilterBankCache;
+  bool                     m_ComputeFilterBankOnTheFly;
+  bool                     m_HalfHermitian;
+  bool                     m_ActualXDimensionIsOdd;
+  bool                     m_UseTaskParallelism;
+  bool                     m_UseContiguousPyramid;
+  bool                     m_AutoSelectShrinkFilter;
+  typename FrequencyResamplingSelectorType::Pointer m_FrequencyResamplingSelector;
+  typename PyramidType::Pointer           m_Pyramid;
+  typename FilterBankScratchType::Pointer m_FilterBankScratch;
+  BandCallbackType         m_BandCallback;
 };
 } // end namespace itk
 #ifndef ITK_MANUAL_INSTANTIATION
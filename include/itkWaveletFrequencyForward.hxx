@@ -18,13 +18,16 @@
 #ifndef itkWaveletFrequencyForward_hxx
 #define itkWaveletFrequencyForward_hxx
 #include <itkWaveletFrequencyForward.h>
-#include <itkCastImageFilter.h>
 #include <itkImage.h>
 #include <algorithm>
+#include <future>
+#include <type_traits>
+#include <itkThreadPool.h>
 #include <itkMultiplyImageFilter.h>
-#include <itkShrinkDecimateImageFilter.h>
-#include <itkChangeInformationImageFilter.h>
 #include <itkWaveletUtilities.h>
+#include <itkWaveletFrequencyMultiplyImageFilter.h>
+#include <itkFrequencyFilterBankMultiplyImageFilter.h>
+#include <itkFrequencyShrinkMultiplyImageFilter.h>
 
 namespace itk
 {
@@ -38,11 +41,20 @@ WaveletFrequencyForward< TInputImage, TOutputImage,
   : m_Levels(1),
   m_HighPassSubBands(1),
   m_TotalOutputs(1),
-  m_ScaleFactor(2),
-  m_StoreWaveletFilterBankPyramid(false)
+  m_StoreWaveletFilterBankPyramid(false),
+  m_UseWaveletFilterBankCache(false),
+  m_ComputeFilterBankOnTheFly(false),
+  m_HalfHermitian(false),
+  m_ActualXDimensionIsOdd(false),
+  m_UseTaskParallelism(false),
+  m_UseContiguousPyramid(true),
+  m_AutoSelectShrinkFilter(false)
 {
   this->SetNumberOfRequiredInputs(1);
+  m_ScaleFactors.Fill(2);
   m_WaveletFilterBank = WaveletFilterBankType::New();
+  m_Pyramid = PyramidType::New();
+  m_FilterBankScratch = FilterBankScratchType::New();
 }
 
 template< typename TInputImage,
@@ -144,6 +156,74 @@ WaveletFrequencyForward< TInputImage, TOutputImage,
   return itk::utils::ComputeMaxNumberOfLevels(inputSize, scaleFactor);
 }
 
+template< typename TInputImage,
+  typename TOutputImage,
+  typename TWaveletFilterBank,
+  typename TFrequencyShrinkFilterType >
+unsigned int
+WaveletFrequencyForward< TInputImage, TOutputImage,
+  TWaveletFilterBank, TFrequencyShrinkFilterType >
+::ComputeMaxNumberOfLevels(const typename InputImageType::SizeType & inputSize,
+    const ScaleFactorsType & scaleFactors)
+{
+  return itk::utils::ComputeMaxNumberOfLevels(inputSize, scaleFactors);
+}
+
+template< typename TInputImage,
+  typename TOutputImage,
+  typename TWaveletFilterBank,
+  typename TFrequencyShrinkFilterType >
+void
+WaveletFrequencyForward< TInputImage, TOutputImage,
+  TWaveletFilterBank, TFrequencyShrinkFilterType >
+::SetScaleFactor(unsigned int factor)
+{
+  ScaleFactorsType scaleFactors;
+  scaleFactors.Fill(factor < 1 ? 1 : factor);
+  this->SetScaleFactors(scaleFactors);
+}
+
+template< typename TInputImage,
+  typename TOutputImage,
+  typename TWaveletFilterBank,
+  typename TFrequencyShrinkFilterType >
+void
+WaveletFrequencyForward< TInputImage, TOutputImage,
+  TWaveletFilterBank, TFrequencyShrinkFilterType >
+::SetScaleFactors(const ScaleFactorsType & factors)
+{
+  if ( !itk::utils::AreWaveletScaleFactorsSupported(factors) )
+    {
+    itkExceptionMacro(<< "ScaleFactors " << factors << " not supported, only 1 and 2:"
+                      << " larger factors alias the low-pass band of the wavelet.");
+    }
+  if ( this->m_ScaleFactors != factors )
+    {
+    this->m_ScaleFactors = factors;
+    this->Modified();
+    }
+}
+
+template< typename TInputImage,
+  typename TOutputImage,
+  typename TWaveletFilterBank,
+  typename TFrequencyShrinkFilterType >
+unsigned int
+WaveletFrequencyForward< TInputImage, TOutputImage,
+  TWaveletFilterBank, TFrequencyShrinkFilterType >
+::GetScaleFactor() const
+{
+  for ( unsigned int axis = 1; axis < ImageDimension; ++axis )
+    {
+    if ( this->m_ScaleFactors[axis] != this->m_ScaleFactors[0] )
+      {
+      itkExceptionMacro(<< "The scale factors " << this->m_ScaleFactors
+        << " differ between axes, use GetScaleFactors.");
+      }
+    }
+  return this->m_ScaleFactors[0];
+}
+
 template< typename TInputImage,
   typename TOutputImage,
   typename TWaveletFilterBank,
@@ -203,6 +283,15 @@ WaveletFrequencyForward< TInputImage, TOutputImage,
      << " Levels: " << this->m_Levels
      << " HighPassSubBands: " << this->m_HighPassSubBands
      << " TotalOutputs: " << this->m_TotalOutputs
+     << " ScaleFactors: " << this->m_ScaleFactors
+     << " UseWaveletFilterBankCache: " << this->m_UseWaveletFilterBankCache
+     << " ComputeFilterBankOnTheFly: " << this->m_ComputeFilterBankOnTheFly
+     << " HalfHermitian: " << this->m_HalfHermitian
+     << " ActualXDimensionIsOdd: " << this->m_ActualXDimensionIsOdd
+     << " UseTaskParallelism: " << this->m_UseTaskParallelism
+     << " UseContiguousPyramid: " << this->m_UseContiguousPyramid
+     << " AutoSelectShrinkFilter: " << this->m_AutoSelectShrinkFilter
+     << " BandCallback: " << ( this->m_BandCallback ? "set" : "none" )
      << std::endl;
 }
 
@@ -241,6 +330,8 @@ WaveletFrequencyForward< TInputImage, TOutputImage,
   typename OutputImageType::IndexType inputStartIndexPerLevel = inputStartIndex;
   typename OutputImageType::PointType inputOriginPerLevel = inputModifiedOrigin;
   typename OutputImageType::SpacingType inputSpacingPerLevel = inputModifiedSpacing;
+  // Size in x of the full spectrum, only used with the half-hermitian layout.
+  SizeValueType fullSizeXPerLevel = 2 * ( inputSize[0] - 1 ) + ( this->m_ActualXDimensionIsOdd ? 1 : 0 );
   // typename OutputImageType::DirectionType inputDirectionPerLevel = inputDirection;
   // we need to compute the output spacing, the output image size,
   // and the output image start index
@@ -268,19 +359,24 @@ WaveletFrequencyForward< TInputImage, TOutputImage,
       {
       // Size divided by scale
       inputSizePerLevel[idim] = static_cast< SizeValueType >(
-          std::floor(static_cast< double >(inputSizePerLevel[idim]) / this->m_ScaleFactor));
+          std::floor(static_cast< double >(inputSizePerLevel[idim]) / this->m_ScaleFactors[idim]));
+      if ( idim == 0 && this->m_HalfHermitian )
+        {
+        fullSizeXPerLevel = fullSizeXPerLevel / this->m_ScaleFactors[0];
+        inputSizePerLevel[idim] = fullSizeXPerLevel / 2 + 1;
+        }
       if ( inputSizePerLevel[idim] < 1 )
         {
         inputSizePerLevel[idim] = 1;
         }
       // Index dividided by scale
       inputStartIndexPerLevel[idim] = static_cast< IndexValueType >(
-          std::ceil(static_cast< double >(inputStartIndexPerLevel[idim]) / this->m_ScaleFactor));
+          std::ceil(static_cast< double >(inputStartIndexPerLevel[idim]) / this->m_ScaleFactors[idim]));
       // Spacing
-      inputSpacingPerLevel[idim] = inputSpacingPerLevel[idim] * this->m_ScaleFactor;
+      inputSpacingPerLevel[idim] = inputSpacingPerLevel[idim] * this->m_ScaleFactors[idim];
       // Origin, the same.
       // inputOriginPerLevel[idim] = inputOriginPerLevel[idim];
-      // inputOriginPerLevel[idim] = inputOriginPerLevel[idim] / this->m_ScaleFactor;
+      // inputOriginPerLevel[idim] = inputOriginPerLevel[idim] / this->m_ScaleFactors[idim];
       }
 
     // Set the low pass at the end.
@@ -332,7 +428,8 @@ WaveletFrequencyForward< TInputImage, TOutputImage,
     itkExceptionMacro(<< "Could not cast refOutput to TOutputImage*.");
     }
 
-  if ( ptr->GetRequestedRegion() == ptr->GetLargestPossibleRegion() )
+  // The x size of the half-hermitian layout is not divided by the scale factor.
+  if ( ptr->GetRequestedRegion() == ptr->GetLargestPossibleRegion() || this->m_HalfHermitian )
     {
     // set the requested regions for the other outputs to their largest
     for ( unsigned int nout = 0; nout < this->m_TotalOutputs; ++nout )
@@ -364,10 +461,10 @@ WaveletFrequencyForward< TInputImage, TOutputImage,
       for ( unsigned int idim = 0; idim < TOutputImage::ImageDimension; idim++ )
         {
         outputIndex[idim] = baseIndex[idim]
-          * static_cast< IndexValueType >(std::pow(static_cast< double >(this->m_ScaleFactor),
+          * static_cast< IndexValueType >(std::pow(static_cast< double >(this->m_ScaleFactors[idim]),
                                             distanceToReferenceLevel));
         outputSize[idim] = baseSize[idim]
-          * static_cast< SizeValueType >(std::pow(static_cast< double >(this->m_ScaleFactor),
+          * static_cast< SizeValueType >(std::pow(static_cast< double >(this->m_ScaleFactors[idim]),
                                            distanceToReferenceLevel));
         if ( outputSize[idim] < 1 )
           {
@@ -457,6 +554,36 @@ WaveletFrequencyForward< TInputImage, TOutputImage,
   inputPtr->SetRequestedRegion(baseRegion);
 }
 
+template< typename TInputImage,
+  typename TOutputImage,
+  typename TWaveletFilterBank,
+  typename TFrequencyShrinkFilterType >
+void
+WaveletFrequencyForward< TInputImage, TOutputImage,
+  TWaveletFilterBank, TFrequencyShrinkFilterType >
+::AllocateOutputs()
+{
+  if ( !this->m_UseContiguousPyramid )
+    {
+    Superclass::AllocateOutputs();
+    return;
+    }
+
+  // All the outputs back to back in one arena. The grafted mini-pipelines reuse these buffers.
+  typename PyramidType::RegionsType regions;
+  for ( unsigned int n_output = 0; n_output < this->m_TotalOutputs; ++n_output )
+    {
+    regions.push_back(this->GetOutput(n_output)->GetRequestedRegion());
+    }
+  this->m_Pyramid->Allocate(regions);
+  for ( unsigned int n_output = 0; n_output < this->m_TotalOutputs; ++n_output )
+    {
+    OutputImageType * outputPtr = this->GetOutput(n_output);
+    outputPtr->SetBufferedRegion(regions[n_output]);
+    outputPtr->SetPixelContainer(this->m_Pyramid->GetImage(n_output)->GetPixelContainer());
+    }
+}
+
 template< typename TInputImage,
   typename TOutputImage,
   typename TWaveletFilterBank,
@@ -468,154 +595,543 @@ WaveletFrequencyForward< TInputImage, TOutputImage,
 {
   InputImageConstPointer input = this->GetInput();
 
-  this->AllocateOutputs();
+  // In streaming mode the high-pass bands are not stored in the outputs,
+  // the low-pass output is allocated when grafted.
+  if ( !this->m_BandCallback )
+    {
+    this->AllocateOutputs();
+    }
 
   // note: clear reduces size to zero, but doesn't change capacity.
   m_WaveletFilterBankPyramid.clear();
 
-  using CastFilterType = itk::CastImageFilter< InputImageType, OutputImageType >;
-  auto castFilter = CastFilterType::New();
-  castFilter->SetInput(input);
-  castFilter->Update();
-  OutputImagePointer inputPerLevel = castFilter->GetOutput();
-  using ChangeInformationFilterType = itk::ChangeInformationImageFilter< OutputImageType >;
-  auto changeInputInfoFilter = ChangeInformationFilterType::New();
-  typename InputImageType::PointType origin_old  = inputPerLevel->GetOrigin();
-  typename InputImageType::SpacingType spacing_old = inputPerLevel->GetSpacing();
-  typename InputImageType::PointType origin_new  = origin_old;
+  // The wavelet is applied with unit spacing and zero origin. Only the metadata of the view changes,
+  // the pixels of the input are not copied when the image types match.
+  OutputImagePointer inputPerLevel = itk::utils::ShareOrCastImage< InputImageType, OutputImageType >(input);
+  typename OutputImageType::PointType origin_new;
   origin_new.Fill(0);
-  typename InputImageType::SpacingType spacing_new = spacing_old;
+  typename OutputImageType::SpacingType spacing_new;
   spacing_new.Fill(1);
-  changeInputInfoFilter->SetInput(inputPerLevel);
-  changeInputInfoFilter->ChangeDirectionOff();
-  changeInputInfoFilter->ChangeRegionOff();
-  changeInputInfoFilter->ChangeSpacingOn();
-  changeInputInfoFilter->ChangeOriginOn();
-  changeInputInfoFilter->UseReferenceImageOff();
-  changeInputInfoFilter->SetOutputOrigin(origin_new);
-  changeInputInfoFilter->SetOutputSpacing(spacing_new);
-  changeInputInfoFilter->Update();
+  inputPerLevel->SetOrigin(origin_new);
+  inputPerLevel->SetSpacing(spacing_new);
+
+  if ( this->m_HalfHermitian )
+    {
+    if ( !itk::utils::IsHalfHermitianFrequencyIterator<
+           typename WaveletFilterBankType::OutputRegionIterator >::value )
+      {
+      itkExceptionMacro(<< "HalfHermitian requires a wavelet filter bank with a half-hermitian frequency iterator.");
+      }
+    this->GenerateDataWithFilterBankOnTheFly(inputPerLevel);
+    return;
+    }
+
+  if ( this->m_ComputeFilterBankOnTheFly
+       && !this->m_StoreWaveletFilterBankPyramid
+       && !this->m_UseWaveletFilterBankCache )
+    {
+    this->GenerateDataWithFilterBankOnTheFly(inputPerLevel);
+    return;
+    }
 
   // Generate WaveletFilterBank.
+  const typename OutputImageType::SizeType inputSize =
+    inputPerLevel->GetLargestPossibleRegion().GetSize();
   this->m_WaveletFilterBank->SetHighPassSubBands(this->m_HighPassSubBands);
-  this->m_WaveletFilterBank->SetSize(changeInputInfoFilter->GetOutput()->GetLargestPossibleRegion().GetSize() );
-  this->m_WaveletFilterBank->Update();
-  OutputsType highPassWavelets = this->m_WaveletFilterBank->GetOutputsHighPassBands();
-  OutputImagePointer lowPassWavelet = this->m_WaveletFilterBank->GetOutputLowPass();
+  this->m_WaveletFilterBank->SetSize(inputSize);
 
-  if ( this->m_StoreWaveletFilterBankPyramid )
+  typename WaveletFilterBankCacheType::Pointer cache;
+  if ( this->m_UseWaveletFilterBankCache )
+    {
+    cache = this->m_WaveletFilterBankCache ?
+      this->m_WaveletFilterBankCache : WaveletFilterBankCacheType::GetInstance();
+    }
+  // The bank of each level is generated at the size of the level, so banks are identified by their size,
+  // independently of the scale factors that led to it.
+  typename WaveletFilterBankCacheType::KeyType cacheKey;
+  typename WaveletFilterBankCacheType::BankType bank;
+  if ( cache )
     {
-    for ( unsigned int bankOutput = 0; bankOutput < this->m_HighPassSubBands + 1; ++bankOutput )
+    cacheKey = WaveletFilterBankCacheType::MakeKey(this->m_WaveletFilterBank.GetPointer(), inputSize, 0);
+    }
+  if ( !cache || !cache->Find(cacheKey, bank) )
+    {
+    this->m_WaveletFilterBank->Update();
+    bank = this->m_WaveletFilterBank->GetOutputsAll();
+    if ( cache )
       {
-      this->m_WaveletFilterBankPyramid.push_back(this->m_WaveletFilterBank->GetOutput(bankOutput));
+      // Detach the outputs, the generator would overwrite them in next updates.
+      for ( auto & bankImage : bank )
+        {
+        bankImage->DisconnectPipeline();
+        }
+      cache->Insert(cacheKey, bank);
       }
     }
+  FilterBankImagePointer lowPassWavelet = bank[0];
+  FilterBankOutputsType highPassWavelets(bank.begin() + 1, bank.end());
+
+  if ( this->m_StoreWaveletFilterBankPyramid )
+    {
+    this->m_WaveletFilterBankPyramid.insert(this->m_WaveletFilterBankPyramid.end(), bank.begin(), bank.end());
+    }
+
+  // The low pass product is folded as in FrequencyShrinkImageFilter.
+  using ShrinkMultiplyFilterType = itk::FrequencyShrinkMultiplyImageFilter< OutputImageType, FilterBankImageType >;
+  using MultiplyFilterType = itk::MultiplyImageFilter< FilterBankImageType >;
+  using MultiplyFilterBankFilterType = itk::FrequencyFilterBankMultiplyImageFilter< OutputImageType,
+    FilterBankImageType >;
+  // Normalization of the bands, equal to the scale factor when all the axes share it.
+  const double scaleFactor = itk::utils::ComputeMeanScaleFactor(this->m_ScaleFactors);
+  // Only used in streaming mode, \sa SetBandCallback.
+  OutputImagePointer streamedBand;
+
+  // With UseTaskParallelism the products of the bands, the low-pass and the generation of the filter bank
+  // for the next level are tasks of the thread pool, each one single-threaded. Otherwise tasks run immediately.
+  // The streaming callback is always called serially, in order.
+  const bool useTasks = this->m_UseTaskParallelism && !this->m_BandCallback;
+  const unsigned int taskWorkUnits = useTasks ? 1 : 0;
+  // Each band task uses its own scratch slot, created here as GetScratchImage is not thread-safe.
+  this->m_FilterBankScratch->ReserveScratchSlots(useTasks ? this->m_HighPassSubBands : 1);
+  std::vector< std::future< void > > tasks;
+  auto runTask = [&tasks, useTasks](const std::function< void() > & task)
+    {
+    if ( useTasks )
+      {
+      tasks.push_back(ThreadPool::GetInstance()->AddWork(task));
+      }
+    else
+      {
+      task();
+      }
+    };
+  auto waitTasks = [&tasks]()
+    {
+    // Wait for all the tasks before rethrowing their exceptions, they use local variables.
+    for ( auto & task : tasks )
+      {
+      task.wait();
+      }
+    std::vector< std::future< void > > finishedTasks;
+    finishedTasks.swap(tasks);
+    for ( auto & task : finishedTasks )
+      {
+      task.get();
+      }
+    };
+  // The pipeline of each task writes the requested region of its inputs, so concurrent tasks
+  // read the shared images through their own view of the same buffer.
+  auto inputView = [useTasks](OutputImageType * image) -> OutputImagePointer
+    {
+    if ( !useTasks )
+      {
+      return image;
+      }
+    OutputImagePointer view = OutputImageType::New();
+    view->Graft(image);
+    return view;
+    };
+  auto filterBankView = [useTasks](FilterBankImageType * image) -> FilterBankImagePointer
+    {
+    if ( !useTasks )
+      {
+      return image;
+      }
+    FilterBankImagePointer view = FilterBankImageType::New();
+    view->Graft(image);
+    return view;
+    };
+
+  auto multiplyHighBand = [&](unsigned int level, unsigned int band, OutputImageType * input,
+    FilterBankImageType * highPassWavelet, OutputImageType * graft) -> OutputImagePointer
+    {
+    /******* Band dilation factor for HighPass bands *****/
+    //  2^(1/#bands) instead of Dyadic dilations.
+    auto multiplyByAnalysisBandFactor = MultiplyFilterType::New();
+    multiplyByAnalysisBandFactor->SetInput1(highPassWavelet);
+    // Concurrent tasks need their own scratch buffer.
+    multiplyByAnalysisBandFactor->GraftOutput(this->m_FilterBankScratch->GetScratchImage(useTasks ? band : 0,
+      highPassWavelet->GetLargestPossibleRegion()));
+    // double expBandFactor = 0;
+    // double expBandFactor = - static_cast<double>(level*ImageDimension)/2.0;
+    double expBandFactor = ( -static_cast< double >(level)
+                             + band / static_cast< double >(this->m_HighPassSubBands) ) * ImageDimension / 2.0;
+    multiplyByAnalysisBandFactor->SetConstant(std::pow(scaleFactor, expBandFactor));
+    // TODO Warning: InPlace here deletes buffered region of input.
+    // http://public.kitware.com/pipermail/community/2015-April/008819.html
+    // multiplyByAnalysisBandFactor->InPlaceOn();
+    auto multiplyHighBandFilter = MultiplyFilterBankFilterType::New();
+    multiplyHighBandFilter->SetInput1(input);
+    // In the first level the input shares the pixels of the input of the transform, which is read-only.
+    multiplyHighBandFilter->InPlaceOff();
+    multiplyHighBandFilter->SetInput2(multiplyByAnalysisBandFactor->GetOutput());
+    if ( taskWorkUnits > 0 )
+      {
+      multiplyByAnalysisBandFactor->SetNumberOfWorkUnits(taskWorkUnits);
+      multiplyHighBandFilter->SetNumberOfWorkUnits(taskWorkUnits);
+      }
+    if ( graft )
+      {
+      multiplyHighBandFilter->GraftOutput(graft);
+      }
+    multiplyHighBandFilter->Update();
+    return multiplyHighBandFilter->GetOutput();
+    };
 
-  // TODO think about passing the FrequencyShrinker as template parameter to work with different FFT layout, or
-  // regular images directly in frequency domain.
-  // using LocalFrequencyShrinkFilterType = itk::FrequencyShrinkViaInverseFFTImageFilter<OutputImageType>;
-  using LocalFrequencyShrinkFilterType = itk::FrequencyShrinkImageFilter< OutputImageType >;
-  using ShrinkDecimateFilterType = itk::ShrinkDecimateImageFilter< OutputImageType, OutputImageType >;
-  using MultiplyFilterType = itk::MultiplyImageFilter< OutputImageType >;
-  inputPerLevel = changeInputInfoFilter->GetOutput();
-  auto scaleFactor = static_cast< double >(this->m_ScaleFactor);
   for ( unsigned int level = 0; level < this->m_Levels; ++level )
     {
+    const bool lastLevel = ( level == this->m_Levels - 1 );
     /******* Set HighPass bands *****/
     itkDebugMacro(<< "Number of FilterBank high pass bands: " << highPassWavelets.size() );
+    OutputsType highBands(this->m_HighPassSubBands);
     for ( unsigned int band = 0; band < this->m_HighPassSubBands; ++band )
       {
       unsigned int n_output = level * this->m_HighPassSubBands + band;
-      /******* Band dilation factor for HighPass bands *****/
-      //  2^(1/#bands) instead of Dyadic dilations.
-      auto multiplyByAnalysisBandFactor = MultiplyFilterType::New();
-      multiplyByAnalysisBandFactor->SetInput1(highPassWavelets[band]);
-      // double expBandFactor = 0;
-      // double expBandFactor = - static_cast<double>(level*ImageDimension)/2.0;
-      double expBandFactor = ( -static_cast< double >(level)
-                               + band / static_cast< double >(this->m_HighPassSubBands) ) * ImageDimension / 2.0;
-      multiplyByAnalysisBandFactor->SetConstant(std::pow(scaleFactor, expBandFactor));
-      // TODO Warning: InPlace here deletes buffered region of input.
-      // http://public.kitware.com/pipermail/community/2015-April/008819.html
-      // multiplyByAnalysisBandFactor->InPlaceOn();
-      multiplyByAnalysisBandFactor->Update();
-
-      auto multiplyHighBandFilter = MultiplyFilterType::New();
-      multiplyHighBandFilter->SetInput1(multiplyByAnalysisBandFactor->GetOutput());
-      multiplyHighBandFilter->SetInput2(inputPerLevel);
-      multiplyHighBandFilter->InPlaceOn();
-      multiplyHighBandFilter->GraftOutput(this->GetOutput(n_output));
-      multiplyHighBandFilter->Update();
-
-      this->UpdateProgress( static_cast< float >( n_output - 1 )
-        / static_cast< float >( m_TotalOutputs ) );
-      this->GraftNthOutput(n_output, multiplyHighBandFilter->GetOutput());
+      if ( this->m_BandCallback )
+        {
+        // Recycle the buffer of the previous band, the bands of next levels are not larger.
+        streamedBand = multiplyHighBand(level, band, inputPerLevel, highPassWavelets[band], streamedBand);
+        this->m_BandCallback(level, band, streamedBand);
+        this->UpdateProgress( static_cast< float >( n_output - 1 )
+          / static_cast< float >( m_TotalOutputs ) );
+        continue;
+        }
+      OutputImagePointer input = inputView(inputPerLevel);
+      FilterBankImagePointer highPassWavelet = filterBankView(highPassWavelets[band]);
+      OutputImageType * graft = this->GetOutput(n_output);
+      runTask([&highBands, &multiplyHighBand, level, band, input, highPassWavelet, graft]()
+        {
+        highBands[band] = multiplyHighBand(level, band, input, highPassWavelet, graft);
+        });
       }
-    /******* Calculate LowPass band *****/
-    auto multiplyLowFilter = MultiplyFilterType::New();
-    multiplyLowFilter->SetInput1(lowPassWavelet);
-    multiplyLowFilter->SetInput2(inputPerLevel);
-    // multiplyLowFilter->InPlaceOn();
-    multiplyLowFilter->Update();
-    inputPerLevel = multiplyLowFilter->GetOutput();
-
-    // Shrink in the frequency domain the stored low band for the next level.
-    auto freqShrinkFilter = LocalFrequencyShrinkFilterType::New();
-    freqShrinkFilter->SetInput(inputPerLevel);
-    freqShrinkFilter->SetShrinkFactors(this->m_ScaleFactor);
 
-    if ( level == this->m_Levels - 1 ) // Set low_pass output (index=this->m_TotalOutputs - 1)
+    /******* Calculate LowPass band *****/
+    typename ShrinkFilterBaseType::Pointer freqShrinkFilter;
+    if ( this->UseFrequencyShrinkImageFilter(inputPerLevel->GetLargestPossibleRegion().GetSize(), taskWorkUnits) )
+      {
+      // Multiply by the low pass and shrink in the frequency domain for the next level in one pass.
+      auto shrinkMultiplyFilter = ShrinkMultiplyFilterType::New();
+      shrinkMultiplyFilter->SetInput(inputView(inputPerLevel));
+      shrinkMultiplyFilter->SetFilterBank(filterBankView(lowPassWavelet));
+      shrinkMultiplyFilter->SetShrinkFactors(this->m_ScaleFactors);
+      freqShrinkFilter = shrinkMultiplyFilter.GetPointer();
+      }
+    else
+      {
+      // Multiply by the low pass, and shrink the product with the other filter.
+      auto multiplyLowPassFilter = MultiplyFilterBankFilterType::New();
+      multiplyLowPassFilter->SetInput1(inputView(inputPerLevel));
+      multiplyLowPassFilter->SetInput2(filterBankView(lowPassWavelet));
+      // Read-only input, as in the high-pass bands.
+      multiplyLowPassFilter->InPlaceOff();
+      multiplyLowPassFilter->GraftOutput(this->m_Pyramid->GetScratchImage(2,
+        inputPerLevel->GetLargestPossibleRegion()));
+      if ( taskWorkUnits > 0 )
+        {
+        multiplyLowPassFilter->SetNumberOfWorkUnits(taskWorkUnits);
+        }
+      freqShrinkFilter = this->MakeShrinkFilter(false);
+      freqShrinkFilter->SetInput(multiplyLowPassFilter->GetOutput());
+      }
+    if ( taskWorkUnits > 0 )
+      {
+      freqShrinkFilter->SetNumberOfWorkUnits(taskWorkUnits);
+      }
+    if ( lastLevel ) // Set low_pass output (index=this->m_TotalOutputs - 1)
       {
       freqShrinkFilter->GraftOutput(this->GetOutput(this->m_TotalOutputs - 1));
+      }
+    // The information of the input of the next level is needed to generate its filter bank.
+    freqShrinkFilter->UpdateOutputInformation();
+    OutputImagePointer nextLevelReference = OutputImageType::New();
+    nextLevelReference->CopyInformation(freqShrinkFilter->GetOutput());
+    if ( !lastLevel )
+      {
+      // The inputs of consecutive levels alternate between two scratch buffers.
+      OutputImagePointer scratch = this->m_Pyramid->GetScratchImage(level % 2,
+        nextLevelReference->GetLargestPossibleRegion());
+      scratch->CopyInformation(nextLevelReference);
+      freqShrinkFilter->GraftOutput(scratch);
+      }
+    runTask([&freqShrinkFilter]()
+      {
       freqShrinkFilter->Update();
+      });
+
+    /******* Filter bank of the next level *****/
+    bool bankIsCached = false;
+    FilterBankOutputsType nextBank;
+    if ( !lastLevel )
+      {
+      if ( cache )
+        {
+        cacheKey = WaveletFilterBankCacheType::MakeKey(this->m_WaveletFilterBank.GetPointer(),
+          nextLevelReference->GetLargestPossibleRegion().GetSize(), 0);
+        bankIsCached = cache->Find(cacheKey, bank);
+        }
+      if ( !bankIsCached )
+        {
+        runTask([&, this]()
+          {
+          nextBank = this->GenerateFilterBankAtLevel(nextLevelReference, taskWorkUnits);
+          });
+        }
+      }
+
+    waitTasks();
+
+    if ( !this->m_BandCallback )
+      {
+      for ( unsigned int band = 0; band < this->m_HighPassSubBands; ++band )
+        {
+        unsigned int n_output = level * this->m_HighPassSubBands + band;
+        this->GraftNthOutput(n_output, highBands[band]);
+        this->UpdateProgress( static_cast< float >( n_output - 1 )
+          / static_cast< float >( m_TotalOutputs ) );
+        }
+      }
+
+    if ( lastLevel )
+      {
       this->GraftNthOutput(this->m_TotalOutputs - 1, freqShrinkFilter->GetOutput());
       this->UpdateProgress( static_cast< float >( this->m_TotalOutputs - 1 )
         / static_cast< float >( this->m_TotalOutputs ) );
       continue;
       }
-    else // update inputPerLevel
+
+    // update inputPerLevel
+    inputPerLevel = freqShrinkFilter->GetOutput();
+    if ( bankIsCached )
       {
-      freqShrinkFilter->Update();
-      inputPerLevel = freqShrinkFilter->GetOutput();
-      /******* DownSample wavelets *****/
-      auto decimateWaveletFilter = ShrinkDecimateFilterType::New();
-      decimateWaveletFilter->SetInput(lowPassWavelet);
-      decimateWaveletFilter->SetShrinkFactors(this->m_ScaleFactor);
-      decimateWaveletFilter->Update();
-      auto changeDecimateInfoFilter = ChangeInformationFilterType::New();
-      changeDecimateInfoFilter->SetInput(decimateWaveletFilter->GetOutput());
-      changeDecimateInfoFilter->ChangeAll();
-      changeDecimateInfoFilter->UseReferenceImageOn();
-      changeDecimateInfoFilter->SetReferenceImage(inputPerLevel);
-      changeDecimateInfoFilter->Update();
-      lowPassWavelet = changeDecimateInfoFilter->GetOutput();
-      lowPassWavelet->DisconnectPipeline();
+      lowPassWavelet = bank[0];
+      std::copy(bank.begin() + 1, bank.end(), highPassWavelets.begin());
+      }
+    else
+      {
+      lowPassWavelet = nextBank[0];
+      std::copy(nextBank.begin() + 1, nextBank.end(), highPassWavelets.begin());
+      if ( cache )
+        {
+        cache->Insert(cacheKey, nextBank);
+        }
+      }
+
+    if ( this->m_StoreWaveletFilterBankPyramid )
+      {
+      m_WaveletFilterBankPyramid.push_back(lowPassWavelet);
       for ( unsigned int band = 0; band < this->m_HighPassSubBands; ++band )
         {
-        auto decimateHPWaveletFilter = ShrinkDecimateFilterType::New();
-        decimateHPWaveletFilter->SetShrinkFactors(this->m_ScaleFactor);
-        decimateHPWaveletFilter->SetInput(highPassWavelets[band]);
-        decimateHPWaveletFilter->Update();
-        auto changeHPDecimateInfoFilter = ChangeInformationFilterType::New();
-        changeHPDecimateInfoFilter->ChangeAll();
-        changeHPDecimateInfoFilter->UseReferenceImageOn();
-        changeHPDecimateInfoFilter->SetReferenceImage(inputPerLevel);
-        changeHPDecimateInfoFilter->SetInput(decimateHPWaveletFilter->GetOutput());
-        changeHPDecimateInfoFilter->Update();
-        highPassWavelets[band] = changeHPDecimateInfoFilter->GetOutput();
-        highPassWavelets[band]->DisconnectPipeline();
+        m_WaveletFilterBankPyramid.push_back(highPassWavelets[band]);
+        }
+      }
+    } // end level
+}
+
+template< typename TInputImage,
+  typename TOutputImage,
+  typename TWaveletFilterBank,
+  typename TFrequencyShrinkFilterType >
+bool
+WaveletFrequencyForward< TInputImage, TOutputImage,
+  TWaveletFilterBank, TFrequencyShrinkFilterType >
+::UseFrequencyShrinkImageFilter(const typename OutputImageType::SizeType & inputSize,
+  unsigned int numberOfWorkUnits)
+{
+  if ( !this->m_AutoSelectShrinkFilter )
+    {
+    return std::is_same< FrequencyShrinkFilterType, FrequencyShrinkImageFilter< OutputImageType > >::value;
+    }
+  if ( !this->m_FrequencyResamplingSelector )
+    {
+    this->m_FrequencyResamplingSelector = FrequencyResamplingSelectorType::GetInstance();
+    }
+  return this->m_FrequencyResamplingSelector->SelectShrinkMethod(inputSize, this->m_ScaleFactors,
+    numberOfWorkUnits > 0 ? numberOfWorkUnits : this->GetNumberOfWorkUnits())
+         == FrequencyResamplingSelectorType::MethodType::Frequency;
+}
+
+template< typename TInputImage,
+  typename TOutputImage,
+  typename TWaveletFilterBank,
+  typename TFrequencyShrinkFilterType >
+typename WaveletFrequencyForward< TInputImage, TOutputImage,
+  TWaveletFilterBank, TFrequencyShrinkFilterType >::ShrinkFilterBaseType::Pointer
+WaveletFrequencyForward< TInputImage, TOutputImage,
+  TWaveletFilterBank, TFrequencyShrinkFilterType >
+::MakeShrinkFilter(bool frequencyShrink) const
+{
+  using MethodType = typename FrequencyResamplingSelectorType::MethodType;
+  if ( frequencyShrink || this->m_AutoSelectShrinkFilter )
+    {
+    return FrequencyResamplingSelectorType::MakeShrinkFilter(
+      frequencyShrink ? MethodType::Frequency : MethodType::ViaInverseFFT, this->m_ScaleFactors);
+    }
+  auto shrinkFilter = FrequencyShrinkFilterType::New();
+  shrinkFilter->SetShrinkFactors(this->m_ScaleFactors);
+  return shrinkFilter.GetPointer();
+}
+
+template< typename TInputImage,
+  typename TOutputImage,
+  typename TWaveletFilterBank,
+  typename TFrequencyShrinkFilterType >
+typename WaveletFrequencyForward< TInputImage, TOutputImage,
+  TWaveletFilterBank, TFrequencyShrinkFilterType >::FilterBankOutputsType
+WaveletFrequencyForward< TInputImage, TOutputImage,
+  TWaveletFilterBank, TFrequencyShrinkFilterType >
+::GenerateFilterBankAtLevel(const OutputImageType * reference,
+  unsigned int numberOfWorkUnits) const
+{
+  auto generator = WaveletFilterBankType::New();
+  generator->SetWaveletFunction(this->m_WaveletFilterBank->GetModifiableWaveletFunction());
+  generator->SetHighPassSubBands(this->m_HighPassSubBands);
+  generator->SetUseRadialLookupTable(this->m_WaveletFilterBank->GetUseRadialLookupTable());
+  generator->SetRadialLookupTableSize(this->m_WaveletFilterBank->GetRadialLookupTableSize());
+  generator->SetSize(reference->GetLargestPossibleRegion().GetSize());
+  if ( numberOfWorkUnits > 0 )
+    {
+    generator->SetNumberOfWorkUnits(numberOfWorkUnits);
+    }
+  generator->Update();
+  FilterBankOutputsType bank = generator->GetOutputsAll();
+  for ( auto & bankImage : bank )
+    {
+    bankImage->DisconnectPipeline();
+    // The pixel type of the filter bank might differ from the reference, copy the metadata instead of
+    // using a ChangeInformationImageFilter.
+    bankImage->SetRegions(reference->GetLargestPossibleRegion());
+    bankImage->SetOrigin(reference->GetOrigin());
+    bankImage->SetSpacing(reference->GetSpacing());
+    bankImage->SetDirection(reference->GetDirection());
+    }
+  return bank;
+}
+
+template< typename TInputImage,
+  typename TOutputImage,
+  typename TWaveletFilterBank,
+  typename TFrequencyShrinkFilterType >
+void
+WaveletFrequencyForward< TInputImage, TOutputImage,
+  TWaveletFilterBank, TFrequencyShrinkFilterType >
+::GenerateDataWithFilterBankOnTheFly(OutputImagePointer inputPerLevel)
+{
+  // The input of each level has unit spacing times the accumulated shrink factor. The wavelet is evaluated
+  // at the frequencies normalized by the spacing, equivalent to decimating the filter bank of the previous level.
+  using MultiplyWaveletFilterType = itk::WaveletFrequencyMultiplyImageFilter< OutputImageType,
+    WaveletFunctionType, typename itk::utils::RebindFrequencyIterator<
+      typename WaveletFilterBankType::OutputRegionIterator, OutputImageType >::Type >;
+  using HalfHermitianShrinkFilterType = itk::FrequencyShrinkImageFilter< OutputImageType >;
+  // Normalization of the bands, equal to the scale factor when all the axes share it.
+  const double scaleFactor = itk::utils::ComputeMeanScaleFactor(this->m_ScaleFactors);
+  // Only used with the half-hermitian layout.
+  bool actualXDimensionIsOdd = this->m_ActualXDimensionIsOdd;
+  // Only used in streaming mode, \sa SetBandCallback.
+  OutputsType streamedBands(this->m_HighPassSubBands);
+  for ( unsigned int level = 0; level < this->m_Levels; ++level )
+    {
+    if ( this->m_StoreWaveletFilterBankPyramid )
+      {
+      // Generate the bank at the size of the level, equivalent to the decimation of the bank of the first level.
+      this->m_WaveletFilterBank->SetHighPassSubBands(this->m_HighPassSubBands);
+      this->m_WaveletFilterBank->SetSize(inputPerLevel->GetLargestPossibleRegion().GetSize());
+      this->m_WaveletFilterBank->SetActualXDimensionIsOdd(actualXDimensionIsOdd);
+      this->m_WaveletFilterBank->Modified();
+      this->m_WaveletFilterBank->UpdateLargestPossibleRegion();
+      for ( auto & bankImage : this->m_WaveletFilterBank->GetOutputsAll() )
+        {
+        bankImage->DisconnectPipeline();
+        bankImage->SetSpacing(inputPerLevel->GetSpacing());
+        this->m_WaveletFilterBankPyramid.push_back(bankImage);
         }
+      }
+
+    auto multiplyWaveletFilter = MultiplyWaveletFilterType::New();
+    multiplyWaveletFilter->SetWaveletFunction(this->GetModifiableWaveletFunction());
+    multiplyWaveletFilter->SetHighPassSubBands(this->m_HighPassSubBands);
+    multiplyWaveletFilter->SetActualXDimensionIsOdd(actualXDimensionIsOdd);
+    multiplyWaveletFilter->SetInput(inputPerLevel);
 
-      if ( this->m_StoreWaveletFilterBankPyramid )
+    /******* Band dilation factor for HighPass bands *****/
+    //  2^(1/#bands) instead of Dyadic dilations.
+    typename MultiplyWaveletFilterType::BandFactorsType bandFactors(this->m_HighPassSubBands + 1, 1.0);
+    for ( unsigned int band = 0; band < this->m_HighPassSubBands; ++band )
+      {
+      double expBandFactor = ( -static_cast< double >(level)
+                               + band / static_cast< double >(this->m_HighPassSubBands) ) * ImageDimension / 2.0;
+      bandFactors[band + 1] = std::pow(scaleFactor, expBandFactor);
+      unsigned int n_output = level * this->m_HighPassSubBands + band;
+      if ( this->m_BandCallback )
         {
-        m_WaveletFilterBankPyramid.push_back(lowPassWavelet);
-        for ( unsigned int band = 0; band < this->m_HighPassSubBands; ++band )
+        // Recycle the buffers of the bands of the previous level.
+        if ( streamedBands[band] )
           {
-          m_WaveletFilterBankPyramid.push_back(highPassWavelets[band]);
+          multiplyWaveletFilter->GraftNthOutput(band + 1, streamedBands[band]);
           }
         }
-      } // end update inputPerLevel
-    } // end level
+      else
+        {
+        multiplyWaveletFilter->GraftNthOutput(band + 1, this->GetOutput(n_output));
+        }
+      }
+    multiplyWaveletFilter->SetBandFactors(bandFactors);
+    multiplyWaveletFilter->GraftNthOutput(0, this->m_Pyramid->GetScratchImage(2,
+      inputPerLevel->GetLargestPossibleRegion()));
+    multiplyWaveletFilter->Update();
+
+    for ( unsigned int band = 0; band < this->m_HighPassSubBands; ++band )
+      {
+      if ( this->m_BandCallback )
+        {
+        streamedBands[band] = multiplyWaveletFilter->GetOutput(band + 1);
+        this->m_BandCallback(level, band, streamedBands[band]);
+        continue;
+        }
+      unsigned int n_output = level * this->m_HighPassSubBands + band;
+      this->GraftNthOutput(n_output, multiplyWaveletFilter->GetOutput(band + 1));
+      }
+    this->UpdateProgress( static_cast< float >( (level + 1) * this->m_HighPassSubBands )
+      / static_cast< float >( this->m_TotalOutputs ) );
+
+    // Shrink in the frequency domain the low band for the next level.
+    typename ShrinkFilterBaseType::Pointer freqShrinkFilter;
+    typename HalfHermitianShrinkFilterType::Pointer halfHermitianShrinkFilter;
+    if ( this->m_HalfHermitian )
+      {
+      halfHermitianShrinkFilter = HalfHermitianShrinkFilterType::New();
+      halfHermitianShrinkFilter->SetShrinkFactors(this->m_ScaleFactors);
+      halfHermitianShrinkFilter->HalfHermitianOn();
+      halfHermitianShrinkFilter->SetActualXDimensionIsOdd(actualXDimensionIsOdd);
+      freqShrinkFilter = halfHermitianShrinkFilter.GetPointer();
+      }
+    else
+      {
+      freqShrinkFilter = this->MakeShrinkFilter(
+        this->UseFrequencyShrinkImageFilter(inputPerLevel->GetLargestPossibleRegion().GetSize(), 0));
+      }
+    freqShrinkFilter->SetInput(multiplyWaveletFilter->GetOutputLowPass());
+    if ( level == this->m_Levels - 1 ) // Set low_pass output (index=this->m_TotalOutputs - 1)
+      {
+      freqShrinkFilter->GraftOutput(this->GetOutput(this->m_TotalOutputs - 1));
+      freqShrinkFilter->Update();
+      this->GraftNthOutput(this->m_TotalOutputs - 1, freqShrinkFilter->GetOutput());
+      }
+    else
+      {
+      // The inputs of consecutive levels alternate between two scratch buffers.
+      freqShrinkFilter->UpdateOutputInformation();
+      OutputImagePointer scratch = this->m_Pyramid->GetScratchImage(level % 2,
+        freqShrinkFilter->GetOutput()->GetLargestPossibleRegion());
+      scratch->CopyInformation(freqShrinkFilter->GetOutput());
+      freqShrinkFilter->GraftOutput(scratch);
+      freqShrinkFilter->Update();
+      inputPerLevel = freqShrinkFilter->GetOutput();
+      if ( halfHermitianShrinkFilter )
+        {
+        actualXDimensionIsOdd = halfHermitianShrinkFilter->GetOutputActualXDimensionIsOdd();
+        }
+      }
+    }
 }
 } // end namespace itk
 #endif
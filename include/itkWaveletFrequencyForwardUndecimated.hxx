@@ -18,11 +18,9 @@
 #ifndef itkWaveletFrequencyForwardUndecimated_hxx
 #define itkWaveletFrequencyForwardUndecimated_hxx
 #include <itkWaveletFrequencyForwardUndecimated.h>
-#include <itkCastImageFilter.h>
 #include <itkImage.h>
 #include <algorithm>
 #include <itkMultiplyImageFilter.h>
-#include <itkChangeInformationImageFilter.h>
 #include <itkWaveletUtilities.h>
 
 namespace itk
@@ -321,32 +319,19 @@ WaveletFrequencyForwardUndecimated< TInputImage, TOutputImage,
   // note: clear reduces size to zero, but doesn't change capacity.
   m_WaveletFilterBankPyramid.clear();
 
-  using CastFilterType = itk::CastImageFilter< InputImageType, OutputImageType >;
-  auto castFilter = CastFilterType::New();
-  castFilter->SetInput(input);
-  castFilter->Update();
-  OutputImagePointer inputPerLevel = castFilter->GetOutput();
-  using ChangeInformationFilterType = itk::ChangeInformationImageFilter< OutputImageType >;
-  auto changeInputInfoFilter = ChangeInformationFilterType::New();
-  typename InputImageType::PointType origin_old  = inputPerLevel->GetOrigin();
-  typename InputImageType::SpacingType spacing_old = inputPerLevel->GetSpacing();
-  typename InputImageType::PointType origin_new  = origin_old;
+  // The wavelet is applied with unit spacing and zero origin. Only the metadata of the view changes,
+  // the pixels of the input are not copied when the image types match.
+  OutputImagePointer inputPerLevel = itk::utils::ShareOrCastImage< InputImageType, OutputImageType >(input);
+  typename OutputImageType::PointType origin_new;
   origin_new.Fill(0);
-  typename InputImageType::SpacingType spacing_new = spacing_old;
+  typename OutputImageType::SpacingType spacing_new;
   spacing_new.Fill(1);
-  changeInputInfoFilter->SetInput(inputPerLevel);
-  changeInputInfoFilter->ChangeDirectionOff();
-  changeInputInfoFilter->ChangeRegionOff();
-  changeInputInfoFilter->ChangeSpacingOn();
-  changeInputInfoFilter->ChangeOriginOn();
-  changeInputInfoFilter->UseReferenceImageOff();
-  changeInputInfoFilter->SetOutputOrigin(origin_new);
-  changeInputInfoFilter->SetOutputSpacing(spacing_new);
-  changeInputInfoFilter->Update();
+  inputPerLevel->SetOrigin(origin_new);
+  inputPerLevel->SetSpacing(spacing_new);
 
   // Generate WaveletFilterBank.
   this->m_WaveletFilterBank->SetHighPassSubBands(this->m_HighPassSubBands);
-  this->m_WaveletFilterBank->SetSize(changeInputInfoFilter->GetOutput()->GetLargestPossibleRegion().GetSize() );
+  this->m_WaveletFilterBank->SetSize(inputPerLevel->GetLargestPossibleRegion().GetSize() );
   this->m_WaveletFilterBank->Update();
   OutputsType highPassWavelets = this->m_WaveletFilterBank->GetOutputsHighPassBands();
   OutputImagePointer lowPassWavelet = this->m_WaveletFilterBank->GetOutputLowPass();
@@ -360,7 +345,6 @@ WaveletFrequencyForwardUndecimated< TInputImage, TOutputImage,
     }
 
   using MultiplyFilterType = itk::MultiplyImageFilter< OutputImageType >;
-  inputPerLevel = changeInputInfoFilter->GetOutput();
   auto scaleFactor = static_cast< double >(this->m_ScaleFactor);
   for ( unsigned int level = 0; level < this->m_Levels; ++level )
     {
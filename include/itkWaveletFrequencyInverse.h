@@ -24,8 +24,10 @@
 #include <complex>
 #include <itkFixedArray.h>
 #include <itkImageToImageFilter.h>
+#include <itkWaveletFilterBankCache.h>
 #include <itkFrequencyExpandViaInverseFFTImageFilter.h>
 #include <itkFrequencyExpandImageFilter.h>
+#include <itkFrequencyResamplingSelector.h>
 
 namespace itk
 {
@@ -33,6 +35,13 @@ namespace itk
  * @brief Wavelet analysis where input is an FFT image.
  * Aim to be Isotropic.
  *
+ * With HalfHermitian On, the inputs and the output have the half-hermitian layout
+ * of RealToHalfHermitianForwardFFTImageFilter, and the output can be transformed back with a
+ * HalfHermitianToRealInverseFFTImageFilter. The wavelet filter bank must use a half-hermitian frequency
+ * iterator, i.e. FrequencyHalfHermitianFFTLayoutImageRegionIteratorWithIndex.
+ *
+ * To add the inputs one at a time instead of setting them all, \sa WaveletFrequencyInverseAccumulator.
+ *
  * \ingroup IsotropicWavelets
  */
 template< typename TInputImage,
@@ -40,7 +49,6 @@ template< typename TInputImage,
   typename TWaveletFilterBank,
   typename TFrequencyExpandFilterType =
     FrequencyExpandImageFilter<TInputImage> >
-    // FrequencyExpandViaInverseFFTImageFilter<TInputImage> >
 class WaveletFrequencyInverse:
   public ImageToImageFilter< TInputImage, TOutputImage>
 {
@@ -67,8 +75,16 @@ public:
   using WaveletFilterBankPointer = typename WaveletFilterBankType::Pointer;
   using WaveletFunctionType = typename WaveletFilterBankType::WaveletFunctionType;
   using FunctionValueType = typename WaveletFilterBankType::FunctionValueType;
+  /** The images of the filter bank can have a real pixel type, cheaper than the complex input. */
+  using FilterBankImageType = typename WaveletFilterBankType::OutputImageType;
+  using FilterBankImagePointer = typename FilterBankImageType::Pointer;
+  using FilterBankInputsType = std::vector< FilterBankImagePointer >;
+  using WaveletFilterBankCacheType = WaveletFilterBankCache< FilterBankImageType >;
 
   using FrequencyExpandFilterType = TFrequencyExpandFilterType;
+  /** Common base of the expand filters. */
+  using ExpandFilterBaseType = ImageToImageFilter< InputImageType, InputImageType >;
+  using FrequencyResamplingSelectorType = FrequencyResamplingSelector< InputImageType >;
 
   /** ImageDimension constants */
   static constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
@@ -91,9 +107,16 @@ public:
   /** Total number of inputs required: Levels*HighPassSubBands + 1 */
   itkGetMacro(TotalInputs, unsigned int);
 
-  /** Shrink/Expand factor at each level.
-   * Set to 2 (dyadic), not modifiable, but providing future flexibility */
-  itkGetConstReferenceMacro(ScaleFactor, unsigned int)
+  /** Expand factor of each axis between consecutive levels, 2 (dyadic) by default.
+   * Has to be equal to the ScaleFactors of the \sa WaveletFrequencyForward that generated the inputs.
+   * Only factors of 1 and 2 are accepted, SetScaleFactors throws otherwise. */
+  using ScaleFactorsType = FixedArray< unsigned int, ImageDimension >;
+  virtual void SetScaleFactors(const ScaleFactorsType & factors);
+  itkGetConstReferenceMacro(ScaleFactors, ScaleFactorsType);
+  /** Set the same scale factor for all the axes. */
+  virtual void SetScaleFactor(unsigned int factor);
+  /** Scale factor shared by all the axes. Throws if the axes have different factors, use GetScaleFactors. */
+  unsigned int GetScaleFactor() const;
 
   /**
    * If On, applies to each input the appropiate Level-Band multiplicative factor. Needed for perfect reconstruction.
@@ -112,11 +135,46 @@ public:
    * Set vector containing the WaveletFilterBankPyramid.
    * This vector is generated in the ForwardWavelet when StoreWaveletFilterBankPyramid is On.
    */
-  void SetWaveletFilterBankPyramid(const InputsType &filterBankPyramid)
+  void SetWaveletFilterBankPyramid(const FilterBankInputsType &filterBankPyramid)
     {
     this->m_WaveletFilterBankPyramid = filterBankPyramid;
     }
 
+  /** Flag to reuse the filter banks of previous runs with the same size and wavelet parameters.
+   * The banks are stored in a WaveletFilterBankCache, the process-wide instance
+   * is used if no other cache has been set. Off by default.
+   * Ignored if UseWaveletFilterBankPyramid is On. */
+  itkGetConstReferenceMacro(UseWaveletFilterBankCache, bool)
+  itkSetMacro(UseWaveletFilterBankCache, bool)
+  itkBooleanMacro(UseWaveletFilterBankCache);
+
+  itkSetObjectMacro(WaveletFilterBankCache, WaveletFilterBankCacheType);
+  itkGetModifiableObjectMacro(WaveletFilterBankCache, WaveletFilterBankCacheType);
+
+  /** Flag to choose the expand filter of each level between FrequencyExpandImageFilter and
+   * FrequencyExpandViaInverseFFTImageFilter, the fastest for its size and number of work units
+   * according to a calibration benchmark, instead of TFrequencyExpandFilterType.
+   * The choices are stored in a FrequencyResamplingSelector, the process-wide instance is used
+   * if no other selector has been set. Ignored if HalfHermitian is On. Off by default. */
+  itkGetConstReferenceMacro(AutoSelectExpandFilter, bool)
+  itkSetMacro(AutoSelectExpandFilter, bool)
+  itkBooleanMacro(AutoSelectExpandFilter);
+
+  itkSetObjectMacro(FrequencyResamplingSelector, FrequencyResamplingSelectorType);
+  itkGetModifiableObjectMacro(FrequencyResamplingSelector, FrequencyResamplingSelectorType);
+
+  /** Flag for inputs and output with the half-hermitian layout of RealToHalfHermitianForwardFFTImageFilter.
+   * The low pass is expanded with a FrequencyExpandImageFilter, independently of TFrequencyExpandFilterType,
+   * and UseWaveletFilterBankCache is ignored. Off by default. */
+  itkGetConstReferenceMacro(HalfHermitian, bool)
+  itkSetMacro(HalfHermitian, bool)
+  itkBooleanMacro(HalfHermitian);
+
+  /** Only used if HalfHermitian is On: the x size of the full spectrum of the output is odd. */
+  itkGetConstReferenceMacro(ActualXDimensionIsOdd, bool)
+  itkSetMacro(ActualXDimensionIsOdd, bool)
+  itkBooleanMacro(ActualXDimensionIsOdd);
+
   using IndexPairType = std::pair<unsigned int, unsigned int>;
   /** Get the (Level,Band) from a linear index input */
   IndexPairType InputIndexToLevelBand(unsigned int linear_index);
@@ -163,6 +221,16 @@ protected:
    */
   void GenerateInputRequestedRegion() override;
 
+  /** True if the low-pass band of a level of inputSize is expanded with FrequencyExpandImageFilter,
+   * either because it is TFrequencyExpandFilterType or because it is faster, \sa AutoSelectExpandFilter.
+   * The expansion is then fused with the upsample correction and the low-pass multiplication,
+   * \sa FrequencyExpandMultiplyImageFilter. Always false with HalfHermitian. */
+  bool UseFrequencyExpandImageFilter(const typename InputImageType::SizeType & inputSize);
+
+  /** New filter to expand the low-pass band of a level with the scale factors:
+   * the other method of the selector with AutoSelectExpandFilter, or TFrequencyExpandFilterType. */
+  typename ExpandFilterBaseType::Pointer MakeExpandFilter() const;
+
   /** Input images do not occupy the same physical space.
    * Remove the check. */
   void VerifyInputInformation() ITKv5_CONST override {};
@@ -171,11 +239,17 @@ private:
   unsigned int             m_Levels;
   unsigned int             m_HighPassSubBands;
   unsigned int             m_TotalInputs;
-  unsigned int             m_ScaleFactor;
+  ScaleFactorsType         m_ScaleFactors;
   bool                     m_ApplyReconstructionFactors;
   bool                     m_UseWaveletFilterBankPyramid;
   WaveletFilterBankPointer m_WaveletFilterBank;
-  InputsType               m_WaveletFilterBankPyramid;
+  FilterBankInputsType     m_WaveletFilterBankPyramid;
+  bool                     m_UseWaveletFilterBankCache;
+  typename WaveletFilterBankCacheType::Pointer m_WaveletFilterBankCache;
+  bool                     m_HalfHermitian;
+  bool                     m_ActualXDimensionIsOdd;
+  bool                     m_AutoSelectExpandFilter;
+  typename FrequencyResamplingSelectorType::Pointer m_FrequencyResamplingSelector;
 };
 } // end namespace itk
 #ifndef ITK_MANUAL_INSTANTIATION
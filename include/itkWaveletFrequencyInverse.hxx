@@ -18,14 +18,14 @@
 #ifndef itkWaveletFrequencyInverse_hxx
 #define itkWaveletFrequencyInverse_hxx
 #include <itkWaveletFrequencyInverse.h>
-#include <itkCastImageFilter.h>
 #include <itkImage.h>
 #include <algorithm>
 #include <itkMultiplyImageFilter.h>
-#include <itkAddImageFilter.h>
-#include <itkImageDuplicator.h>
-#include <itkChangeInformationImageFilter.h>
 #include <itkWaveletUtilities.h>
+#include <itkFrequencyFilterBankMultiplyImageFilter.h>
+#include <itkFrequencyExpandMultiplyImageFilter.h>
+#include <itkFrequencyBandAccumulateImageFilter.h>
+#include <type_traits>
 
 namespace itk
 {
@@ -39,14 +39,73 @@ WaveletFrequencyInverse< TInputImage, TOutputImage,
   : m_Levels(1),
   m_HighPassSubBands(1),
   m_TotalInputs(0),
-  m_ScaleFactor(2),
   m_ApplyReconstructionFactors(true),
-  m_UseWaveletFilterBankPyramid(false)
+  m_UseWaveletFilterBankPyramid(false),
+  m_UseWaveletFilterBankCache(false),
+  m_HalfHermitian(false),
+  m_ActualXDimensionIsOdd(false),
+  m_AutoSelectExpandFilter(false)
 {
   this->SetNumberOfRequiredOutputs(1);
+  this->m_ScaleFactors.Fill(2);
   this->m_WaveletFilterBank = WaveletFilterBankType::New();
 }
 
+template< typename TInputImage,
+  typename TOutputImage,
+  typename TWaveletFilterBank,
+  typename TFrequencyExpandFilterType >
+void
+WaveletFrequencyInverse< TInputImage, TOutputImage,
+  TWaveletFilterBank, TFrequencyExpandFilterType >
+::SetScaleFactor(unsigned int factor)
+{
+  ScaleFactorsType scaleFactors;
+  scaleFactors.Fill(factor < 1 ? 1 : factor);
+  this->SetScaleFactors(scaleFactors);
+}
+
+template< typename TInputImage,
+  typename TOutputImage,
+  typename TWaveletFilterBank,
+  typename TFrequencyExpandFilterType >
+void
+WaveletFrequencyInverse< TInputImage, TOutputImage,
+  TWaveletFilterBank, TFrequencyExpandFilterType >
+::SetScaleFactors(const ScaleFactorsType & factors)
+{
+  if ( !itk::utils::AreWaveletScaleFactorsSupported(factors) )
+    {
+    itkExceptionMacro(<< "ScaleFactors " << factors << " not supported, only 1 and 2:"
+                      << " larger factors alias the low-pass band of the wavelet.");
+    }
+  if ( this->m_ScaleFactors != factors )
+    {
+    this->m_ScaleFactors = factors;
+    this->Modified();
+    }
+}
+
+template< typename TInputImage,
+  typename TOutputImage,
+  typename TWaveletFilterBank,
+  typename TFrequencyExpandFilterType >
+unsigned int
+WaveletFrequencyInverse< TInputImage, TOutputImage,
+  TWaveletFilterBank, TFrequencyExpandFilterType >
+::GetScaleFactor() const
+{
+  for ( unsigned int axis = 1; axis < ImageDimension; ++axis )
+    {
+    if ( this->m_ScaleFactors[axis] != this->m_ScaleFactors[0] )
+      {
+      itkExceptionMacro(<< "The scale factors " << this->m_ScaleFactors
+        << " differ between axes, use GetScaleFactors.");
+      }
+    }
+  return this->m_ScaleFactors[0];
+}
+
 template< typename TInputImage,
   typename TOutputImage,
   typename TWaveletFilterBank,
@@ -172,9 +231,13 @@ WaveletFrequencyInverse< TInputImage, TOutputImage,
   os << indent << "Levels: " << this->m_Levels << std::endl;
   os << indent << "HighPassSubBands: " << this->m_HighPassSubBands << std::endl;
   os << indent << "TotalInputs: " << this->m_TotalInputs << std::endl;
-  os << indent << "ScaleFactor: " << this->m_ScaleFactor << std::endl;
+  os << indent << "ScaleFactors: " << this->m_ScaleFactors << std::endl;
   os << indent << "ApplyReconstructionFactors: " << this->m_ApplyReconstructionFactors << std::endl;
   os << indent << "UseWaveletFilterBankPyramid: " << this->m_UseWaveletFilterBankPyramid << std::endl;
+  os << indent << "UseWaveletFilterBankCache: " << this->m_UseWaveletFilterBankCache << std::endl;
+  os << indent << "HalfHermitian: " << this->m_HalfHermitian << std::endl;
+  os << indent << "ActualXDimensionIsOdd: " << this->m_ActualXDimensionIsOdd << std::endl;
+  os << indent << "AutoSelectExpandFilter: " << this->m_AutoSelectExpandFilter << std::endl;
   itkPrintSelfObjectMacro(WaveletFilterBank);
 }
 
@@ -249,6 +312,20 @@ WaveletFrequencyInverse< TInputImage, TOutputImage,
   // call the superclass' implementation of this method
   Superclass::GenerateInputRequestedRegion();
 
+  // The x size of the half-hermitian layout is not divided by the scale factor.
+  if ( this->m_HalfHermitian )
+    {
+    for ( unsigned int nInput = 0; nInput < this->m_TotalInputs; ++nInput )
+      {
+      if ( !this->GetInput(nInput) )
+        {
+        itkExceptionMacro(<< "Input ptr does not exist: " << nInput );
+        }
+      const_cast< InputImageType * >(this->GetInput(nInput))->SetRequestedRegionToLargestPossibleRegion();
+      }
+    return;
+    }
+
   // compute baseIndex and baseSize
   using SizeType = typename OutputImageType::SizeType;
   using IndexType = typename OutputImageType::IndexType;
@@ -282,10 +359,10 @@ WaveletFrequencyInverse< TInputImage, TOutputImage,
       }
 
     /******* Update base region for next level *********/
-    unsigned int scaleFactorPerLevel = std::pow(static_cast< double >(this->m_ScaleFactor),
-        static_cast< int >(level + 1));
     for ( unsigned int idim = 0; idim < TInputImage::ImageDimension; idim++ )
       {
+      const double scaleFactorPerLevel = std::pow(static_cast< double >(this->m_ScaleFactors[idim]),
+          static_cast< int >(level + 1));
       // inputIndex[idim] = baseIndex[idim] * scaleFactorPerLevel;
       // inputSize[idim] = baseSize[idim] * scaleFactorPerLevel;
       // Index by half.
@@ -333,51 +410,128 @@ WaveletFrequencyInverse< TInputImage, TOutputImage,
   TWaveletFilterBank, TFrequencyExpandFilterType >
 ::GenerateData()
 {
-  this->AllocateOutputs();
+  // The output is not allocated, it is grafted from the reconstruction of the last level.
   // Start with the approximation image (the smallest).
   InputImageConstPointer low_pass = this->GetInput(this->m_TotalInputs - 1);
 
-  using DuplicatorType = itk::ImageDuplicator< InputImageType >;
-  auto duplicator = DuplicatorType::New();
-  duplicator->SetInputImage(low_pass);
-  duplicator->Update();
-  InputImagePointer low_pass_per_level = duplicator->GetOutput();
+  // The low pass input is only read: share its pixels instead of duplicating them.
+  InputImagePointer low_pass_per_level = itk::utils::ShareOrCastImage< InputImageType, InputImageType >(low_pass);
 
   using MultiplyFilterType = itk::MultiplyImageFilter< InputImageType >;
 
-  auto scaleFactor = static_cast< double >(this->m_ScaleFactor);
+  // Only used with the half-hermitian layout: x size of the full spectrum of the low pass is odd.
+  bool actualXDimensionIsOdd = false;
+  if ( this->m_HalfHermitian )
+    {
+    if ( !itk::utils::IsHalfHermitianFrequencyIterator<
+           typename WaveletFilterBankType::OutputRegionIterator >::value )
+      {
+      itkExceptionMacro(<< "HalfHermitian requires a wavelet filter bank with a half-hermitian frequency iterator.");
+      }
+    SizeValueType fullSizeX = 2 * ( this->GetInput(0)->GetLargestPossibleRegion().GetSize()[0] - 1 )
+      + ( this->m_ActualXDimensionIsOdd ? 1 : 0 );
+    for ( unsigned int level = 0; level < this->m_Levels; ++level )
+      {
+      fullSizeX /= this->m_ScaleFactors[0];
+      }
+    actualXDimensionIsOdd = ( fullSizeX % 2 == 1 );
+    }
+
+  typename WaveletFilterBankCacheType::Pointer cache;
+  if ( this->m_UseWaveletFilterBankCache && !this->m_UseWaveletFilterBankPyramid && !this->m_HalfHermitian )
+    {
+    cache = this->m_WaveletFilterBankCache ?
+      this->m_WaveletFilterBankCache : WaveletFilterBankCacheType::GetInstance();
+    }
+
+  // Normalization of the bands and the upsampling, equal to the scale factor when all the axes share it.
+  const double scaleFactor = itk::utils::ComputeMeanScaleFactor(this->m_ScaleFactors);
   for ( int level = this->m_Levels - 1; level > -1; --level )
     {
     itkDebugMacro( << "LEVEL: " << level );
     /******** Upsample LowPass ********/
-    auto expandFilter = FrequencyExpandFilterType::New();
-    expandFilter->SetInput(low_pass_per_level);
-    expandFilter->SetExpandFactors(this->m_ScaleFactor);
-    expandFilter->Update();
-    itkDebugMacro(<< "Low_pass_per_level: " << level << " Region:" << low_pass_per_level->GetLargestPossibleRegion() );
-
-    auto multiplyUpsampleCorrection = MultiplyFilterType::New();
-    multiplyUpsampleCorrection->SetInput1(expandFilter->GetOutput());
-    auto expUpsampleCorrection = static_cast< double >(ImageDimension);
-    multiplyUpsampleCorrection->SetConstant(std::pow(scaleFactor, expUpsampleCorrection));
-    multiplyUpsampleCorrection->InPlaceOn();
-    multiplyUpsampleCorrection->Update();
-    low_pass_per_level = multiplyUpsampleCorrection->GetOutput();
+    // Multiplied by the upsample correction and the low-pass filter bank of the level.
+    const double upsampleCorrection = std::pow(scaleFactor, static_cast< double >(ImageDimension));
+    const bool fusedExpand =
+      this->UseFrequencyExpandImageFilter(low_pass_per_level->GetLargestPossibleRegion().GetSize());
+    typename InputImageType::SizeType levelSize = low_pass_per_level->GetLargestPossibleRegion().GetSize();
+    if ( fusedExpand )
+      {
+      for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
+        {
+        levelSize[dim] *= static_cast< SizeValueType >(this->m_ScaleFactors[dim]);
+        }
+      }
+    else
+      {
+      InputImagePointer expandedLowPass;
+      if ( this->m_HalfHermitian )
+        {
+        using HalfHermitianExpandFilterType = itk::FrequencyExpandImageFilter< InputImageType >;
+        auto expandFilter = HalfHermitianExpandFilterType::New();
+        expandFilter->SetInput(low_pass_per_level);
+        expandFilter->SetExpandFactors(this->m_ScaleFactors);
+        expandFilter->HalfHermitianOn();
+        expandFilter->SetActualXDimensionIsOdd(actualXDimensionIsOdd);
+        expandFilter->Update();
+        actualXDimensionIsOdd = expandFilter->GetOutputActualXDimensionIsOdd();
+        expandedLowPass = expandFilter->GetOutput();
+        }
+      else
+        {
+        typename ExpandFilterBaseType::Pointer expandFilter = this->MakeExpandFilter();
+        expandFilter->SetInput(low_pass_per_level);
+        expandFilter->Update();
+        expandedLowPass = expandFilter->GetOutput();
+        }
+      itkDebugMacro(<< "Low_pass_per_level: " << level
+                    << " Region:" << low_pass_per_level->GetLargestPossibleRegion() );
+
+      auto multiplyUpsampleCorrection = MultiplyFilterType::New();
+      multiplyUpsampleCorrection->SetInput1(expandedLowPass);
+      multiplyUpsampleCorrection->SetConstant(upsampleCorrection);
+      multiplyUpsampleCorrection->InPlaceOn();
+      multiplyUpsampleCorrection->Update();
+      low_pass_per_level = multiplyUpsampleCorrection->GetOutput();
+      levelSize = low_pass_per_level->GetLargestPossibleRegion().GetSize();
+      }
 
     /******* Calculate FilterBank with the right size per level. *****/
     // Save the FilterBank vector created in the forward wavelet and load it here to save compute it again.
     // TODO perform regression test between two approaches.
 
-    InputImagePointer waveletLow;
+    FilterBankImagePointer waveletLow;
+    // Bank generated at the size of the level: [low, high bands...].
+    typename WaveletFilterBankCacheType::BankType bank;
     if ( !this->m_UseWaveletFilterBankPyramid )
       {
       this->m_WaveletFilterBank->SetHighPassSubBands(this->m_HighPassSubBands);
-      this->m_WaveletFilterBank->SetSize(low_pass_per_level->GetLargestPossibleRegion().GetSize() );
+      this->m_WaveletFilterBank->SetSize(levelSize);
       this->m_WaveletFilterBank->SetInverseBank(true);
-      this->m_WaveletFilterBank->Modified();
-      this->m_WaveletFilterBank->UpdateLargestPossibleRegion();
-      // this->m_WaveletFilterBank->Update();
-      waveletLow = this->m_WaveletFilterBank->GetOutputLowPass();
+      this->m_WaveletFilterBank->SetActualXDimensionIsOdd(actualXDimensionIsOdd);
+
+      typename WaveletFilterBankCacheType::KeyType cacheKey;
+      if ( cache )
+        {
+        cacheKey = WaveletFilterBankCacheType::MakeKey(this->m_WaveletFilterBank.GetPointer(), levelSize, 0);
+        }
+      if ( !cache || !cache->Find(cacheKey, bank) )
+        {
+        this->m_WaveletFilterBank->Modified();
+        this->m_WaveletFilterBank->UpdateLargestPossibleRegion();
+        // this->m_WaveletFilterBank->Update();
+        bank = this->m_WaveletFilterBank->GetOutputsAll();
+        if ( cache )
+          {
+          // Detach the outputs, the generator would overwrite them in next updates.
+          for ( auto & bankImage : bank )
+            {
+            bankImage->DisconnectPipeline();
+            }
+          cache->Insert(cacheKey, bank);
+          }
+        }
+      waveletLow = bank[0];
       }
     else
       {
@@ -385,30 +539,36 @@ WaveletFrequencyInverse< TInputImage, TOutputImage,
       }
     itkDebugMacro(<< "waveletLow: " << level << " Region:" << waveletLow->GetLargestPossibleRegion() );
 
-    using ChangeInformationFilterType = itk::ChangeInformationImageFilter< InputImageType >;
-    auto changeWaveletInfoFilter = ChangeInformationFilterType::New();
-    // changeWaveletInfoFilter->SetInput(upsampleFilter->GetOutput());
-    changeWaveletInfoFilter->SetInput(waveletLow);
-    changeWaveletInfoFilter->UseReferenceImageOn();
-    changeWaveletInfoFilter->SetReferenceImage( low_pass_per_level );
-    changeWaveletInfoFilter->ChangeDirectionOff();
-    changeWaveletInfoFilter->ChangeRegionOn();
-    changeWaveletInfoFilter->ChangeSpacingOn();
-    changeWaveletInfoFilter->ChangeOriginOn();
-    changeWaveletInfoFilter->Update();
-
     /******* LowPass band *****/
-    auto multiplyLowPass = MultiplyFilterType::New();
-    multiplyLowPass->SetInput1(changeWaveletInfoFilter->GetOutput());
-    multiplyLowPass->SetInput2(low_pass_per_level);
-    multiplyLowPass->Update();
-    low_pass_per_level = multiplyLowPass->GetOutput();
+    // The output takes the metadata of the coefficients, the filter bank only has to match the size.
+    using MultiplyFilterBankFilterType = itk::FrequencyFilterBankMultiplyImageFilter< InputImageType,
+      FilterBankImageType >;
+    if ( fusedExpand )
+      {
+      // Expand, correct and multiply by the low pass in one pass.
+      using ExpandMultiplyFilterType = itk::FrequencyExpandMultiplyImageFilter< InputImageType, FilterBankImageType >;
+      auto expandMultiplyLowPass = ExpandMultiplyFilterType::New();
+      expandMultiplyLowPass->SetInput(low_pass_per_level);
+      expandMultiplyLowPass->SetFilterBank(waveletLow);
+      expandMultiplyLowPass->SetExpandFactors(this->m_ScaleFactors);
+      expandMultiplyLowPass->SetScale(upsampleCorrection);
+      expandMultiplyLowPass->Update();
+      low_pass_per_level = expandMultiplyLowPass->GetOutput();
+      }
+    else
+      {
+      auto multiplyLowPass = MultiplyFilterBankFilterType::New();
+      multiplyLowPass->SetInput1(low_pass_per_level);
+      multiplyLowPass->SetInput2(waveletLow);
+      multiplyLowPass->Update();
+      low_pass_per_level = multiplyLowPass->GetOutput();
+      }
 
     /******* HighPass sub-bands *****/
-    InputsType highPassMasks;
+    FilterBankInputsType highPassMasks;
     if ( !this->m_UseWaveletFilterBankPyramid )
       {
-      highPassMasks = this->m_WaveletFilterBank->GetOutputsHighPassBands();
+      highPassMasks.assign(bank.begin() + 1, bank.end());
       }
     else
       {
@@ -418,86 +578,87 @@ WaveletFrequencyInverse< TInputImage, TOutputImage,
         this->m_WaveletFilterBankPyramid.begin()
         + this->m_HighPassSubBands + 1 + level * (1 + this->m_HighPassSubBands) );
       }
-    // Store HighBands steps into high_pass_reconstruction image:
-    InputImagePointer reconstructed = InputImageType::New();
-    reconstructed->SetRegions(low_pass_per_level->GetLargestPossibleRegion());
-    reconstructed->Allocate();
-    reconstructed->FillBuffer(0);
-    InputImagePointer bandInputImage;
+    /******* Add the high pass bands to the low pass in one pass. *****/
+    using BandAccumulateFilterType = itk::FrequencyBandAccumulateImageFilter< InputImageType, FilterBankImageType >;
+    auto accumulateFilter = BandAccumulateFilterType::New();
+    accumulateFilter->SetInput(low_pass_per_level);
+    accumulateFilter->SetNumberOfBands(this->m_HighPassSubBands);
     for ( unsigned int band = 0; band < this->m_HighPassSubBands; ++band )
       {
       unsigned int nInput = level * this->m_HighPassSubBands + band;
-      bandInputImage = const_cast< InputImageType * >(this->GetInput(nInput));
-      reconstructed->SetSpacing(bandInputImage->GetSpacing());
-      reconstructed->SetOrigin(bandInputImage->GetOrigin());
-
-      auto changeWaveletHighInfoFilter = ChangeInformationFilterType::New();
-      changeWaveletHighInfoFilter->SetInput(highPassMasks[band]);
-      changeWaveletHighInfoFilter->UseReferenceImageOn();
-      changeWaveletHighInfoFilter->SetReferenceImage( bandInputImage );
-      changeWaveletHighInfoFilter->ChangeDirectionOff();
-      changeWaveletHighInfoFilter->ChangeRegionOff();
-      changeWaveletHighInfoFilter->ChangeSpacingOn();
-      changeWaveletHighInfoFilter->ChangeOriginOn();
-      changeWaveletHighInfoFilter->UpdateLargestPossibleRegion();
-      highPassMasks[band] = changeWaveletHighInfoFilter->GetOutput();
-      highPassMasks[band]->DisconnectPipeline();
-
-      auto multiplyHighBandFilter = MultiplyFilterType::New();
-      multiplyHighBandFilter->SetInput1(highPassMasks[band]);
-      multiplyHighBandFilter->SetInput2(bandInputImage);
-      multiplyHighBandFilter->UpdateLargestPossibleRegion();
-
       /******* Band dilation factor for HighPass bands *****/
       //  2^(1/#bands) instead of Dyadic dilations.
-      auto multiplyByReconstructionBandFactor = MultiplyFilterType::New();
-      multiplyByReconstructionBandFactor->SetInput1(multiplyHighBandFilter->GetOutput());
       double expBandFactor = 0;
       if ( this->GetApplyReconstructionFactors() )
         {
         expBandFactor = ( static_cast< double >(level) - band / static_cast< double >(this->m_HighPassSubBands) )
           * ImageDimension / 2.0;
         }
-      multiplyByReconstructionBandFactor->SetConstant(std::pow(scaleFactor, expBandFactor));
-      multiplyByReconstructionBandFactor->InPlaceOn();
-      multiplyByReconstructionBandFactor->Update();
-
-      /******* Add high bands *****/
-      using AddFilterType = itk::AddImageFilter< InputImageType >;
-      auto addFilter = AddFilterType::New();
-      addFilter->SetInput1(reconstructed);
-      addFilter->SetInput2(multiplyByReconstructionBandFactor->GetOutput());
-      addFilter->InPlaceOn();
-      addFilter->Update();
-      reconstructed = addFilter->GetOutput();
-
-      this->UpdateProgress(static_cast< float >(m_TotalInputs - nInput - 1)
-        / static_cast< float >(m_TotalInputs));
+      accumulateFilter->SetBand(band, this->GetInput(nInput), highPassMasks[band],
+        std::pow(scaleFactor, expBandFactor));
       }
-
-    /******* Add low pass to the sum of high pass bands. *****/
-    using AddFilterType = itk::AddImageFilter< InputImageType >;
-    auto addHighAndLow = AddFilterType::New();
-    addHighAndLow->SetInput1(reconstructed.GetPointer()); // HighBands
-    // addHighAndLow->SetInput2(multiplyLowByReconstructLevelFactor->GetOutput());
-    addHighAndLow->SetInput2(low_pass_per_level);
-    addHighAndLow->InPlaceOn();
-    addHighAndLow->Update();
+    // The low pass of the level is a temporary of this filter.
+    accumulateFilter->InPlaceOn();
+    accumulateFilter->Update();
+    this->UpdateProgress(static_cast< float >(this->m_TotalInputs - ( level + 1 ) * this->m_HighPassSubBands)
+      / static_cast< float >(this->m_TotalInputs));
 
     if ( level == 0 /* Last level to compute */ ) // Graft Output
       {
-      using CastFilterType = itk::CastImageFilter< InputImageType, OutputImageType >;
-      auto castFilter = CastFilterType::New();
-      castFilter->SetInput(addHighAndLow->GetOutput());
-      castFilter->GraftOutput(this->GetOutput());
-      castFilter->Update();
-      this->GraftOutput(castFilter->GetOutput());
+      // No copy when the input and output image types match.
+      this->GraftOutput(itk::utils::ShareOrCastImage< InputImageType, OutputImageType >(
+        accumulateFilter->GetOutput()));
       }
     else // Update low_pass
       {
-      low_pass_per_level = addHighAndLow->GetOutput();
+      low_pass_per_level = accumulateFilter->GetOutput();
       }
     }
 }
+
+template< typename TInputImage,
+  typename TOutputImage,
+  typename TWaveletFilterBank,
+  typename TFrequencyExpandFilterType >
+bool
+WaveletFrequencyInverse< TInputImage, TOutputImage,
+  TWaveletFilterBank, TFrequencyExpandFilterType >
+::UseFrequencyExpandImageFilter(const typename InputImageType::SizeType & inputSize)
+{
+  if ( this->m_HalfHermitian )
+    {
+    return false;
+    }
+  if ( !this->m_AutoSelectExpandFilter )
+    {
+    return std::is_same< FrequencyExpandFilterType, FrequencyExpandImageFilter< InputImageType > >::value;
+    }
+  if ( !this->m_FrequencyResamplingSelector )
+    {
+    this->m_FrequencyResamplingSelector = FrequencyResamplingSelectorType::GetInstance();
+    }
+  return this->m_FrequencyResamplingSelector->SelectExpandMethod(inputSize, this->m_ScaleFactors,
+    this->GetNumberOfWorkUnits()) == FrequencyResamplingSelectorType::MethodType::Frequency;
+}
+
+template< typename TInputImage,
+  typename TOutputImage,
+  typename TWaveletFilterBank,
+  typename TFrequencyExpandFilterType >
+typename WaveletFrequencyInverse< TInputImage, TOutputImage,
+  TWaveletFilterBank, TFrequencyExpandFilterType >::ExpandFilterBaseType::Pointer
+WaveletFrequencyInverse< TInputImage, TOutputImage,
+  TWaveletFilterBank, TFrequencyExpandFilterType >
+::MakeExpandFilter() const
+{
+  if ( this->m_AutoSelectExpandFilter )
+    {
+    return FrequencyResamplingSelectorType::MakeExpandFilter(
+      FrequencyResamplingSelectorType::MethodType::ViaInverseFFT, this->m_ScaleFactors);
+    }
+  auto expandFilter = FrequencyExpandFilterType::New();
+  expandFilter->SetExpandFactors(this->m_ScaleFactors);
+  return expandFilter.GetPointer();
+}
 } // end namespace itk
 #endif
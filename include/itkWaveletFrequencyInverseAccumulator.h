@@ -0,0 +1,183 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWaveletFrequencyInverseAccumulator_h
+#define itkWaveletFrequencyInverseAccumulator_h
+
+#include <itkObject.h>
+#include <itkObjectFactory.h>
+#include <itkFixedArray.h>
+#include <itkWaveletFilterBankCache.h>
+#include <vector>
+
+namespace itk
+{
+/** \class WaveletFrequencyInverseAccumulator
+ * \brief Incremental inverse wavelet transform: the bands are added one at a time, in any order.
+ *
+ * Equivalent to WaveletFrequencyInverse without the complete vector of inputs.
+ * Each band added with AddBand is multiplied by its filter bank and reconstruction factor, and folded
+ * into the accumulator of its level. No reference to the band is kept: it can be released as soon as
+ * AddBand returns, so the modified coefficients never have to be all resident at once.
+ * Finalize expands the low pass through the levels, adding the accumulators, and returns the reconstruction.
+ *
+ * The inputs follow the order of the outputs of WaveletFrequencyForward: the band b of the level l
+ * is the input l * HighPassSubBands + b, and the low pass the last one \sa AddInput.
+ * The filter bank of each level is generated when its first band is added, at the size of the band.
+ * The half-hermitian layout is not supported.
+ *
+ * \code
+ * accumulator->SetLevels(levels);
+ * accumulator->SetHighPassSubBands(bands);
+ * for ( unsigned int n = 0; n < forward->GetNumberOfOutputs(); ++n )
+ *   {
+ *   accumulator->AddInput(n, ModifyBand(forward->GetOutput(n)));
+ *   }
+ * ImageType::Pointer reconstruction = accumulator->Finalize();
+ * \endcode
+ *
+ * \sa WaveletFrequencyInverse
+ * \sa FrequencyBandAccumulateImageFilter
+ * \ingroup IsotropicWavelets
+ */
+template< typename TImageType, typename TWaveletFilterBank >
+class WaveletFrequencyInverseAccumulator:
+  public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(WaveletFrequencyInverseAccumulator);
+
+  /** Standard type alias */
+  using Self = WaveletFrequencyInverseAccumulator;
+  using Superclass = Object;
+  using Pointer = SmartPointer< Self >;
+  using ConstPointer = SmartPointer< const Self >;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(WaveletFrequencyInverseAccumulator, Object);
+
+  using ImageType = TImageType;
+  using ImagePointer = typename ImageType::Pointer;
+  static constexpr unsigned int ImageDimension = ImageType::ImageDimension;
+
+  using WaveletFilterBankType = TWaveletFilterBank;
+  using FilterBankImageType = typename WaveletFilterBankType::OutputImageType;
+  using FilterBankImagePointer = typename FilterBankImageType::Pointer;
+  using FilterBankInputsType = std::vector< FilterBankImagePointer >;
+  using WaveletFilterBankCacheType = WaveletFilterBankCache< FilterBankImageType >;
+  using ScaleFactorsType = FixedArray< unsigned int, ImageDimension >;
+
+  /** Number of levels/scales, 1 minimum: throws if 0. Changing it discards the added bands. */
+  void SetLevels(unsigned int levels);
+  itkGetConstMacro(Levels, unsigned int);
+
+  /** Number of high pass subbands, 1 minimum. Changing it discards the added bands. */
+  void SetHighPassSubBands(unsigned int bands);
+  itkGetConstMacro(HighPassSubBands, unsigned int);
+
+  /** Expand factor of each axis between consecutive levels, 2 (dyadic) by default.
+   * Has to be equal to the ScaleFactors of the \sa WaveletFrequencyForward that generated the bands.
+   * Only factors of 1 and 2 are accepted, SetScaleFactors throws otherwise. */
+  virtual void SetScaleFactors(const ScaleFactorsType & factors);
+  itkGetConstReferenceMacro(ScaleFactors, ScaleFactorsType);
+  /** Set the same scale factor for all the axes. */
+  virtual void SetScaleFactor(unsigned int factor);
+
+  /** If On, applies to each band the appropiate Level-Band multiplicative factor, On by default.
+   * \sa WaveletFrequencyInverse::ApplyReconstructionFactors */
+  itkGetConstReferenceMacro(ApplyReconstructionFactors, bool);
+  itkSetMacro(ApplyReconstructionFactors, bool);
+  itkBooleanMacro(ApplyReconstructionFactors);
+
+  /** Generator of the filter banks. Modify its wavelet function before adding the first band. */
+  itkGetModifiableObjectMacro(WaveletFilterBank, WaveletFilterBankType);
+
+  /** Flag to reuse the filter banks of previous runs with the same size and wavelet parameters.
+   * \sa WaveletFrequencyInverse::UseWaveletFilterBankCache */
+  itkGetConstReferenceMacro(UseWaveletFilterBankCache, bool);
+  itkSetMacro(UseWaveletFilterBankCache, bool);
+  itkBooleanMacro(UseWaveletFilterBankCache);
+
+  itkSetObjectMacro(WaveletFilterBankCache, WaveletFilterBankCacheType);
+  itkGetModifiableObjectMacro(WaveletFilterBankCache, WaveletFilterBankCacheType);
+
+  /** Fold the coefficients of a band into the accumulator of its level.
+   * Throws if the band was already added, or if its size differs from the other bands of the level. */
+  void AddBand(unsigned int level, unsigned int band, const ImageType * coefficients);
+
+  /** Set the low pass, the approximation of the last level. */
+  void SetLowPass(const ImageType * lowPass);
+
+  /** Add the input nInput of WaveletFrequencyInverse: a band, or the low pass if it is the last one. */
+  void AddInput(unsigned int nInput, const ImageType * image);
+
+  /** Number of inputs of the transform: Levels * HighPassSubBands + 1. */
+  unsigned int GetTotalInputs() const
+    {
+    return this->m_Levels * this->m_HighPassSubBands + 1;
+    }
+
+  /** Number of bands and low pass still to be added before Finalize. */
+  unsigned int GetNumberOfPendingInputs() const;
+
+  /** Reconstruct the image from the added bands and the low pass, and discard them.
+   * Throws if any input is pending. */
+  ImagePointer Finalize();
+
+  /** Discard the added bands and the low pass. */
+  void Clear();
+
+protected:
+  WaveletFrequencyInverseAccumulator();
+  ~WaveletFrequencyInverseAccumulator() override {}
+  void PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  struct LevelType
+  {
+    /** Sum of the bands multiplied by their filter bank and factor, with the information of the bands. */
+    ImagePointer           Accumulator;
+    FilterBankImagePointer LowPassFilterBank;
+    /** Released when all the bands of the level are added. */
+    FilterBankInputsType   HighPassFilterBanks;
+    std::vector< bool >    AddedBands;
+    unsigned int           NumberOfAddedBands{ 0 };
+  };
+
+  /** Generate or find in the cache the filter bank of a level of the given size. */
+  void InitializeLevel(LevelType & levelAccumulator, const typename ImageType::SizeType & size);
+
+  unsigned int             m_Levels;
+  unsigned int             m_HighPassSubBands;
+  ScaleFactorsType         m_ScaleFactors;
+  bool                     m_ApplyReconstructionFactors;
+  typename WaveletFilterBankType::Pointer m_WaveletFilterBank;
+  bool                     m_UseWaveletFilterBankCache;
+  typename WaveletFilterBankCacheType::Pointer m_WaveletFilterBankCache;
+  std::vector< LevelType > m_LevelAccumulators;
+  typename ImageType::ConstPointer m_LowPass;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkWaveletFrequencyInverseAccumulator.hxx"
+#endif
+
+#endif
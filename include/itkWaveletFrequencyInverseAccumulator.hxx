@@ -0,0 +1,324 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWaveletFrequencyInverseAccumulator_hxx
+#define itkWaveletFrequencyInverseAccumulator_hxx
+
+#include "itkWaveletFrequencyInverseAccumulator.h"
+#include "itkFrequencyBandAccumulateImageFilter.h"
+#include "itkFrequencyExpandMultiplyImageFilter.h"
+#include <itkAddImageFilter.h>
+#include <itkNumericTraits.h>
+#include <itkWaveletUtilities.h>
+#include <cmath>
+
+namespace itk
+{
+template< typename TImageType, typename TWaveletFilterBank >
+WaveletFrequencyInverseAccumulator< TImageType, TWaveletFilterBank >
+::WaveletFrequencyInverseAccumulator()
+  : m_Levels(1),
+  m_HighPassSubBands(1),
+  m_ApplyReconstructionFactors(true),
+  m_UseWaveletFilterBankCache(false)
+{
+  this->m_ScaleFactors.Fill(2);
+  this->m_WaveletFilterBank = WaveletFilterBankType::New();
+  this->Clear();
+}
+
+template< typename TImageType, typename TWaveletFilterBank >
+void
+WaveletFrequencyInverseAccumulator< TImageType, TWaveletFilterBank >
+::SetLevels(unsigned int levels)
+{
+  // Without levels there is nothing to expand the low pass into, \sa Finalize.
+  if ( levels == 0 )
+    {
+    itkExceptionMacro(<< "The number of levels has to be at least 1.");
+    }
+  if ( this->m_Levels == levels )
+    {
+    return;
+    }
+  this->m_Levels = levels;
+  this->Clear();
+  this->Modified();
+}
+
+template< typename TImageType, typename TWaveletFilterBank >
+void
+WaveletFrequencyInverseAccumulator< TImageType, TWaveletFilterBank >
+::SetHighPassSubBands(unsigned int bands)
+{
+  const unsigned int clampedBands = bands < 1 ? 1 : bands;
+  if ( this->m_HighPassSubBands == clampedBands )
+    {
+    return;
+    }
+  this->m_HighPassSubBands = clampedBands;
+  this->Clear();
+  this->Modified();
+}
+
+template< typename TImageType, typename TWaveletFilterBank >
+void
+WaveletFrequencyInverseAccumulator< TImageType, TWaveletFilterBank >
+::SetScaleFactor(unsigned int factor)
+{
+  ScaleFactorsType scaleFactors;
+  scaleFactors.Fill(factor < 1 ? 1 : factor);
+  this->SetScaleFactors(scaleFactors);
+}
+
+template< typename TImageType, typename TWaveletFilterBank >
+void
+WaveletFrequencyInverseAccumulator< TImageType, TWaveletFilterBank >
+::SetScaleFactors(const ScaleFactorsType & factors)
+{
+  if ( !itk::utils::AreWaveletScaleFactorsSupported(factors) )
+    {
+    itkExceptionMacro(<< "ScaleFactors " << factors << " not supported, only 1 and 2:"
+                      << " larger factors alias the low-pass band of the wavelet.");
+    }
+  if ( this->m_ScaleFactors != factors )
+    {
+    this->m_ScaleFactors = factors;
+    this->Modified();
+    }
+}
+
+template< typename TImageType, typename TWaveletFilterBank >
+void
+WaveletFrequencyInverseAccumulator< TImageType, TWaveletFilterBank >
+::Clear()
+{
+  this->m_LevelAccumulators.clear();
+  this->m_LevelAccumulators.resize(this->m_Levels);
+  for ( auto & levelAccumulator : this->m_LevelAccumulators )
+    {
+    levelAccumulator.AddedBands.assign(this->m_HighPassSubBands, false);
+    }
+  this->m_LowPass = nullptr;
+}
+
+template< typename TImageType, typename TWaveletFilterBank >
+void
+WaveletFrequencyInverseAccumulator< TImageType, TWaveletFilterBank >
+::InitializeLevel(LevelType & levelAccumulator, const typename ImageType::SizeType & size)
+{
+  this->m_WaveletFilterBank->SetHighPassSubBands(this->m_HighPassSubBands);
+  this->m_WaveletFilterBank->SetSize(size);
+  this->m_WaveletFilterBank->SetInverseBank(true);
+
+  typename WaveletFilterBankCacheType::Pointer cache;
+  if ( this->m_UseWaveletFilterBankCache )
+    {
+    cache = this->m_WaveletFilterBankCache ?
+      this->m_WaveletFilterBankCache : WaveletFilterBankCacheType::GetInstance();
+    }
+  typename WaveletFilterBankCacheType::BankType bank;
+  typename WaveletFilterBankCacheType::KeyType cacheKey;
+  if ( cache )
+    {
+    cacheKey = WaveletFilterBankCacheType::MakeKey(this->m_WaveletFilterBank.GetPointer(), size, 0);
+    }
+  if ( !cache || !cache->Find(cacheKey, bank) )
+    {
+    this->m_WaveletFilterBank->Modified();
+    this->m_WaveletFilterBank->UpdateLargestPossibleRegion();
+    bank = this->m_WaveletFilterBank->GetOutputsAll();
+    // Detach the outputs, the generator overwrites them when generating the bank of other levels.
+    for ( auto & bankImage : bank )
+      {
+      bankImage->DisconnectPipeline();
+      }
+    if ( cache )
+      {
+      cache->Insert(cacheKey, bank);
+      }
+    }
+  levelAccumulator.LowPassFilterBank = bank[0];
+  levelAccumulator.HighPassFilterBanks.assign(bank.begin() + 1, bank.end());
+}
+
+template< typename TImageType, typename TWaveletFilterBank >
+void
+WaveletFrequencyInverseAccumulator< TImageType, TWaveletFilterBank >
+::AddBand(unsigned int level, unsigned int band, const ImageType * coefficients)
+{
+  if ( level >= this->m_Levels || band >= this->m_HighPassSubBands )
+    {
+    itkExceptionMacro(<< "Level " << level << " band " << band << " out of range. Levels: " << this->m_Levels
+                      << ", HighPassSubBands: " << this->m_HighPassSubBands);
+    }
+  if ( !coefficients )
+    {
+    itkExceptionMacro(<< "Null coefficients for level " << level << " band " << band);
+    }
+  LevelType & levelAccumulator = this->m_LevelAccumulators[level];
+  if ( levelAccumulator.AddedBands[band] )
+    {
+    itkExceptionMacro(<< "Level " << level << " band " << band << " has already been added.");
+    }
+
+  if ( !levelAccumulator.Accumulator )
+    {
+    this->InitializeLevel(levelAccumulator, coefficients->GetLargestPossibleRegion().GetSize());
+    levelAccumulator.Accumulator = ImageType::New();
+    levelAccumulator.Accumulator->CopyInformation(coefficients);
+    levelAccumulator.Accumulator->SetRegions(coefficients->GetLargestPossibleRegion());
+    levelAccumulator.Accumulator->Allocate();
+    levelAccumulator.Accumulator->FillBuffer(NumericTraits< typename ImageType::PixelType >::ZeroValue());
+    }
+
+  /******* Band dilation factor for HighPass bands *****/
+  //  2^(1/#bands) instead of Dyadic dilations.
+  double expBandFactor = 0;
+  if ( this->m_ApplyReconstructionFactors )
+    {
+    expBandFactor = ( static_cast< double >(level) - band / static_cast< double >(this->m_HighPassSubBands) )
+      * ImageDimension / 2.0;
+    }
+  const double scaleFactor = itk::utils::ComputeMeanScaleFactor(this->m_ScaleFactors);
+
+  // Checks that the size matches the other bands of the level.
+  using BandAccumulateFilterType = FrequencyBandAccumulateImageFilter< ImageType, FilterBankImageType >;
+  auto accumulateFilter = BandAccumulateFilterType::New();
+  accumulateFilter->SetInput(levelAccumulator.Accumulator);
+  accumulateFilter->SetNumberOfBands(1);
+  accumulateFilter->SetBand(0, coefficients, levelAccumulator.HighPassFilterBanks[band],
+    std::pow(scaleFactor, expBandFactor));
+  accumulateFilter->InPlaceOn();
+  accumulateFilter->Update();
+  levelAccumulator.Accumulator = accumulateFilter->GetOutput();
+  levelAccumulator.Accumulator->DisconnectPipeline();
+
+  levelAccumulator.AddedBands[band] = true;
+  if ( ++levelAccumulator.NumberOfAddedBands == this->m_HighPassSubBands )
+    {
+    levelAccumulator.HighPassFilterBanks.clear();
+    }
+}
+
+template< typename TImageType, typename TWaveletFilterBank >
+void
+WaveletFrequencyInverseAccumulator< TImageType, TWaveletFilterBank >
+::SetLowPass(const ImageType * lowPass)
+{
+  if ( this->m_LowPass )
+    {
+    itkExceptionMacro(<< "The low pass has already been added.");
+    }
+  this->m_LowPass = lowPass;
+}
+
+template< typename TImageType, typename TWaveletFilterBank >
+void
+WaveletFrequencyInverseAccumulator< TImageType, TWaveletFilterBank >
+::AddInput(unsigned int nInput, const ImageType * image)
+{
+  if ( nInput == this->GetTotalInputs() - 1 )
+    {
+    this->SetLowPass(image);
+    }
+  else if ( nInput < this->GetTotalInputs() - 1 )
+    {
+    this->AddBand(nInput / this->m_HighPassSubBands, nInput % this->m_HighPassSubBands, image);
+    }
+  else
+    {
+    itkExceptionMacro(<< "Input " << nInput << " out of range. TotalInputs: " << this->GetTotalInputs());
+    }
+}
+
+template< typename TImageType, typename TWaveletFilterBank >
+unsigned int
+WaveletFrequencyInverseAccumulator< TImageType, TWaveletFilterBank >
+::GetNumberOfPendingInputs() const
+{
+  unsigned int pendingInputs = this->m_LowPass ? 0 : 1;
+  for ( const auto & levelAccumulator : this->m_LevelAccumulators )
+    {
+    pendingInputs += this->m_HighPassSubBands - levelAccumulator.NumberOfAddedBands;
+    }
+  return pendingInputs;
+}
+
+template< typename TImageType, typename TWaveletFilterBank >
+typename WaveletFrequencyInverseAccumulator< TImageType, TWaveletFilterBank >::ImagePointer
+WaveletFrequencyInverseAccumulator< TImageType, TWaveletFilterBank >
+::Finalize()
+{
+  const unsigned int pendingInputs = this->GetNumberOfPendingInputs();
+  if ( pendingInputs > 0 )
+    {
+    itkExceptionMacro(<< pendingInputs << " inputs have not been added.");
+    }
+
+  // Normalization of the upsampling, as in WaveletFrequencyInverse.
+  const double scaleFactor = itk::utils::ComputeMeanScaleFactor(this->m_ScaleFactors);
+  const double upsampleCorrection = std::pow(scaleFactor, static_cast< double >(ImageDimension));
+  using ExpandMultiplyFilterType = FrequencyExpandMultiplyImageFilter< ImageType, FilterBankImageType >;
+  using AddFilterType = AddImageFilter< ImageType >;
+
+  typename ImageType::ConstPointer lowPassPerLevel = this->m_LowPass;
+  ImagePointer reconstructed;
+  for ( int level = this->m_Levels - 1; level > -1; --level )
+    {
+    LevelType & levelAccumulator = this->m_LevelAccumulators[level];
+    // Expand, correct and multiply by the low pass in one pass.
+    auto expandMultiplyLowPass = ExpandMultiplyFilterType::New();
+    expandMultiplyLowPass->SetInput(lowPassPerLevel);
+    expandMultiplyLowPass->SetFilterBank(levelAccumulator.LowPassFilterBank);
+    expandMultiplyLowPass->SetExpandFactors(this->m_ScaleFactors);
+    expandMultiplyLowPass->SetScale(upsampleCorrection);
+
+    /******* Add low pass to the sum of high pass bands. *****/
+    auto addHighAndLow = AddFilterType::New();
+    addHighAndLow->SetInput1(levelAccumulator.Accumulator);
+    addHighAndLow->SetInput2(expandMultiplyLowPass->GetOutput());
+    addHighAndLow->InPlaceOn();
+    addHighAndLow->Update();
+    reconstructed = addHighAndLow->GetOutput();
+    reconstructed->DisconnectPipeline();
+    lowPassPerLevel = reconstructed.GetPointer();
+
+    // Release the level.
+    levelAccumulator = LevelType();
+    }
+  this->Clear();
+  return reconstructed;
+}
+
+template< typename TImageType, typename TWaveletFilterBank >
+void
+WaveletFrequencyInverseAccumulator< TImageType, TWaveletFilterBank >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Levels: " << this->m_Levels << std::endl;
+  os << indent << "HighPassSubBands: " << this->m_HighPassSubBands << std::endl;
+  os << indent << "ScaleFactors: " << this->m_ScaleFactors << std::endl;
+  os << indent << "ApplyReconstructionFactors: " << this->m_ApplyReconstructionFactors << std::endl;
+  os << indent << "UseWaveletFilterBankCache: " << this->m_UseWaveletFilterBankCache << std::endl;
+  os << indent << "NumberOfPendingInputs: " << this->GetNumberOfPendingInputs() << std::endl;
+  itkPrintSelfObjectMacro(WaveletFilterBank);
+}
+} // end namespace itk
+
+#endif
@@ -18,13 +18,10 @@
 #ifndef itkWaveletFrequencyInverseUndecimated_hxx
 #define itkWaveletFrequencyInverseUndecimated_hxx
 #include <itkWaveletFrequencyInverseUndecimated.h>
-#include <itkCastImageFilter.h>
 #include <itkImage.h>
 #include <algorithm>
 #include <itkMultiplyImageFilter.h>
-#include <itkAddImageFilter.h>
-#include <itkImageDuplicator.h>
-#include <itkChangeInformationImageFilter.h>
+#include <itkFrequencyBandAccumulateImageFilter.h>
 #include <itkWaveletUtilities.h>
 namespace itk
 {
@@ -279,15 +276,12 @@ WaveletFrequencyInverseUndecimated< TInputImage, TOutputImage,
   TWaveletFilterBank >
 ::GenerateData()
 {
-  this->AllocateOutputs();
+  // The output is not allocated, it is grafted from the reconstruction of the last level.
   // Start with the approximation image (the smallest).
   InputImageConstPointer low_pass = this->GetInput(this->m_TotalInputs - 1);
 
-  using DuplicatorType = itk::ImageDuplicator< InputImageType >;
-  auto duplicator = DuplicatorType::New();
-  duplicator->SetInputImage(low_pass);
-  duplicator->Update();
-  InputImagePointer low_pass_per_level = duplicator->GetOutput();
+  // The low pass input is only read: share its pixels instead of duplicating them.
+  InputImagePointer low_pass_per_level = itk::utils::ShareOrCastImage< InputImageType, InputImageType >(low_pass);
 
   using MultiplyFilterType = itk::MultiplyImageFilter< InputImageType >;
   auto scaleFactor = static_cast< double >(this->m_ScaleFactor);
@@ -315,12 +309,13 @@ WaveletFrequencyInverseUndecimated< TInputImage, TOutputImage,
       waveletLow = this->m_WaveletFilterBankPyramid[level * (1 + this->m_HighPassSubBands)];
       }
     itkDebugMacro(<< "waveletLow: " << level << " Region:" << waveletLow->GetLargestPossibleRegion() );
-    using ChangeInformationFilterType = itk::ChangeInformationImageFilter< InputImageType >;
 
     /******* LowPass band *****/
     auto multiplyLowPass = MultiplyFilterType::New();
     multiplyLowPass->SetInput1(waveletLow);
     multiplyLowPass->SetInput2(low_pass_per_level);
+    // The filter bank and, in the first level, the low pass input are read-only.
+    multiplyLowPass->InPlaceOff();
     multiplyLowPass->Update();
 
     low_pass_per_level = multiplyLowPass->GetOutput();
@@ -339,95 +334,48 @@ WaveletFrequencyInverseUndecimated< TInputImage, TOutputImage,
         this->m_WaveletFilterBankPyramid.begin()
         + this->m_HighPassSubBands + 1 + level * (1 + this->m_HighPassSubBands) );
       }
-    // Store HighBands steps into high_pass_reconstruction image:
-    InputImagePointer reconstructed = InputImageType::New();
-    reconstructed->SetRegions(low_pass_per_level->GetLargestPossibleRegion());
-    reconstructed->Allocate();
-    reconstructed->FillBuffer(0);
-    InputImagePointer bandInputImage;
+    /******* Add the high pass bands to the low pass in one pass. *****/
+    using BandAccumulateFilterType = itk::FrequencyBandAccumulateImageFilter< InputImageType >;
+    auto accumulateFilter = BandAccumulateFilterType::New();
+    accumulateFilter->SetInput(low_pass_per_level);
+    accumulateFilter->SetNumberOfBands(this->m_HighPassSubBands);
     for ( unsigned int band = 0; band < this->m_HighPassSubBands; ++band )
       {
       unsigned int nInput = level * this->m_HighPassSubBands + band;
-      bandInputImage = const_cast< InputImageType * >(this->GetInput(nInput));
-      reconstructed->SetSpacing(bandInputImage->GetSpacing());
-      reconstructed->SetOrigin(bandInputImage->GetOrigin());
-
-      auto changeWaveletHighInfoFilter = ChangeInformationFilterType::New();
-      changeWaveletHighInfoFilter->SetInput(highPassMasks[band]);
-      changeWaveletHighInfoFilter->UseReferenceImageOn();
-      changeWaveletHighInfoFilter->SetReferenceImage( bandInputImage );
-      changeWaveletHighInfoFilter->ChangeDirectionOff();
-      changeWaveletHighInfoFilter->ChangeRegionOff();
-      changeWaveletHighInfoFilter->ChangeSpacingOn();
-      changeWaveletHighInfoFilter->ChangeOriginOn();
-      changeWaveletHighInfoFilter->UpdateLargestPossibleRegion();
-      highPassMasks[band] = changeWaveletHighInfoFilter->GetOutput();
-      highPassMasks[band]->DisconnectPipeline();
-
-      auto multiplyHighBandFilter = MultiplyFilterType::New();
-      multiplyHighBandFilter->SetInput1(highPassMasks[band]);
-      multiplyHighBandFilter->SetInput2(bandInputImage);
-      multiplyHighBandFilter->UpdateLargestPossibleRegion();
-
       /******* Band dilation factor for HighPass bands *****/
       //  2^(1/#bands) instead of Dyadic dilations.
-      auto multiplyByReconstructionBandFactor = MultiplyFilterType::New();
-      multiplyByReconstructionBandFactor->SetInput1(multiplyHighBandFilter->GetOutput());
       double expBandFactor = 0;
       if ( this->GetApplyReconstructionFactors() )
         {
         expBandFactor = - ( band / static_cast< double >(this->m_HighPassSubBands) )
           * ImageDimension / 2.0;
         }
-      multiplyByReconstructionBandFactor->SetConstant(std::pow(scaleFactor, expBandFactor));
-      multiplyByReconstructionBandFactor->InPlaceOn();
-      multiplyByReconstructionBandFactor->Update();
-
-      /******* Add high bands *****/
-      using AddFilterType = itk::AddImageFilter< InputImageType >;
-      auto addFilter = AddFilterType::New();
-      addFilter->SetInput1(reconstructed);
-      addFilter->SetInput2(multiplyByReconstructionBandFactor->GetOutput());
-      addFilter->InPlaceOn();
-      addFilter->Update();
-      reconstructed = addFilter->GetOutput();
-
-      this->UpdateProgress(static_cast< float >(m_TotalInputs - nInput - 1)
-        / static_cast< float >(m_TotalInputs));
+      accumulateFilter->SetBand(band, this->GetInput(nInput), highPassMasks[band],
+        std::pow(scaleFactor, expBandFactor));
       }
 
-    /******* Add low pass to the sum of high pass bands. *****/
-    using AddFilterType = itk::AddImageFilter< InputImageType >;
-    auto addHighAndLow = AddFilterType::New();
-    addHighAndLow->SetInput1(reconstructed.GetPointer()); // HighBands
-    addHighAndLow->SetInput2(low_pass_per_level);
-    addHighAndLow->InPlaceOn();
-    addHighAndLow->Update();
-
     // Dilation factor for reconstructed by one level.
-    auto multiplyByLevelFactor = MultiplyFilterType::New();
-    multiplyByLevelFactor->SetInput1(addHighAndLow->GetOutput());
     double expLevelFactor = 0;
     if ( this->GetApplyReconstructionFactors() )
       {
-          expLevelFactor = static_cast< double >(ImageDimension ) / 2.0;
+      expLevelFactor = static_cast< double >(ImageDimension ) / 2.0;
       }
-    multiplyByLevelFactor->SetConstant(std::pow(scaleFactor, expLevelFactor));
-    multiplyByLevelFactor->InPlaceOn();
-    multiplyByLevelFactor->Update();
+    accumulateFilter->SetScale(std::pow(scaleFactor, expLevelFactor));
+    // The low pass of the level is a temporary of this filter.
+    accumulateFilter->InPlaceOn();
+    accumulateFilter->Update();
+    this->UpdateProgress(static_cast< float >(this->m_TotalInputs - ( level + 1 ) * this->m_HighPassSubBands)
+      / static_cast< float >(this->m_TotalInputs));
 
     if ( level == 0 /* Last level to compute */ ) // Graft Output
       {
-      using CastFilterType = itk::CastImageFilter< InputImageType, OutputImageType >;
-      auto castFilter = CastFilterType::New();
-      castFilter->SetInput(multiplyByLevelFactor->GetOutput());
-      castFilter->GraftOutput(this->GetOutput());
-      castFilter->Update();
-      this->GraftOutput(castFilter->GetOutput());
+      // No copy when the input and output image types match.
+      this->GraftOutput(itk::utils::ShareOrCastImage< InputImageType, OutputImageType >(
+        accumulateFilter->GetOutput()));
       }
     else // Update low_pass
       {
-      low_pass_per_level = multiplyByLevelFactor->GetOutput();
+      low_pass_per_level = accumulateFilter->GetOutput();
       }
     }
 }
@@ -0,0 +1,167 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWaveletFrequencyMultiplyImageFilter_h
+#define itkWaveletFrequencyMultiplyImageFilter_h
+
+#include <itkImageToImageFilter.h>
+#include <itkFrequencyFFTLayoutImageRegionIteratorWithIndex.h>
+#include <cmath>
+#include <vector>
+
+namespace itk
+{
+/** \class WaveletFrequencyMultiplyImageFilter
+ * \brief Multiply a frequency image by every sub-band of a wavelet filter bank,
+ * without generating the images of the filter bank.
+ *
+ * Output k is the input multiplied by the sub-band k of the wavelet, evaluated on the fly
+ * at each frequency bin, and by the constant BandFactors[k].
+ * Output 0 corresponds to the low-pass, output HighPassSubBands to the high-pass.
+ * All the outputs are computed in a single multi-threaded pass over the input.
+ *
+ * The wavelet is evaluated at the frequency of the bins normalized by the image spacing, i.e. index/size,
+ * matching a \sa WaveletFrequencyFilterBankGenerator of the same size with unit spacing.
+ *
+ * \sa WaveletFrequencyFilterBankGenerator
+ * \sa WaveletFrequencyForward
+ * \ingroup IsotropicWavelets
+ */
+template< typename TImage,
+  typename TWaveletFunction,
+  typename TFrequencyRegionIterator = FrequencyFFTLayoutImageRegionIteratorWithIndex< TImage > >
+class WaveletFrequencyMultiplyImageFilter:
+  public ImageToImageFilter< TImage, TImage >
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(WaveletFrequencyMultiplyImageFilter);
+
+  /** Standard class type alias. */
+  using Self = WaveletFrequencyMultiplyImageFilter;
+  using Superclass = ImageToImageFilter< TImage, TImage >;
+  using Pointer = SmartPointer< Self >;
+  using ConstPointer = SmartPointer< const Self >;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(WaveletFrequencyMultiplyImageFilter, ImageToImageFilter);
+
+  /** Inherit types from Superclass. */
+  using ImageType = TImage;
+  using ImagePointer = typename ImageType::Pointer;
+  using OutputImageRegionType = typename Superclass::OutputImageRegionType;
+  using FrequencyRegionIterator = TFrequencyRegionIterator;
+
+  /** WaveletFunction types */
+  using WaveletFunctionType = TWaveletFunction;
+  using WaveletFunctionPointer = typename WaveletFunctionType::Pointer;
+  using FunctionValueType = typename WaveletFunctionType::FunctionValueType;
+
+  /** Constant factor applied to each output, starting at the low-pass. */
+  using BandFactorsType = std::vector< double >;
+
+  static constexpr unsigned int ImageDimension = TImage::ImageDimension;
+
+  /** Number of M-Bands decomposition of the high pass filters */
+  itkGetConstMacro(HighPassSubBands, unsigned int);
+  void SetHighPassSubBands(unsigned int k);
+
+  /** Flag to use the inverse(reconstruction) filter bank instead
+   * of forward (analysis) */
+  itkGetConstMacro(InverseBank, bool);
+  itkSetMacro(InverseBank, bool);
+  itkBooleanMacro(InverseBank);
+
+  /** Level to scale the wavelet function. Used in undecimated wavelet.
+   * \sa WaveletFrequencyFilterBankGenerator::SetLevel */
+  itkGetConstMacro(Level, unsigned int);
+  virtual void SetLevel(const unsigned int & level)
+  {
+    this->m_Level = level;
+    this->m_LevelFactor = std::pow(static_cast< double >(this->m_ScaleFactor), static_cast< int >(level));
+    this->Modified();
+  }
+
+  /** Factors multiplying each output, size HighPassSubBands + 1.
+   * Empty (the default) is equivalent to all the factors equal to one. */
+  virtual void SetBandFactors(const BandFactorsType & bandFactors)
+  {
+    if ( this->m_BandFactors != bandFactors )
+      {
+      this->m_BandFactors = bandFactors;
+      this->Modified();
+      }
+  }
+  itkGetConstReferenceMacro(BandFactors, BandFactorsType);
+
+  /** Flag for frequency iterators with half-hermitian layout: the size in the x dimension
+   * of the full spectrum is odd. \sa WaveletFrequencyFilterBankGenerator::SetActualXDimensionIsOdd */
+  itkSetMacro(ActualXDimensionIsOdd, bool);
+  itkGetConstMacro(ActualXDimensionIsOdd, bool);
+  itkBooleanMacro(ActualXDimensionIsOdd);
+
+  /** Wavelet function, can be shared with a WaveletFrequencyFilterBankGenerator. */
+  itkSetObjectMacro(WaveletFunction, WaveletFunctionType);
+  itkGetModifiableObjectMacro(WaveletFunction, WaveletFunctionType);
+
+  /** Outputs */
+  ImageType * GetOutputLowPass()
+  {
+    return this->GetOutput(0);
+  }
+
+  ImageType * GetOutputSubBand(unsigned int k)
+  {
+    return this->GetOutput(k);
+  }
+
+#ifdef ITK_USE_CONCEPT_CHECKING
+  /// This ensure that PixelType is complex<float||double>
+  itkConceptMacro( PixelTypeIsComplexAndFloatCheck,
+                   ( Concept::IsFloatingPoint< typename ImageType::PixelType::value_type > ) );
+#endif
+
+protected:
+  WaveletFrequencyMultiplyImageFilter();
+  ~WaveletFrequencyMultiplyImageFilter() override {}
+  void PrintSelf(std::ostream & os, Indent indent) const override;
+
+  void BeforeThreadedGenerateData() override;
+
+  void DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+private:
+  unsigned int           m_HighPassSubBands;
+  bool                   m_InverseBank;
+  unsigned int           m_Level;
+  /** Default to 2 (Dyadic). No modifiable, but allow future extensions */
+  unsigned int           m_ScaleFactor;
+  /** m_ScaleFactor^m_Level */
+  double                 m_LevelFactor;
+  BandFactorsType        m_BandFactors;
+  bool                   m_ActualXDimensionIsOdd;
+  WaveletFunctionPointer m_WaveletFunction;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkWaveletFrequencyMultiplyImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,152 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWaveletFrequencyMultiplyImageFilter_hxx
+#define itkWaveletFrequencyMultiplyImageFilter_hxx
+
+#include "itkWaveletFrequencyMultiplyImageFilter.h"
+#include "itkWaveletUtilities.h"
+#include <itkImageRegionIterator.h>
+#include <itkImageRegionConstIterator.h>
+#include <cmath>
+
+namespace itk
+{
+template< typename TImage, typename TWaveletFunction, typename TFrequencyRegionIterator >
+WaveletFrequencyMultiplyImageFilter< TImage, TWaveletFunction, TFrequencyRegionIterator >
+::WaveletFrequencyMultiplyImageFilter()
+  : m_HighPassSubBands(0),
+  m_InverseBank(false),
+  m_Level(0),
+  m_ScaleFactor(2),
+  m_LevelFactor(1),
+  m_ActualXDimensionIsOdd(false)
+{
+  this->SetNumberOfRequiredInputs(1);
+  this->SetHighPassSubBands(1);
+  this->m_WaveletFunction = WaveletFunctionType::New();
+
+  this->DynamicMultiThreadingOn();
+}
+
+template< typename TImage, typename TWaveletFunction, typename TFrequencyRegionIterator >
+void
+WaveletFrequencyMultiplyImageFilter< TImage, TWaveletFunction, TFrequencyRegionIterator >
+::SetHighPassSubBands(unsigned int k)
+{
+  if ( this->m_HighPassSubBands == k )
+    {
+    return;
+    }
+
+  this->m_HighPassSubBands = k;
+  this->SetNumberOfRequiredOutputs(k + 1);
+  this->Modified();
+  for ( unsigned int band = 0; band < this->m_HighPassSubBands + 1; ++band )
+    {
+    this->SetNthOutput(band, this->MakeOutput(band));
+    }
+}
+
+template< typename TImage, typename TWaveletFunction, typename TFrequencyRegionIterator >
+void
+WaveletFrequencyMultiplyImageFilter< TImage, TWaveletFunction, TFrequencyRegionIterator >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "HighPassSubBands: " << this->m_HighPassSubBands << std::endl;
+  os << indent << "InverseBank: " << (this->m_InverseBank ? "true" : "false") << std::endl;
+  os << indent << "Level: " << this->m_Level << std::endl;
+  os << indent << "LevelFactor: " << this->m_LevelFactor << std::endl;
+  os << indent << "ActualXDimensionIsOdd: " << (this->m_ActualXDimensionIsOdd ? "true" : "false") << std::endl;
+  os << indent << "BandFactors: ";
+  for ( const auto & factor : this->m_BandFactors )
+    {
+    os << factor << " ";
+    }
+  os << std::endl;
+  itkPrintSelfObjectMacro(WaveletFunction);
+}
+
+template< typename TImage, typename TWaveletFunction, typename TFrequencyRegionIterator >
+void
+WaveletFrequencyMultiplyImageFilter< TImage, TWaveletFunction, TFrequencyRegionIterator >
+::BeforeThreadedGenerateData()
+{
+  if ( !this->m_BandFactors.empty() && this->m_BandFactors.size() != this->m_HighPassSubBands + 1 )
+    {
+    itkExceptionMacro(<< "BandFactors has size " << this->m_BandFactors.size()
+                      << ", but it should be empty or HighPassSubBands + 1: " << this->m_HighPassSubBands + 1);
+    }
+  // Modify the wavelet function before the threads start, evaluation is const.
+  this->m_WaveletFunction->SetHighPassSubBands(this->m_HighPassSubBands);
+}
+
+template< typename TImage, typename TWaveletFunction, typename TFrequencyRegionIterator >
+void
+WaveletFrequencyMultiplyImageFilter< TImage, TWaveletFunction, TFrequencyRegionIterator >
+::DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread)
+{
+  using PixelType = typename ImageType::PixelType;
+  using ValueType = typename PixelType::value_type;
+  const unsigned int numberOfBands = this->m_HighPassSubBands + 1;
+
+  std::vector< double > bandFactors(this->m_BandFactors);
+  if ( bandFactors.empty() )
+    {
+    bandFactors.assign(numberOfBands, 1.0);
+    }
+
+  std::vector< ImageRegionIterator< ImageType > > outputItList;
+  outputItList.reserve(numberOfBands);
+  for ( unsigned int band = 0; band < numberOfBands; ++band )
+    {
+    outputItList.emplace_back(this->GetOutput(band), outputRegionForThread);
+    outputItList.back().GoToBegin();
+    }
+
+  ImageRegionConstIterator< ImageType > inputIt(this->GetInput(), outputRegionForThread);
+  // Only used to compute the frequency of each bin.
+  FrequencyRegionIterator frequencyIt(this->GetOutput(0), outputRegionForThread);
+  itk::utils::SetActualXDimensionIsOdd(frequencyIt, this->m_ActualXDimensionIsOdd);
+  const typename ImageType::SpacingType & spacing = this->GetOutput(0)->GetSpacing();
+  for ( inputIt.GoToBegin(), frequencyIt.GoToBegin(); !inputIt.IsAtEnd(); ++inputIt, ++frequencyIt )
+    {
+    const typename FrequencyRegionIterator::FrequencyType frequency = frequencyIt.GetFrequency();
+    double frequencyModuloSquare = 0;
+    for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
+      {
+      const double normalizedFrequency = frequency[dim] * spacing[dim];
+      frequencyModuloSquare += normalizedFrequency * normalizedFrequency;
+      }
+    const auto w = static_cast< FunctionValueType >(this->m_LevelFactor * std::sqrt(frequencyModuloSquare));
+
+    const PixelType inputValue = inputIt.Get();
+    for ( unsigned int l = 0; l < numberOfBands; ++l )
+      {
+      const FunctionValueType evaluatedSubBand = this->m_InverseBank ?
+        this->m_WaveletFunction->EvaluateInverseSubBand(w, l) :
+        this->m_WaveletFunction->EvaluateForwardSubBand(w, l);
+      outputItList[l].Set(inputValue * static_cast< ValueType >(bandFactors[l] * evaluatedSubBand));
+      ++outputItList[l];
+      }
+    }
+}
+} // end namespace itk
+
+#endif
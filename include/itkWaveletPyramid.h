@@ -0,0 +1,175 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWaveletPyramid_h
+#define itkWaveletPyramid_h
+
+#include <itkObject.h>
+#include <itkObjectFactory.h>
+#include <itkImportImageContainer.h>
+#include <memory>
+#include <vector>
+
+namespace itk
+{
+/** \class WaveletPyramidPixelContainer
+ * \brief Pixel container of an image viewing a slice of the arena of a \sa WaveletPyramid.
+ *
+ * The container does not own the memory, but keeps the arena alive while the image exists.
+ * If the image is reallocated with a bigger size, the container allocates its own memory
+ * as any ImportImageContainer that does not manage its memory.
+ *
+ * \ingroup IsotropicWavelets
+ */
+template< typename TElementIdentifier, typename TElement >
+class WaveletPyramidPixelContainer:
+  public ImportImageContainer< TElementIdentifier, TElement >
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(WaveletPyramidPixelContainer);
+
+  /** Standard type alias */
+  using Self = WaveletPyramidPixelContainer;
+  using Superclass = ImportImageContainer< TElementIdentifier, TElement >;
+  using Pointer = SmartPointer< Self >;
+  using ConstPointer = SmartPointer< const Self >;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(WaveletPyramidPixelContainer, ImportImageContainer);
+
+  using ArenaType = std::shared_ptr< TElement >;
+
+  /** View size elements of arena starting at begin. */
+  void SetArenaSlice(const ArenaType & arena, TElement * begin, TElementIdentifier size)
+  {
+    this->m_Arena = arena;
+    this->SetImportPointer(begin, size, false);
+  }
+
+protected:
+  WaveletPyramidPixelContainer() = default;
+  ~WaveletPyramidPixelContainer() override = default;
+
+private:
+  ArenaType m_Arena;
+};
+
+/** \class WaveletPyramid
+ * \brief Contiguous storage for all the coefficient images of a wavelet pyramid.
+ *
+ * Allocate() reserves a single arena for all the regions, placed back to back
+ * and aligned to Alignment bytes, and creates one image per region viewing its slice
+ * (\sa WaveletPyramidPixelContainer).
+ * One allocation is done per pyramid, instead of one per level and band, and the
+ * memory is released at once when the last image viewing the arena is destroyed.
+ * Each call to Allocate creates a new arena, the images of previous calls stay valid.
+ *
+ * The pyramid also provides a pool of scratch buffers for the intermediate images
+ * of the transform: GetScratchImage(slot, region) returns an image reusing the
+ * buffer of the slot, which only grows when a bigger region is requested.
+ * Scratch images of the same slot share their buffer: only the last one is valid.
+ * GetScratchImage is not thread-safe, except for calls on different slots already
+ * created with ReserveScratchSlots, that concurrent tasks can use one slot each.
+ *
+ * \sa WaveletFrequencyForward
+ * \ingroup IsotropicWavelets
+ */
+template< typename TImage >
+class WaveletPyramid:
+  public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(WaveletPyramid);
+
+  /** Standard type alias */
+  using Self = WaveletPyramid;
+  using Superclass = Object;
+  using Pointer = SmartPointer< Self >;
+  using ConstPointer = SmartPointer< const Self >;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(WaveletPyramid, Object);
+
+  using ImageType = TImage;
+  using ImagePointer = typename ImageType::Pointer;
+  using PixelType = typename ImageType::PixelType;
+  using RegionType = typename ImageType::RegionType;
+  using RegionsType = std::vector< RegionType >;
+  using ImagesType = std::vector< ImagePointer >;
+  using PixelContainerType = WaveletPyramidPixelContainer< SizeValueType, PixelType >;
+  using ScratchContainerType = typename ImageType::PixelContainer;
+  using ScratchContainerPointer = typename ScratchContainerType::Pointer;
+
+  /** Alignment in bytes of the start of each image in the arena. */
+  static constexpr SizeValueType Alignment = 64;
+
+  /** Create a new arena for all the regions, and one image per region with that buffered region. */
+  void Allocate(const RegionsType & regions);
+
+  /** Number of images in the arena. */
+  unsigned int GetNumberOfImages() const
+  {
+    return static_cast< unsigned int >( this->m_Images.size() );
+  }
+
+  /** Image viewing the slice of the arena of region n. */
+  ImageType * GetImage(unsigned int n) const;
+
+  /** Number of pixels of the arena, including alignment padding. */
+  itkGetConstMacro(ArenaSize, SizeValueType);
+
+  /** Image with region as buffered region, reusing the buffer of slot.
+   * Slots not yet reserved are created, see ReserveScratchSlots for concurrent calls. */
+  ImagePointer GetScratchImage(unsigned int slot, const RegionType & region);
+
+  /** Create the slots below numberOfSlots, without allocating their buffers.
+   * Call it before using these slots from concurrent tasks. */
+  void ReserveScratchSlots(unsigned int numberOfSlots);
+
+  /** Number of scratch slots. */
+  unsigned int GetNumberOfScratchSlots() const
+  {
+    return static_cast< unsigned int >( this->m_ScratchContainers.size() );
+  }
+
+  /** Release the arena views and the scratch buffers. */
+  void Clear();
+
+protected:
+  WaveletPyramid();
+  ~WaveletPyramid() override {}
+  void PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  ImagesType                             m_Images;
+  SizeValueType                          m_ArenaSize;
+  std::vector< ScratchContainerPointer > m_ScratchContainers;
+  std::vector< SizeValueType >           m_ScratchCapacities;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkWaveletPyramid.hxx"
+#endif
+
+#endif
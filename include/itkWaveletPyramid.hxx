@@ -0,0 +1,143 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWaveletPyramid_hxx
+#define itkWaveletPyramid_hxx
+
+#include "itkWaveletPyramid.h"
+#include <cstdint>
+
+namespace itk
+{
+template< typename TImage >
+WaveletPyramid< TImage >
+::WaveletPyramid():
+  m_ArenaSize(0)
+{}
+
+template< typename TImage >
+void
+WaveletPyramid< TImage >
+::Allocate(const RegionsType & regions)
+{
+  // Start of each image rounded to the alignment, if the pixel size allows it.
+  const SizeValueType alignmentInPixels =
+    ( Alignment % sizeof( PixelType ) == 0 ) ? Alignment / sizeof( PixelType ) : 1;
+  std::vector< SizeValueType > offsets;
+  offsets.reserve(regions.size());
+  SizeValueType totalPixels = 0;
+  for ( const auto & region : regions )
+    {
+    offsets.push_back(totalPixels);
+    const SizeValueType numberOfPixels = region.GetNumberOfPixels();
+    totalPixels += ( ( numberOfPixels + alignmentInPixels - 1 ) / alignmentInPixels ) * alignmentInPixels;
+    }
+  // Extra pixels to align the start of the arena.
+  const SizeValueType arenaSize = totalPixels + alignmentInPixels;
+  typename PixelContainerType::ArenaType arena(new PixelType[arenaSize], std::default_delete< PixelType[] >());
+  PixelType * arenaBegin = arena.get();
+  const auto misalignment = static_cast< SizeValueType >( reinterpret_cast< std::uintptr_t >( arenaBegin ) % Alignment );
+  if ( misalignment != 0 && ( Alignment - misalignment ) % sizeof( PixelType ) == 0 )
+    {
+    arenaBegin += ( Alignment - misalignment ) / sizeof( PixelType );
+    }
+
+  this->m_Images.clear();
+  this->m_Images.reserve(regions.size());
+  for ( unsigned int n = 0; n < regions.size(); ++n )
+    {
+    auto container = PixelContainerType::New();
+    container->SetArenaSlice(arena, arenaBegin + offsets[n], regions[n].GetNumberOfPixels());
+    ImagePointer image = ImageType::New();
+    image->SetRegions(regions[n]);
+    image->SetPixelContainer(container);
+    this->m_Images.push_back(image);
+    }
+  this->m_ArenaSize = arenaSize;
+  this->Modified();
+}
+
+template< typename TImage >
+typename WaveletPyramid< TImage >::ImageType *
+WaveletPyramid< TImage >
+::GetImage(unsigned int n) const
+{
+  if ( n >= this->m_Images.size() )
+    {
+    itkExceptionMacro(<< "Image " << n << " requested, but the pyramid has " << this->m_Images.size() << " images.");
+    }
+  return this->m_Images[n].GetPointer();
+}
+
+template< typename TImage >
+typename WaveletPyramid< TImage >::ImagePointer
+WaveletPyramid< TImage >
+::GetScratchImage(unsigned int slot, const RegionType & region)
+{
+  this->ReserveScratchSlots(slot + 1);
+  const SizeValueType numberOfPixels = region.GetNumberOfPixels();
+  if ( !this->m_ScratchContainers[slot] || this->m_ScratchCapacities[slot] < numberOfPixels )
+    {
+    ScratchContainerPointer container = ScratchContainerType::New();
+    container->Reserve(numberOfPixels);
+    this->m_ScratchContainers[slot] = container;
+    this->m_ScratchCapacities[slot] = numberOfPixels;
+    }
+  ImagePointer image = ImageType::New();
+  image->SetRegions(region);
+  image->SetPixelContainer(this->m_ScratchContainers[slot]);
+  return image;
+}
+
+template< typename TImage >
+void
+WaveletPyramid< TImage >
+::ReserveScratchSlots(unsigned int numberOfSlots)
+{
+  if ( numberOfSlots > this->m_ScratchContainers.size() )
+    {
+    this->m_ScratchContainers.resize(numberOfSlots);
+    this->m_ScratchCapacities.resize(numberOfSlots, 0);
+    }
+}
+
+template< typename TImage >
+void
+WaveletPyramid< TImage >
+::Clear()
+{
+  this->m_Images.clear();
+  this->m_ArenaSize = 0;
+  this->m_ScratchContainers.clear();
+  this->m_ScratchCapacities.clear();
+  this->Modified();
+}
+
+template< typename TImage >
+void
+WaveletPyramid< TImage >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "NumberOfImages: " << this->m_Images.size() << std::endl;
+  os << indent << "ArenaSize: " << this->m_ArenaSize << std::endl;
+  os << indent << "ScratchSlots: " << this->m_ScratchContainers.size() << std::endl;
+}
+} // end namespace itk
+
+#endif
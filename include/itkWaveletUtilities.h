@@ -20,7 +20,11 @@
 
 #include <algorithm>
 #include <cmath>
+#include <complex>
+#include <type_traits>
+#include <utility>
 #include <vector>
+#include <itkCastImageFilter.h>
 #include <itkFixedArray.h>
 #include <itkMath.h>
 #include <itkSize.h>
@@ -52,6 +56,12 @@ namespace utils
   IsotropicWavelets_EXPORT IndexPairType IndexToLevelBandSteerablePyramid(
     unsigned int linearIndex, unsigned int levels, unsigned int bands);
 
+  /** Number of levels that can be done along one axis of size \c sizeAxis with the scale factor.
+   * Number of integer divisions of the size by the scale factor, plus one. If the size is a power of the scale
+   * factor, the exponent. The minimum is 1. \sa ComputeMaxNumberOfLevels */
+  IsotropicWavelets_EXPORT unsigned int ComputeMaxNumberOfLevelsPerAxis(
+    SizeValueType sizeAxis, unsigned int scaleFactor);
+
   /** Compute max number of levels depending on the size of the image.
    * Return J: $ J = \text{min_element}\{J_0,\ldots, J_d\} $;
    * where each $J_i$ is the  number of integer divisions that can be done with the $i$ size and the scale factor.
@@ -62,43 +72,183 @@ ITK_TEMPLATE_EXPORT unsigned int ComputeMaxNumberOfLevels(
   const Size< VImageDimension >& inputSize, const unsigned int & scaleFactor)
   {
   FixedArray< unsigned int, VImageDimension > exponentPerAxis;
-  // The minimum level is 1.
-  exponentPerAxis.Fill(1);
   for ( unsigned int axis = 0; axis < VImageDimension; ++axis )
     {
-    size_t sizeAxis = inputSize[axis];
-    double exponent = std::log(static_cast<double>(sizeAxis)) / std::log(static_cast< double >(scaleFactor));
-    // check that exponent is integer: the fractional part is 0
-    double exponentIntPart;
-    double exponentFractionPart = std::modf(exponent, &exponentIntPart );
-    if ( itk::Math::FloatAlmostEqual(exponentFractionPart, 0.0) )
+    exponentPerAxis[axis] = ComputeMaxNumberOfLevelsPerAxis(inputSize[axis], scaleFactor);
+    }
+  // return the min_element of array:
+  //  - 1 is any size is not divisible by scale factor
+  return *std::min_element(exponentPerAxis.Begin(), exponentPerAxis.End());
+  }
+
+  /** Compute max number of levels with a scale factor per axis.
+   * As ComputeMaxNumberOfLevels, but the axes with a scale factor of 1 are not decimated,
+   * and do not limit the number of levels. Returns 1 if no axis is decimated, and 0 if a decimated
+   * axis has size 1, as ComputeMaxNumberOfLevels with a single scale factor.
+   */
+template < unsigned int VImageDimension >
+ITK_TEMPLATE_EXPORT unsigned int ComputeMaxNumberOfLevels(
+  const Size< VImageDimension >& inputSize, const FixedArray< unsigned int, VImageDimension > & scaleFactors)
+  {
+  // 0 is a valid number of levels of an axis, the first decimated axis is tracked apart.
+  bool anyAxisIsDecimated = false;
+  unsigned int maxLevels = 1;
+  for ( unsigned int axis = 0; axis < VImageDimension; ++axis )
+    {
+    if ( scaleFactors[axis] < 2 )
       {
-      exponentPerAxis[axis] = static_cast< unsigned int >(exponent);
+      continue;
       }
-    else
+    const unsigned int levelsAxis = ComputeMaxNumberOfLevelsPerAxis(inputSize[axis], scaleFactors[axis]);
+    maxLevels = anyAxisIsDecimated ? std::min(maxLevels, levelsAxis) : levelsAxis;
+    anyAxisIsDecimated = true;
+    }
+  return maxLevels;
+  }
+
+  /** Geometric mean of the scale factors of all the axes.
+   * The number of pixels of each level is reduced by MeanScaleFactor^ImageDimension, the product
+   * of the factors. All the normalization factors of the wavelet transforms are powers
+   * MeanScaleFactor^(a * ImageDimension): the band factors with a = (band / bands - level) / 2,
+   * and the upsample correction with a = 1. They are the powers of the ratio of pixels
+   * between levels, 2^ImageDimension in the dyadic case, whatever the factor of each axis.
+   * I.e. the transform with factors {2, 2, 1} of a volume constant along z is,
+   * in the plane kz = 0, the 2D dyadic transform of one slice.
+   */
+template < unsigned int VImageDimension >
+double ComputeMeanScaleFactor(const FixedArray< unsigned int, VImageDimension > & scaleFactors)
+  {
+  double logSum = 0.0;
+  for ( unsigned int axis = 0; axis < VImageDimension; ++axis )
+    {
+    logSum += std::log(static_cast< double >( scaleFactors[axis] ));
+    }
+  return std::exp(logSum / VImageDimension);
+  }
+
+  /** True if all the scale factors are 1 or 2, the factors supported by the wavelet transforms.
+   * The low-pass band of the wavelets of this module reaches half the Nyquist frequency:
+   * decimating by a larger factor aliases it, and the reconstruction is not perfect.
+   */
+template < unsigned int VImageDimension >
+bool AreWaveletScaleFactorsSupported(const FixedArray< unsigned int, VImageDimension > & scaleFactors)
+  {
+  for ( unsigned int axis = 0; axis < VImageDimension; ++axis )
+    {
+    if ( scaleFactors[axis] != 1 && scaleFactors[axis] != 2 )
       {
-      // increase valid levels until the division size/scale_factor gives a non-integer.
-      auto sizeAtLevel = static_cast<double>(sizeAxis);
-      for (;;)
-        {
-        double division = sizeAtLevel / static_cast<double>(scaleFactor);
-        double intPartDivision;
-        double fractionPartDivision = std::modf(division, &intPartDivision );
-        if ( itk::Math::FloatAlmostEqual(fractionPartDivision, 0.0) )
-          {
-          exponentPerAxis[axis]++;
-          sizeAtLevel = intPartDivision;
-          }
-        else
-          {
-          break;
-          }
-        }
+      return false;
       }
     }
-  // return the min_element of array:
-  //  - 1 is any size is not divisible by scale factor
-  return *std::min_element(exponentPerAxis.Begin(), exponentPerAxis.End());
+  return true;
+  }
+
+  /** Trait to detect frequency iterators with the half-hermitian layout of
+   * RealToHalfHermitianForwardFFTImageFilter, i.e. iterators with SetActualXDimensionIsOdd,
+   * like FrequencyHalfHermitianFFTLayoutImageRegionIteratorWithIndex. */
+template< typename TFrequencyIterator, typename = void >
+struct IsHalfHermitianFrequencyIterator: std::false_type {};
+
+template< typename TFrequencyIterator >
+struct IsHalfHermitianFrequencyIterator< TFrequencyIterator,
+  decltype( std::declval< TFrequencyIterator & >().SetActualXDimensionIsOdd(true), void() ) >: std::true_type {};
+
+namespace detail
+{
+template< typename TFrequencyIterator >
+void SetActualXDimensionIsOdd(TFrequencyIterator & it, bool isOdd, std::true_type)
+  {
+  it.SetActualXDimensionIsOdd(isOdd);
+  }
+
+template< typename TFrequencyIterator >
+void SetActualXDimensionIsOdd(TFrequencyIterator &, bool, std::false_type)
+  {
+  }
+} // end namespace detail
+
+  /** Set ActualXDimensionIsOdd in half-hermitian frequency iterators.
+   * Does nothing for iterators of full layouts, which do not need it. */
+template< typename TFrequencyIterator >
+void SetActualXDimensionIsOdd(TFrequencyIterator & it, bool isOdd)
+  {
+  detail::SetActualXDimensionIsOdd(it, isOdd, IsHalfHermitianFrequencyIterator< TFrequencyIterator >());
+  }
+
+  /** Rebind a frequency iterator to iterate over another image type, keeping its layout.
+   * i.e. FrequencyFFTLayoutImageRegionIteratorWithIndex< TImage > to
+   * FrequencyFFTLayoutImageRegionIteratorWithIndex< TNewImage >. */
+template< typename TFrequencyIterator, typename TNewImage >
+struct RebindFrequencyIterator;
+
+template< template< typename > class TFrequencyIterator, typename TImage, typename TNewImage >
+struct RebindFrequencyIterator< TFrequencyIterator< TImage >, TNewImage >
+  {
+  using Type = TFrequencyIterator< TNewImage >;
+  };
+
+  /** Get the value at a frequency bin of the full spectrum from an image with half-hermitian layout.
+   * \c fullIndex is the zero-based bin in the full spectrum of size \c fullSize.
+   * The x bins not stored in the image are recovered from the hermitian symmetry:
+   * \f$ F(k) = F^*(N - k) \f$
+   */
+template< typename TImage >
+typename TImage::PixelType GetHalfHermitianPixel(const TImage * image,
+  const typename TImage::IndexType & fullIndex,
+  const typename TImage::SizeType & fullSize)
+  {
+  const typename TImage::IndexType & startIndex = image->GetLargestPossibleRegion().GetIndex();
+  const typename TImage::SizeType & halfSize = image->GetLargestPossibleRegion().GetSize();
+  typename TImage::IndexType index;
+  if ( static_cast< SizeValueType >(fullIndex[0]) < halfSize[0] )
+    {
+    for ( unsigned int dim = 0; dim < TImage::ImageDimension; ++dim )
+      {
+      index[dim] = startIndex[dim] + fullIndex[dim];
+      }
+    return image->GetPixel(index);
+    }
+  for ( unsigned int dim = 0; dim < TImage::ImageDimension; ++dim )
+    {
+    const auto size = static_cast< IndexValueType >(fullSize[dim]);
+    index[dim] = startIndex[dim] + ( size - fullIndex[dim] ) % size;
+    }
+  return std::conj(image->GetPixel(index));
+  }
+
+namespace detail
+{
+template< typename TInputImage, typename TOutputImage >
+typename TOutputImage::Pointer ShareOrCastImage(const TInputImage * input, std::true_type)
+  {
+  typename TOutputImage::Pointer output = TOutputImage::New();
+  output->Graft(input);
+  return output;
+  }
+
+template< typename TInputImage, typename TOutputImage >
+typename TOutputImage::Pointer ShareOrCastImage(const TInputImage * input, std::false_type)
+  {
+  using CastFilterType = CastImageFilter< TInputImage, TOutputImage >;
+  auto castFilter = CastFilterType::New();
+  castFilter->SetInput(input);
+  castFilter->Update();
+  typename TOutputImage::Pointer output = castFilter->GetOutput();
+  output->DisconnectPipeline();
+  return output;
+  }
+} // end namespace detail
+
+  /** New image, without source, with the pixels of \c input.
+   * When the image types are equal, the pixel container of \c input is shared, not copied.
+   * Otherwise \c input is cast with a CastImageFilter.
+   * The metadata of the returned image (origin, spacing) can be modified without modifying \c input,
+   * but its pixels must be treated as read-only. */
+template< typename TInputImage, typename TOutputImage >
+typename TOutputImage::Pointer ShareOrCastImage(const TInputImage * input)
+  {
+  return detail::ShareOrCastImage< TInputImage, TOutputImage >(input,
+    std::is_same< TInputImage, TOutputImage >());
   }
 
 } // end namespace utils
@@ -47,6 +47,41 @@ IndexPairType IndexToLevelBandSteerablePyramid(unsigned int linearIndex,
   return std::make_pair(level, band);
   }
 
+unsigned int ComputeMaxNumberOfLevelsPerAxis(SizeValueType sizeAxis, unsigned int scaleFactor)
+  {
+  // The minimum level is 1.
+  unsigned int exponentAxis = 1;
+  double exponent = std::log(static_cast<double>(sizeAxis)) / std::log(static_cast< double >(scaleFactor));
+  // check that exponent is integer: the fractional part is 0
+  double exponentIntPart;
+  double exponentFractionPart = std::modf(exponent, &exponentIntPart );
+  if ( itk::Math::FloatAlmostEqual(exponentFractionPart, 0.0) )
+    {
+    exponentAxis = static_cast< unsigned int >(exponent);
+    }
+  else
+    {
+    // increase valid levels until the division size/scale_factor gives a non-integer.
+    auto sizeAtLevel = static_cast<double>(sizeAxis);
+    for (;;)
+      {
+      double division = sizeAtLevel / static_cast<double>(scaleFactor);
+      double intPartDivision;
+      double fractionPartDivision = std::modf(division, &intPartDivision );
+      if ( itk::Math::FloatAlmostEqual(fractionPartDivision, 0.0) )
+        {
+        exponentAxis++;
+        sizeAtLevel = intPartDivision;
+        }
+      else
+        {
+        break;
+        }
+      }
+    }
+  return exponentAxis;
+  }
+
 // Instantiation
 template<>
 unsigned int ComputeMaxNumberOfLevels<3>(const Size< 3 >& inputSize, const unsigned int & scaleFactor);
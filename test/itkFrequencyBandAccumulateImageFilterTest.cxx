@@ -0,0 +1,151 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImage.h"
+#include "itkFrequencyBandAccumulateImageFilter.h"
+#include "itkFrequencyFilterBankMultiplyImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkIsotropicWaveletTestUtilities.h"
+#include "itkTestingMacros.h"
+
+#include <complex>
+#include <vector>
+
+namespace
+{
+template< typename TFilterBankImage, unsigned int VDimension >
+int
+runFrequencyBandAccumulateImageFilterTest(bool inPlace)
+{
+  using ComplexImageType = itk::Image< std::complex< double >, VDimension >;
+  using AccumulateFilterType = itk::FrequencyBandAccumulateImageFilter< ComplexImageType, TFilterBankImage >;
+  using MultiplyFilterType = itk::FrequencyFilterBankMultiplyImageFilter< ComplexImageType, TFilterBankImage >;
+  constexpr unsigned int numberOfBands = 3;
+  const double scale = 0.5;
+
+  typename ComplexImageType::SizeType size;
+  size.Fill(6);
+  size[0] = 7;
+  auto lowPass = itk::Testing::MakeSyntheticSpectrum< ComplexImageType >(size);
+  std::vector< typename ComplexImageType::Pointer > coefficients;
+  std::vector< typename TFilterBankImage::Pointer > filterBanks;
+  std::vector< double > factors;
+  for ( unsigned int band = 0; band < numberOfBands; ++band )
+    {
+    coefficients.push_back(itk::Testing::MakeSyntheticSpectrum< ComplexImageType >(size, 0.5 * ( band + 1 )));
+    filterBanks.push_back(itk::Testing::MakeSyntheticFilterBank< TFilterBankImage >(size, 1.0 + band));
+    factors.push_back(1.0 + band);
+    }
+
+  // Reference: accumulate each product into a copy of the low pass, then scale.
+  auto expected = itk::Testing::MakeSyntheticSpectrum< ComplexImageType >(size);
+  for ( unsigned int band = 0; band < numberOfBands; ++band )
+    {
+    auto multiplyFilter = MultiplyFilterType::New();
+    multiplyFilter->SetInput1(coefficients[band]);
+    multiplyFilter->SetInput2(filterBanks[band]);
+    multiplyFilter->Update();
+    itk::ImageRegionConstIterator< ComplexImageType > productIt(multiplyFilter->GetOutput(),
+      multiplyFilter->GetOutput()->GetLargestPossibleRegion());
+    itk::ImageRegionIterator< ComplexImageType > expectedIt(expected, expected->GetLargestPossibleRegion());
+    for ( productIt.GoToBegin(), expectedIt.GoToBegin(); !productIt.IsAtEnd(); ++productIt, ++expectedIt )
+      {
+      expectedIt.Set(expectedIt.Get() + factors[band] * productIt.Get());
+      }
+    }
+  itk::ImageRegionIterator< ComplexImageType > expectedIt(expected, expected->GetLargestPossibleRegion());
+  for ( expectedIt.GoToBegin(); !expectedIt.IsAtEnd(); ++expectedIt )
+    {
+    expectedIt.Set(scale * expectedIt.Get());
+    }
+
+  auto accumulateFilter = AccumulateFilterType::New();
+  accumulateFilter->SetInput(lowPass);
+  accumulateFilter->SetNumberOfBands(numberOfBands);
+  TEST_EXPECT_EQUAL( accumulateFilter->GetNumberOfBands(), numberOfBands );
+  for ( unsigned int band = 0; band < numberOfBands; ++band )
+    {
+    accumulateFilter->SetBand(band, coefficients[band], filterBanks[band], factors[band]);
+    }
+  TEST_EXPECT_EQUAL( accumulateFilter->GetBandFactor(1), factors[1] );
+  TEST_EXPECT_TRUE( accumulateFilter->GetBandCoefficients(1) == coefficients[1].GetPointer() );
+  TEST_EXPECT_TRUE( accumulateFilter->GetBandFilterBank(1) == filterBanks[1].GetPointer() );
+  accumulateFilter->SetScale(scale);
+  accumulateFilter->SetInPlace(inPlace);
+  TRY_EXPECT_NO_EXCEPTION( accumulateFilter->Update() );
+
+  const ComplexImageType * actual = accumulateFilter->GetOutput();
+  TEST_EXPECT_EQUAL( actual->GetLargestPossibleRegion(), lowPass->GetLargestPossibleRegion() );
+  const double difference = itk::Testing::ComputeMaxAbsoluteDifference(expected.GetPointer(), actual);
+  if ( difference > 1e-10 )
+    {
+    std::cerr << "Dimension " << VDimension << ", in place " << inPlace
+              << ": differs from the sum of the products of the bands by " << difference << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // The bands have to match the size of the input.
+  typename ComplexImageType::SizeType wrongSize = size;
+  wrongSize[0] += 1;
+  auto wrongCoefficients = itk::Testing::MakeSyntheticSpectrum< ComplexImageType >(wrongSize);
+  auto wrongSizeFilter = AccumulateFilterType::New();
+  wrongSizeFilter->SetInput(itk::Testing::MakeSyntheticSpectrum< ComplexImageType >(size));
+  wrongSizeFilter->SetNumberOfBands(1);
+  wrongSizeFilter->SetBand(0, wrongCoefficients, filterBanks[0]);
+  TRY_EXPECT_EXCEPTION( wrongSizeFilter->Update() );
+  TRY_EXPECT_EXCEPTION( wrongSizeFilter->SetBand(1, coefficients[0], filterBanks[0]) );
+
+  return EXIT_SUCCESS;
+}
+}
+
+int
+itkFrequencyBandAccumulateImageFilterTest( int, char *[] )
+{
+  constexpr unsigned int Dimension = 3;
+  using ComplexImageType = itk::Image< std::complex< double >, Dimension >;
+  using RealFilterBankImageType = itk::Image< double, Dimension >;
+  using AccumulateFilterType = itk::FrequencyBandAccumulateImageFilter< ComplexImageType, RealFilterBankImageType >;
+
+  auto accumulateFilter = AccumulateFilterType::New();
+  EXERCISE_BASIC_OBJECT_METHODS( accumulateFilter, FrequencyBandAccumulateImageFilter, InPlaceImageFilter );
+  TEST_SET_GET_VALUE( 1.0, accumulateFilter->GetScale() );
+  TEST_EXPECT_EQUAL( accumulateFilter->GetNumberOfBands(), 0u );
+
+  int result = EXIT_SUCCESS;
+  for ( bool inPlace : { false, true } )
+    {
+    if ( runFrequencyBandAccumulateImageFilterTest< itk::Image< double, 2 >, 2 >(inPlace) == EXIT_FAILURE )
+      {
+      result = EXIT_FAILURE;
+      }
+    if ( runFrequencyBandAccumulateImageFilterTest< RealFilterBankImageType, Dimension >(inPlace) == EXIT_FAILURE )
+      {
+      result = EXIT_FAILURE;
+      }
+    if ( runFrequencyBandAccumulateImageFilterTest< ComplexImageType, Dimension >(inPlace) == EXIT_FAILURE )
+      {
+      result = EXIT_FAILURE;
+      }
+    }
+
+  if ( result == EXIT_FAILURE )
+    {
+    std::cerr << "Test failed!" << std::endl;
+    }
+  return result;
+}
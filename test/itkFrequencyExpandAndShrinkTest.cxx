@@ -194,6 +194,45 @@ runFrequencyExpandAndShrinkTest( const std::string & inputImage, const std::stri
     testPassed = false;
     }
 
+  // Per-axis and non-dyadic factors: the expansion replicates the input and the shrink averages the aliases.
+    {
+    using ExpandType = itk::FrequencyExpandImageFilter< ComplexImageType >;
+    using ShrinkType = itk::FrequencyShrinkImageFilter< ComplexImageType >;
+    typename ExpandType::ExpandFactorsType perAxisFactors;
+    for ( unsigned int dim = 0; dim < Dimension; ++dim )
+      {
+      perAxisFactors[dim] = ( dim == 0 ) ? 3 : ( dim == 1 ) ? 1 : 5;
+      }
+    auto perAxisExpandFilter = ExpandType::New();
+    perAxisExpandFilter->SetInput(fftFilter->GetOutput());
+    perAxisExpandFilter->SetExpandFactors(perAxisFactors);
+    auto perAxisShrinkFilter = ShrinkType::New();
+    perAxisShrinkFilter->SetInput(perAxisExpandFilter->GetOutput());
+    perAxisShrinkFilter->SetShrinkFactors(perAxisFactors);
+    auto perAxisInverseFFT = InverseFFTFilterType::New();
+    perAxisInverseFFT->SetInput(perAxisShrinkFilter->GetOutput());
+    TRY_EXPECT_NO_EXCEPTION( perAxisInverseFFT->Update() );
+
+    typename ComplexImageType::SizeType expectedExpandSize = fftFilter->GetOutput()->GetLargestPossibleRegion().GetSize();
+    for ( unsigned int dim = 0; dim < Dimension; ++dim )
+      {
+      expectedExpandSize[dim] *= perAxisFactors[dim];
+      }
+    TEST_EXPECT_EQUAL( perAxisExpandFilter->GetOutput()->GetLargestPossibleRegion().GetSize(), expectedExpandSize );
+
+    differenceFilter->SetTestInput( perAxisInverseFFT->GetOutput() );
+    differenceFilter->Update();
+    numberOfDiffPixels = differenceFilter->GetNumberOfPixelsWithDifferences();
+    if ( numberOfDiffPixels > 0 )
+      {
+      std::cerr << "Test failed! " << std::endl;
+      std::cerr << "FrequencyExpand + FrequencyShrinker with factors " << perAxisFactors
+                << " should be equal to input image, but got " << numberOfDiffPixels
+                << " unequal pixels" << std::endl;
+      testPassed = false;
+      }
+    }
+
   // Via inverseFFT and spatial domain manipulation.
 #ifdef ITK_VISUALIZE_TESTS
   itk::ViewImage<ImageType>::View( inverseFFT2->GetOutput(), "ExpandAndShrink ViaInverseFFT" );
@@ -0,0 +1,138 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImage.h"
+#include "itkFrequencyExpandMultiplyImageFilter.h"
+#include "itkFrequencyExpandImageFilter.h"
+#include "itkFrequencyFilterBankMultiplyImageFilter.h"
+#include "itkMultiplyImageFilter.h"
+#include "itkIsotropicWaveletTestUtilities.h"
+#include "itkTestingMacros.h"
+
+#include <complex>
+
+namespace
+{
+/** Compare Scale * FilterBank * Expand(input) with the same steps done by separate filters. */
+template< typename TFilterBankImage, unsigned int VDimension >
+int
+runFrequencyExpandMultiplyImageFilterTest(const typename TFilterBankImage::SizeType & size,
+  const itk::FixedArray< unsigned int, VDimension > & expandFactors, double scale)
+{
+  using ComplexImageType = itk::Image< std::complex< double >, VDimension >;
+  using ExpandFilterType = itk::FrequencyExpandImageFilter< ComplexImageType >;
+  using MultiplyConstantFilterType = itk::MultiplyImageFilter< ComplexImageType >;
+  using MultiplyFilterType = itk::FrequencyFilterBankMultiplyImageFilter< ComplexImageType, TFilterBankImage >;
+  using ExpandMultiplyFilterType = itk::FrequencyExpandMultiplyImageFilter< ComplexImageType, TFilterBankImage >;
+
+  auto input = itk::Testing::MakeSyntheticSpectrum< ComplexImageType >(size);
+  typename ComplexImageType::SpacingType spacing;
+  spacing.Fill(0.5);
+  input->SetSpacing(spacing);
+  // The filter bank has the size of the output, with default metadata.
+  typename TFilterBankImage::SizeType outputSize;
+  for ( unsigned int dim = 0; dim < VDimension; ++dim )
+    {
+    outputSize[dim] = size[dim] * expandFactors[dim];
+    }
+  auto filterBank = itk::Testing::MakeSyntheticFilterBank< TFilterBankImage >(outputSize);
+
+  auto expandFilter = ExpandFilterType::New();
+  expandFilter->SetInput(input);
+  expandFilter->SetExpandFactors(expandFactors);
+  auto multiplyConstantFilter = MultiplyConstantFilterType::New();
+  multiplyConstantFilter->SetInput1(expandFilter->GetOutput());
+  multiplyConstantFilter->SetConstant(scale);
+  auto multiplyFilter = MultiplyFilterType::New();
+  multiplyFilter->SetInput1(multiplyConstantFilter->GetOutput());
+  multiplyFilter->SetInput2(filterBank);
+  multiplyFilter->Update();
+
+  auto expandMultiplyFilter = ExpandMultiplyFilterType::New();
+  expandMultiplyFilter->SetInput(input);
+  expandMultiplyFilter->SetFilterBank(filterBank);
+  expandMultiplyFilter->SetExpandFactors(expandFactors);
+  expandMultiplyFilter->SetScale(scale);
+  TRY_EXPECT_NO_EXCEPTION( expandMultiplyFilter->Update() );
+
+  // Only the output metadata comes from the input.
+  const ComplexImageType * expected = multiplyFilter->GetOutput();
+  const ComplexImageType * actual = expandMultiplyFilter->GetOutput();
+  TEST_EXPECT_EQUAL( actual->GetLargestPossibleRegion(), expected->GetLargestPossibleRegion() );
+  TEST_EXPECT_EQUAL( actual->GetSpacing(), expected->GetSpacing() );
+  TEST_EXPECT_EQUAL( actual->GetOrigin(), expected->GetOrigin() );
+  const double difference = itk::Testing::ComputeMaxAbsoluteDifference(expected, actual);
+  if ( difference > 1e-10 )
+    {
+    std::cerr << "Error. Size " << size << ", factors " << expandFactors << ", scale " << scale
+              << ": differs from the expand, scale and multiply filters by " << difference << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // The filter bank has the expanded size, not the size of the input.
+  expandMultiplyFilter->SetFilterBank(itk::Testing::MakeSyntheticFilterBank< TFilterBankImage >(size));
+  TRY_EXPECT_EXCEPTION( expandMultiplyFilter->Update() );
+  return EXIT_SUCCESS;
+}
+}
+
+int
+itkFrequencyExpandMultiplyImageFilterTest( int, char *[] )
+{
+  constexpr unsigned int Dimension = 3;
+  using ComplexImageType = itk::Image< std::complex< double >, Dimension >;
+  using RealFilterBankImageType = itk::Image< double, Dimension >;
+  using ExpandMultiplyFilterType = itk::FrequencyExpandMultiplyImageFilter< ComplexImageType, RealFilterBankImageType >;
+  using FactorsType = ExpandMultiplyFilterType::ExpandFactorsType;
+
+  auto expandMultiplyFilter = ExpandMultiplyFilterType::New();
+  EXERCISE_BASIC_OBJECT_METHODS( expandMultiplyFilter, FrequencyExpandMultiplyImageFilter, ImageToImageFilter );
+
+  FactorsType dyadicFactors;
+  dyadicFactors.Fill(2);
+  TEST_SET_GET_VALUE( dyadicFactors, expandMultiplyFilter->GetExpandFactors() );
+  TEST_SET_GET_VALUE( 1.0, expandMultiplyFilter->GetScale() );
+
+  // Even and odd sizes, with the upsample correction of a 3D dyadic level as scale.
+  const RealFilterBankImageType::SizeType evenSize = {{4, 4, 4}};
+  const RealFilterBankImageType::SizeType oddSize = {{5, 3, 5}};
+  FactorsType perAxisFactors;
+  perAxisFactors[0] = 3;
+  perAxisFactors[1] = 1;
+  perAxisFactors[2] = 2;
+  const itk::Size< 2 > size2D = {{6, 5}};
+  itk::FixedArray< unsigned int, 2 > factors2D;
+  factors2D.Fill(2);
+  const int results[] = {
+    runFrequencyExpandMultiplyImageFilterTest< RealFilterBankImageType, Dimension >(evenSize, dyadicFactors, 8.0),
+    runFrequencyExpandMultiplyImageFilterTest< ComplexImageType, Dimension >(oddSize, dyadicFactors, 8.0),
+    // Per-axis and non-dyadic factors.
+    runFrequencyExpandMultiplyImageFilterTest< RealFilterBankImageType, Dimension >(oddSize, perAxisFactors, 6.0),
+    runFrequencyExpandMultiplyImageFilterTest< itk::Image< double, 2 >, 2 >(size2D, factors2D, 4.0) };
+  bool testPassed = true;
+  for ( int result : results )
+    {
+    testPassed &= ( result == EXIT_SUCCESS );
+    }
+
+  if ( !testPassed )
+    {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
@@ -26,6 +26,7 @@
 #include "itkExpandWithZerosImageFilter.h"
 #include "itkComplexToComplexFFTImageFilter.h"
 #include "itkImageRegionConstIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkZeroDCImageFilter.h"
 #include "itkIsotropicWaveletTestUtilities.h"
 #include "itkCastImageFilter.h"
@@ -115,6 +116,40 @@ runFrequencyExpandTest(const std::string & inputImage, const std::string & outpu
   inverseFFT->SetInput( expandFilter->GetOutput() );
   inverseFFT->Update();
 
+  // Each output bin is the input bin k mod inputSize, also with per-axis factors.
+  auto expandPerAxisFilter = ExpandType::New();
+  expandPerAxisFilter->SetInput( fftFilter->GetOutput() );
+  typename ExpandType::ExpandFactorsType perAxisExpandFactors;
+  perAxisExpandFactors.Fill( 2 );
+  perAxisExpandFactors[0] = 3;
+  perAxisExpandFactors[Dimension - 1] = 1;
+  expandPerAxisFilter->SetExpandFactors( perAxisExpandFactors );
+  expandPerAxisFilter->Update();
+  const ComplexImageType * fftImage = fftFilter->GetOutput();
+  const typename ComplexImageType::SizeType fftSize = fftImage->GetLargestPossibleRegion().GetSize();
+  itk::ImageRegionConstIteratorWithIndex< ComplexImageType > expandPerAxisIt( expandPerAxisFilter->GetOutput(),
+    expandPerAxisFilter->GetOutput()->GetLargestPossibleRegion() );
+  unsigned int replicationDifferences = 0;
+  for ( expandPerAxisIt.GoToBegin(); !expandPerAxisIt.IsAtEnd(); ++expandPerAxisIt )
+    {
+    typename ComplexImageType::IndexType sourceIndex = expandPerAxisIt.GetIndex();
+    for ( unsigned int dim = 0; dim < Dimension; ++dim )
+      {
+      sourceIndex[dim] %= static_cast< itk::IndexValueType >( fftSize[dim] );
+      }
+    if ( expandPerAxisIt.Get() != fftImage->GetPixel( sourceIndex ) )
+      {
+      ++replicationDifferences;
+      }
+    }
+  if ( replicationDifferences > 0 )
+    {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Expected output bins equal to the input bins k mod inputSize, but got "
+              << replicationDifferences << " different bins" << std::endl;
+    testPassed = false;
+    }
+
   /***************** Hermitian property (sym) *****************************/
   bool fftIsHermitian    = itk::Testing::ComplexImageIsHermitian(fftFilter->GetOutput());
   bool expandIsHermitian = itk::Testing::ComplexImageIsHermitian(expandFilter->GetOutput());
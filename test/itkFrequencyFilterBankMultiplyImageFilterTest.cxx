@@ -0,0 +1,189 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImage.h"
+#include "itkFrequencyFilterBankMultiplyImageFilter.h"
+#include "itkWaveletFrequencyFilterBankGenerator.h"
+#include "itkWaveletFrequencyForward.h"
+#include "itkWaveletFrequencyInverse.h"
+#include "itkHeldIsotropicWavelet.h"
+#include "itkIsotropicWaveletTestUtilities.h"
+#include "itkTestingMacros.h"
+
+#include <complex>
+#include <string>
+
+namespace
+{
+template< unsigned int VDimension >
+int
+runFrequencyFilterBankMultiplyImageFilterTest()
+{
+  using PixelType = double;
+  using ComplexImageType = itk::Image< std::complex< PixelType >, VDimension >;
+  using RealFilterBankImageType = itk::Image< float, VDimension >;
+  using WaveletFunctionType = itk::HeldIsotropicWavelet< PixelType, VDimension >;
+  using ComplexFilterBankType = itk::WaveletFrequencyFilterBankGenerator< ComplexImageType, WaveletFunctionType >;
+  using RealFilterBankType = itk::WaveletFrequencyFilterBankGenerator< RealFilterBankImageType, WaveletFunctionType >;
+  using ComplexForwardType = itk::WaveletFrequencyForward< ComplexImageType, ComplexImageType, ComplexFilterBankType >;
+  using RealForwardType = itk::WaveletFrequencyForward< ComplexImageType, ComplexImageType, RealFilterBankType >;
+  using ComplexInverseType = itk::WaveletFrequencyInverse< ComplexImageType, ComplexImageType, ComplexFilterBankType >;
+  using RealInverseType = itk::WaveletFrequencyInverse< ComplexImageType, ComplexImageType, RealFilterBankType >;
+
+  typename ComplexImageType::SizeType size;
+  size.Fill(32);
+  auto input = itk::Testing::MakeSyntheticSpectrum< ComplexImageType >(size);
+
+  const unsigned int levels = 2;
+  const unsigned int highSubBands = 2;
+  // The real filter bank is stored in float.
+  const double tolerance = 1e-5;
+  bool testPassed = true;
+
+  // Product with the real and the complex images of the filter bank.
+  auto complexFilterBank = ComplexFilterBankType::New();
+  complexFilterBank->SetHighPassSubBands(highSubBands);
+  complexFilterBank->SetSize(size);
+  complexFilterBank->Update();
+  auto realFilterBank = RealFilterBankType::New();
+  realFilterBank->SetHighPassSubBands(highSubBands);
+  realFilterBank->SetSize(size);
+  realFilterBank->Update();
+  for ( unsigned int band = 0; band < highSubBands + 1; ++band )
+    {
+    using ComplexMultiplyType = itk::FrequencyFilterBankMultiplyImageFilter< ComplexImageType, ComplexImageType >;
+    using RealMultiplyType = itk::FrequencyFilterBankMultiplyImageFilter< ComplexImageType, RealFilterBankImageType >;
+    auto complexMultiply = ComplexMultiplyType::New();
+    complexMultiply->SetInput1(input);
+    complexMultiply->SetInput2(complexFilterBank->GetOutput(band));
+    complexMultiply->Update();
+    auto realMultiply = RealMultiplyType::New();
+    realMultiply->SetInput1(input);
+    realMultiply->SetInput2(realFilterBank->GetOutput(band));
+    realMultiply->Update();
+    const double difference = itk::Testing::ComputeMaxAbsoluteDifference(complexMultiply->GetOutput(),
+      realMultiply->GetOutput());
+    if ( difference > tolerance )
+      {
+      std::cerr << "Product with band " << band << " differs by " << difference << std::endl;
+      testPassed = false;
+      }
+    }
+
+  // Forward wavelet.
+  auto complexForward = ComplexForwardType::New();
+  complexForward->SetLevels(levels);
+  complexForward->SetHighPassSubBands(highSubBands);
+  complexForward->StoreWaveletFilterBankPyramidOn();
+  complexForward->SetInput(input);
+  complexForward->Update();
+
+  auto realForward = RealForwardType::New();
+  realForward->SetLevels(levels);
+  realForward->SetHighPassSubBands(highSubBands);
+  realForward->StoreWaveletFilterBankPyramidOn();
+  realForward->SetInput(input);
+  realForward->Update();
+
+  for ( unsigned int nOutput = 0; nOutput < complexForward->GetTotalOutputs(); ++nOutput )
+    {
+    const ComplexImageType * complexOutput = complexForward->GetOutput(nOutput);
+    const ComplexImageType * realOutput = realForward->GetOutput(nOutput);
+    if ( complexOutput->GetLargestPossibleRegion() != realOutput->GetLargestPossibleRegion()
+         || complexOutput->GetSpacing() != realOutput->GetSpacing() )
+      {
+      std::cerr << "Forward output " << nOutput << " has different metadata." << std::endl;
+      testPassed = false;
+      continue;
+      }
+    const double difference = itk::Testing::ComputeMaxAbsoluteDifference(complexOutput, realOutput);
+    if ( difference > tolerance )
+      {
+      std::cerr << "Forward output " << nOutput << " differs by " << difference << std::endl;
+      testPassed = false;
+      }
+    }
+  TEST_EXPECT_EQUAL( realForward->GetWaveletFilterBankPyramid().size(),
+    complexForward->GetWaveletFilterBankPyramid().size() );
+
+  // Inverse wavelet, with generated and stored filter banks.
+  for ( unsigned int usePyramid = 0; usePyramid < 2; ++usePyramid )
+    {
+    auto complexInverse = ComplexInverseType::New();
+    complexInverse->SetLevels(levels);
+    complexInverse->SetHighPassSubBands(highSubBands);
+    complexInverse->SetUseWaveletFilterBankPyramid(usePyramid == 1);
+    complexInverse->SetWaveletFilterBankPyramid(complexForward->GetWaveletFilterBankPyramid());
+    complexInverse->SetInputs(complexForward->GetOutputs());
+    complexInverse->Update();
+
+    auto realInverse = RealInverseType::New();
+    realInverse->SetLevels(levels);
+    realInverse->SetHighPassSubBands(highSubBands);
+    realInverse->SetUseWaveletFilterBankPyramid(usePyramid == 1);
+    realInverse->SetWaveletFilterBankPyramid(realForward->GetWaveletFilterBankPyramid());
+    realInverse->SetInputs(realForward->GetOutputs());
+    realInverse->Update();
+
+    const double difference = itk::Testing::ComputeMaxAbsoluteDifference(complexInverse->GetOutput(),
+      realInverse->GetOutput());
+    if ( difference > tolerance )
+      {
+      std::cerr << "Inverse (UseWaveletFilterBankPyramid: " << usePyramid << ") differs by "
+                << difference << std::endl;
+      testPassed = false;
+      }
+    }
+
+  return testPassed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+}
+
+int
+itkFrequencyFilterBankMultiplyImageFilterTest( int, char *[] )
+{
+  constexpr unsigned int Dimension = 3;
+  using ComplexImageType = itk::Image< std::complex< double >, Dimension >;
+  using RealFilterBankImageType = itk::Image< float, Dimension >;
+  using MultiplyFilterType = itk::FrequencyFilterBankMultiplyImageFilter< ComplexImageType, RealFilterBankImageType >;
+
+  auto multiplyFilter = MultiplyFilterType::New();
+  EXERCISE_BASIC_OBJECT_METHODS( multiplyFilter, FrequencyFilterBankMultiplyImageFilter, BinaryFunctorImageFilter );
+
+  // Real filter banks multiply both components of the coefficient.
+  itk::Functor::FilterBankMultiply< std::complex< double >, float > realFunctor;
+  TEST_EXPECT_TRUE( realFunctor(std::complex< double >(1.0, -2.0), 0.5f) == std::complex< double >(0.5, -1.0) );
+  itk::Functor::FilterBankMultiply< std::complex< double >, std::complex< double > > complexFunctor;
+  TEST_EXPECT_TRUE( complexFunctor(std::complex< double >(1.0, -2.0), std::complex< double >(0.0, 1.0))
+    == std::complex< double >(2.0, 1.0) );
+
+  int result = EXIT_SUCCESS;
+  if ( runFrequencyFilterBankMultiplyImageFilterTest< 2 >() == EXIT_FAILURE )
+    {
+    result = EXIT_FAILURE;
+    }
+  if ( runFrequencyFilterBankMultiplyImageFilterTest< Dimension >() == EXIT_FAILURE )
+    {
+    result = EXIT_FAILURE;
+    }
+
+  if ( result == EXIT_FAILURE )
+    {
+    std::cerr << "Test failed!" << std::endl;
+    }
+  return result;
+}
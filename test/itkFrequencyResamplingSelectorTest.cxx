@@ -0,0 +1,180 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImage.h"
+#include "itkFrequencyResamplingSelector.h"
+#include "itkForwardFFTImageFilter.h"
+#include "itkWaveletFrequencyForward.h"
+#include "itkWaveletFrequencyInverse.h"
+#include "itkWaveletFrequencyFilterBankGenerator.h"
+#include "itkHeldIsotropicWavelet.h"
+#include "itkIsotropicWaveletTestUtilities.h"
+#include "itkTestingMacros.h"
+
+#include <complex>
+
+int
+itkFrequencyResamplingSelectorTest( int, char *[] )
+{
+  constexpr unsigned int Dimension = 3;
+  using RealImageType = itk::Image< double, Dimension >;
+  using FFTFilterType = itk::ForwardFFTImageFilter< RealImageType >;
+  using ComplexImageType = FFTFilterType::OutputImageType;
+  using SelectorType = itk::FrequencyResamplingSelector< ComplexImageType >;
+  using MethodType = SelectorType::MethodType;
+
+  bool testPassed = true;
+
+  auto selector = SelectorType::New();
+  EXERCISE_BASIC_OBJECT_METHODS( selector, FrequencyResamplingSelector, Object );
+
+  selector->SetNumberOfCalibrationRuns(0);
+  TEST_EXPECT_EQUAL( selector->GetNumberOfCalibrationRuns(), 1u );
+  selector->SetNumberOfCalibrationRuns(2);
+  TEST_EXPECT_EQUAL( selector->GetNumberOfCalibrationRuns(), 2u );
+
+  // The choice is calibrated once per size, factors and work units.
+  SelectorType::SizeType size = {{32, 32, 16}};
+  SelectorType::FactorsType factors;
+  factors.Fill(2);
+  const MethodType shrinkMethod = selector->SelectShrinkMethod(size, factors, 1);
+  TEST_EXPECT_EQUAL( selector->GetNumberOfCalibrations(), 1u );
+  TEST_EXPECT_TRUE( selector->SelectShrinkMethod(size, factors, 1) == shrinkMethod );
+  TEST_EXPECT_EQUAL( selector->GetNumberOfCalibrations(), 1u );
+  selector->SelectExpandMethod(size, factors, 1);
+  selector->SelectShrinkMethod(size, factors, 2);
+  TEST_EXPECT_EQUAL( selector->GetNumberOfCalibrations(), 3u );
+  TEST_EXPECT_EQUAL( selector->GetNumberOfEntries(), 3u );
+
+  // The fold and the spatial decimation are not equivalent if the size is not a multiple of the factor.
+  SelectorType::SizeType oddSize = {{9, 9, 9}};
+  TEST_EXPECT_TRUE( selector->SelectShrinkMethod(oddSize, factors, 1) == MethodType::Frequency );
+
+  selector->Clear();
+  TEST_EXPECT_EQUAL( selector->GetNumberOfEntries(), 0u );
+
+  // Both methods give the same result for the spectrum of a real image.
+  auto fftFilter = FFTFilterType::New();
+  fftFilter->SetInput(itk::Testing::MakeSyntheticImage< RealImageType >(size));
+  fftFilter->Update();
+  const ComplexImageType * spectrum = fftFilter->GetOutput();
+  const double tolerance = 1e-9 * spectrum->GetLargestPossibleRegion().GetNumberOfPixels();
+
+  for ( bool expand : { false, true } )
+    {
+    SelectorType::ResamplingFilterType::Pointer frequencyFilter = expand ?
+      SelectorType::MakeExpandFilter(MethodType::Frequency, factors) :
+      SelectorType::MakeShrinkFilter(MethodType::Frequency, factors);
+    SelectorType::ResamplingFilterType::Pointer viaInverseFFTFilter = expand ?
+      SelectorType::MakeExpandFilter(MethodType::ViaInverseFFT, factors) :
+      SelectorType::MakeShrinkFilter(MethodType::ViaInverseFFT, factors);
+    frequencyFilter->SetInput(spectrum);
+    viaInverseFFTFilter->SetInput(spectrum);
+    TRY_EXPECT_NO_EXCEPTION( frequencyFilter->Update() );
+    TRY_EXPECT_NO_EXCEPTION( viaInverseFFTFilter->Update() );
+    TEST_EXPECT_EQUAL( frequencyFilter->GetOutput()->GetLargestPossibleRegion(),
+      viaInverseFFTFilter->GetOutput()->GetLargestPossibleRegion() );
+    const double difference = itk::Testing::ComputeMaxAbsoluteDifference(frequencyFilter->GetOutput(),
+      viaInverseFFTFilter->GetOutput());
+    if ( difference > tolerance )
+      {
+      std::cerr << "Error. The " << ( expand ? "expand" : "shrink" ) << " methods differ: " << difference << std::endl;
+      testPassed = false;
+      }
+    }
+
+  // Wavelet pyramid: the template parameter and the automatic selection give the same outputs than the default.
+  using WaveletFunctionType = itk::HeldIsotropicWavelet<>;
+  using WaveletFilterBankType = itk::WaveletFrequencyFilterBankGenerator< ComplexImageType, WaveletFunctionType >;
+  using ForwardWaveletType = itk::WaveletFrequencyForward< ComplexImageType, ComplexImageType, WaveletFilterBankType >;
+  using ForwardWaveletViaInverseFFTType = itk::WaveletFrequencyForward< ComplexImageType, ComplexImageType,
+    WaveletFilterBankType, itk::FrequencyShrinkViaInverseFFTImageFilter< ComplexImageType > >;
+  using InverseWaveletType = itk::WaveletFrequencyInverse< ComplexImageType, ComplexImageType, WaveletFilterBankType >;
+  constexpr unsigned int levels = 2;
+  constexpr unsigned int bands = 2;
+
+  auto forwardWavelet = ForwardWaveletType::New();
+  forwardWavelet->SetLevels(levels);
+  forwardWavelet->SetHighPassSubBands(bands);
+  forwardWavelet->SetInput(spectrum);
+  TEST_SET_GET_BOOLEAN( forwardWavelet, AutoSelectShrinkFilter, false );
+  forwardWavelet->Update();
+
+  auto forwardWaveletViaInverseFFT = ForwardWaveletViaInverseFFTType::New();
+  forwardWaveletViaInverseFFT->SetLevels(levels);
+  forwardWaveletViaInverseFFT->SetHighPassSubBands(bands);
+  forwardWaveletViaInverseFFT->SetInput(spectrum);
+  forwardWaveletViaInverseFFT->Update();
+
+  auto forwardWaveletAuto = ForwardWaveletType::New();
+  forwardWaveletAuto->SetLevels(levels);
+  forwardWaveletAuto->SetHighPassSubBands(bands);
+  forwardWaveletAuto->SetInput(spectrum);
+  forwardWaveletAuto->SetFrequencyResamplingSelector(selector);
+  TEST_EXPECT_TRUE( forwardWaveletAuto->GetModifiableFrequencyResamplingSelector() == selector.GetPointer() );
+  forwardWaveletAuto->AutoSelectShrinkFilterOn();
+  forwardWaveletAuto->Update();
+  // One choice per level.
+  TEST_EXPECT_EQUAL( selector->GetNumberOfEntries(), levels );
+
+  for ( unsigned int n = 0; n < forwardWavelet->GetNumberOfOutputs(); ++n )
+    {
+    const ComplexImageType * expected = forwardWavelet->GetOutput(n);
+    for ( const ComplexImageType * actual : { forwardWaveletViaInverseFFT->GetOutput(n),
+                                              forwardWaveletAuto->GetOutput(n) } )
+      {
+      TEST_EXPECT_EQUAL( actual->GetLargestPossibleRegion(), expected->GetLargestPossibleRegion() );
+      const double difference = itk::Testing::ComputeMaxAbsoluteDifference(expected, actual);
+      if ( difference > tolerance )
+        {
+        std::cerr << "Error. Output " << n << " of the forward wavelet differs: " << difference << std::endl;
+        testPassed = false;
+        }
+      }
+    }
+
+  auto inverseWavelet = InverseWaveletType::New();
+  inverseWavelet->SetLevels(levels);
+  inverseWavelet->SetHighPassSubBands(bands);
+  inverseWavelet->SetInputs(forwardWavelet->GetOutputs());
+  TEST_SET_GET_BOOLEAN( inverseWavelet, AutoSelectExpandFilter, false );
+  inverseWavelet->Update();
+
+  auto inverseWaveletAuto = InverseWaveletType::New();
+  inverseWaveletAuto->SetLevels(levels);
+  inverseWaveletAuto->SetHighPassSubBands(bands);
+  inverseWaveletAuto->SetInputs(forwardWavelet->GetOutputs());
+  inverseWaveletAuto->SetFrequencyResamplingSelector(selector);
+  inverseWaveletAuto->AutoSelectExpandFilterOn();
+  inverseWaveletAuto->Update();
+  TEST_EXPECT_EQUAL( selector->GetNumberOfEntries(), 2 * levels );
+
+  const double difference = itk::Testing::ComputeMaxAbsoluteDifference(inverseWavelet->GetOutput(),
+    inverseWaveletAuto->GetOutput());
+  if ( difference > tolerance )
+    {
+    std::cerr << "Error. The reconstruction with the automatic selection differs: " << difference << std::endl;
+    testPassed = false;
+    }
+
+  if ( !testPassed )
+    {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,138 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImage.h"
+#include "itkFrequencyShrinkMultiplyImageFilter.h"
+#include "itkFrequencyShrinkImageFilter.h"
+#include "itkFrequencyFilterBankMultiplyImageFilter.h"
+#include "itkIsotropicWaveletTestUtilities.h"
+#include "itkTestingMacros.h"
+
+#include <complex>
+
+namespace
+{
+template< typename TFilterBankImage, unsigned int VDimension >
+int
+runFrequencyShrinkMultiplyImageFilterTest(unsigned int sizeValue, unsigned int firstAxisFactor = 2,
+  unsigned int otherAxesFactor = 2)
+{
+  using ComplexImageType = itk::Image< std::complex< double >, VDimension >;
+  using MultiplyFilterType = itk::FrequencyFilterBankMultiplyImageFilter< ComplexImageType, TFilterBankImage >;
+  using ShrinkFilterType = itk::FrequencyShrinkImageFilter< ComplexImageType >;
+  using ShrinkMultiplyFilterType = itk::FrequencyShrinkMultiplyImageFilter< ComplexImageType, TFilterBankImage >;
+
+  typename ShrinkFilterType::ShrinkFactorsType shrinkFactors;
+  shrinkFactors.Fill(otherAxesFactor);
+  shrinkFactors[0] = firstAxisFactor;
+
+  typename ComplexImageType::SizeType size;
+  size.Fill(sizeValue);
+  typename ComplexImageType::SpacingType spacing;
+  spacing.Fill(0.5);
+  auto input = itk::Testing::MakeSyntheticSpectrum< ComplexImageType >(size);
+  input->SetSpacing(spacing);
+  // The filter bank has the same size, but default metadata.
+  auto filterBank = itk::Testing::MakeSyntheticFilterBank< TFilterBankImage >(size);
+
+  // Reference: multiply and shrink.
+  auto multiplyFilter = MultiplyFilterType::New();
+  multiplyFilter->SetInput1(input);
+  multiplyFilter->SetInput2(filterBank);
+  auto shrinkFilter = ShrinkFilterType::New();
+  shrinkFilter->SetInput(multiplyFilter->GetOutput());
+  shrinkFilter->SetShrinkFactors(shrinkFactors);
+  shrinkFilter->Update();
+
+  auto shrinkMultiplyFilter = ShrinkMultiplyFilterType::New();
+  shrinkMultiplyFilter->SetInput(input);
+  shrinkMultiplyFilter->SetFilterBank(filterBank);
+  shrinkMultiplyFilter->SetShrinkFactors(shrinkFactors);
+  TRY_EXPECT_NO_EXCEPTION( shrinkMultiplyFilter->Update() );
+
+  const ComplexImageType * expected = shrinkFilter->GetOutput();
+  const ComplexImageType * actual = shrinkMultiplyFilter->GetOutput();
+  TEST_EXPECT_EQUAL( actual->GetLargestPossibleRegion(), expected->GetLargestPossibleRegion() );
+  TEST_EXPECT_EQUAL( actual->GetSpacing(), expected->GetSpacing() );
+  TEST_EXPECT_EQUAL( actual->GetOrigin(), expected->GetOrigin() );
+
+  const double difference = itk::Testing::ComputeMaxAbsoluteDifference(expected, actual);
+  if ( difference > 1e-10 )
+    {
+    std::cerr << "Dimension " << VDimension << ", size " << sizeValue << ", factors " << shrinkFactors
+              << ": differs from FrequencyShrinkImageFilter by " << difference << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // The size of the filter bank has to match the input.
+  typename TFilterBankImage::SizeType wrongSize = size;
+  wrongSize[0] += 1;
+  shrinkMultiplyFilter->SetFilterBank(itk::Testing::MakeSyntheticFilterBank< TFilterBankImage >(wrongSize));
+  TRY_EXPECT_EXCEPTION( shrinkMultiplyFilter->Update() );
+
+  return EXIT_SUCCESS;
+}
+}
+
+int
+itkFrequencyShrinkMultiplyImageFilterTest( int, char *[] )
+{
+  constexpr unsigned int Dimension = 3;
+  using ComplexImageType = itk::Image< std::complex< double >, Dimension >;
+  using RealFilterBankImageType = itk::Image< double, Dimension >;
+  using ShrinkMultiplyFilterType = itk::FrequencyShrinkMultiplyImageFilter< ComplexImageType, RealFilterBankImageType >;
+
+  auto shrinkMultiplyFilter = ShrinkMultiplyFilterType::New();
+  EXERCISE_BASIC_OBJECT_METHODS( shrinkMultiplyFilter, FrequencyShrinkMultiplyImageFilter, ImageToImageFilter );
+
+  typename ShrinkMultiplyFilterType::ShrinkFactorsType shrinkFactors;
+  shrinkFactors.Fill(2);
+  TEST_SET_GET_VALUE( shrinkFactors, shrinkMultiplyFilter->GetShrinkFactors() );
+
+  int result = EXIT_SUCCESS;
+  for ( unsigned int sizeValue : { 8u, 9u } )
+    {
+    if ( runFrequencyShrinkMultiplyImageFilterTest< itk::Image< double, 2 >, 2 >(sizeValue) == EXIT_FAILURE )
+      {
+      result = EXIT_FAILURE;
+      }
+    if ( runFrequencyShrinkMultiplyImageFilterTest< RealFilterBankImageType, Dimension >(sizeValue) == EXIT_FAILURE )
+      {
+      result = EXIT_FAILURE;
+      }
+    if ( runFrequencyShrinkMultiplyImageFilterTest< ComplexImageType, Dimension >(sizeValue) == EXIT_FAILURE )
+      {
+      result = EXIT_FAILURE;
+      }
+    // Per-axis and non-dyadic factors: fold 3 regions in x and none in the other axes, and the opposite.
+    if ( runFrequencyShrinkMultiplyImageFilterTest< RealFilterBankImageType, Dimension >(sizeValue, 3, 1)
+         == EXIT_FAILURE )
+      {
+      result = EXIT_FAILURE;
+      }
+    if ( runFrequencyShrinkMultiplyImageFilterTest< ComplexImageType, Dimension >(sizeValue, 1, 3) == EXIT_FAILURE )
+      {
+      result = EXIT_FAILURE;
+      }
+    }
+
+  if ( result == EXIT_FAILURE )
+    {
+    std::cerr << "Test failed!" << std::endl;
+    }
+  return result;
+}
@@ -308,6 +308,53 @@ runFrequencyShrinkTest( const std::string & inputImage, const std::string & outp
     testPassed = false;
     }
 
+  // The band mask is applied to each alias while folding: same than running the band filter before the shrink.
+  typename ShrinkType::ShrinkFactorsType bandShrinkFactors;
+  bandShrinkFactors.Fill( 2 );
+  bandShrinkFactors[0] = 3;
+  using FrequencyBandFilterType = typename ShrinkType::FrequencyBandFilterType;
+  auto referenceBandFilter = FrequencyBandFilterType::New();
+  referenceBandFilter->SetInput( changeInputInfoFilter->GetOutput() );
+  referenceBandFilter->SetFrequencyThresholdsInRadians( 0.0, itk::Math::pi_over_2 );
+  referenceBandFilter->SetPassBand( true, true );
+  referenceBandFilter->SetPassNegativeHighFrequencyThreshold( false );
+  auto referenceShrinkFilter = ShrinkType::New();
+  referenceShrinkFilter->SetInput( referenceBandFilter->GetOutput() );
+  referenceShrinkFilter->SetShrinkFactors( bandShrinkFactors );
+  referenceShrinkFilter->Update();
+
+  auto shrinkInlineBandFilter = ShrinkType::New();
+  shrinkInlineBandFilter->SetInput( changeInputInfoFilter->GetOutput() );
+  shrinkInlineBandFilter->SetShrinkFactors( bandShrinkFactors );
+  shrinkInlineBandFilter->ApplyBandFilterOn();
+  shrinkInlineBandFilter->Update();
+
+  itk::ImageRegionConstIterator< ComplexImageType > referenceIt( referenceShrinkFilter->GetOutput(),
+    referenceShrinkFilter->GetOutput()->GetLargestPossibleRegion() );
+  itk::ImageRegionConstIterator< ComplexImageType > inlineBandIt( shrinkInlineBandFilter->GetOutput(),
+    shrinkInlineBandFilter->GetOutput()->GetLargestPossibleRegion() );
+  unsigned int bandDifferences = 0;
+  for ( referenceIt.GoToBegin(), inlineBandIt.GoToBegin(); !referenceIt.IsAtEnd(); ++referenceIt, ++inlineBandIt )
+    {
+    if ( std::abs( referenceIt.Get() - inlineBandIt.Get() ) > 1e-9 * ( 1.0 + std::abs( referenceIt.Get() ) ) )
+      {
+      ++bandDifferences;
+      }
+    }
+  if ( bandDifferences > 0 )
+    {
+    std::cerr << "Test failed! " << bandDifferences
+              << " differences between the inline band mask and FrequencyBandImageFilter." << std::endl;
+    testPassed = false;
+    }
+
+  // The band mask is not supported with the half hermitian layout.
+  auto shrinkHalfHermitianBandFilter = ShrinkType::New();
+  shrinkHalfHermitianBandFilter->SetInput( changeInputInfoFilter->GetOutput() );
+  shrinkHalfHermitianBandFilter->ApplyBandFilterOn();
+  shrinkHalfHermitianBandFilter->HalfHermitianOn();
+  TRY_EXPECT_EXCEPTION( shrinkHalfHermitianBandFilter->Update() );
+
   // Write output
   using FloatImageType = itk::Image< float, Dimension >;
   using CastType = itk::CastImageFilter< ImageType, FloatImageType >;
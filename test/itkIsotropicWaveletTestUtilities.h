@@ -20,6 +20,11 @@
 #define itkIsotropicWaveletTestUtilities_h
 #include <complex>
 #include <itkMathDetail.h>
+#include <itkImageRegionConstIterator.h>
+#include <itkImageRegionConstIteratorWithIndex.h>
+#include <itkImageRegionIteratorWithIndex.h>
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
 namespace itk
 {
@@ -92,6 +97,82 @@ ComplexImageIsHermitian(
     }
   return isHermitian;
 }
+
+/** Real image of the given size with a smooth pattern, not symmetric in any axis:
+ * sin(0.3 x) + cos(0.2 y + 0.1 z) + 0.01 x z, where z is the last axis. */
+template< typename TImage >
+typename TImage::Pointer
+MakeSyntheticImage(const typename TImage::SizeType & size)
+{
+  constexpr unsigned int LastAxis = TImage::ImageDimension - 1;
+  auto image = TImage::New();
+  image->SetRegions(size);
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex< TImage > imageIt(image, image->GetLargestPossibleRegion());
+  for ( imageIt.GoToBegin(); !imageIt.IsAtEnd(); ++imageIt )
+    {
+    const typename TImage::IndexType index = imageIt.GetIndex();
+    imageIt.Set(static_cast< typename TImage::PixelType >(std::sin(0.3 * index[0])
+        + std::cos(0.2 * index[1] + 0.1 * index[LastAxis]) + 0.01 * index[0] * index[LastAxis]));
+    }
+  return image;
+}
+
+/** Complex image of the given size used as a synthetic spectrum, without hermitian symmetry:
+ * sin(0.3 x + phase) + cos(0.2 y) + i sin(0.1 z + phase), where z is the last axis.
+ * Use different phases to get different images of the same size. */
+template< typename TComplexImage >
+typename TComplexImage::Pointer
+MakeSyntheticSpectrum(const typename TComplexImage::SizeType & size, double phase = 0.0)
+{
+  using PixelType = typename TComplexImage::PixelType;
+  constexpr unsigned int LastAxis = TComplexImage::ImageDimension - 1;
+  auto spectrum = TComplexImage::New();
+  spectrum->SetRegions(size);
+  spectrum->Allocate();
+  itk::ImageRegionIteratorWithIndex< TComplexImage > spectrumIt(spectrum, spectrum->GetLargestPossibleRegion());
+  for ( spectrumIt.GoToBegin(); !spectrumIt.IsAtEnd(); ++spectrumIt )
+    {
+    const typename TComplexImage::IndexType index = spectrumIt.GetIndex();
+    spectrumIt.Set(PixelType(std::sin(0.3 * index[0] + phase) + std::cos(0.2 * index[1]),
+        std::sin(0.1 * index[LastAxis] + phase)));
+    }
+  return spectrum;
+}
+
+/** Synthetic filter bank of the given size, real or complex: 1 / (offset + x + y), with offset > 0.
+ * Use different offsets to get different banks of the same size. */
+template< typename TFilterBankImage >
+typename TFilterBankImage::Pointer
+MakeSyntheticFilterBank(const typename TFilterBankImage::SizeType & size, double offset = 1.0)
+{
+  auto filterBank = TFilterBankImage::New();
+  filterBank->SetRegions(size);
+  filterBank->Allocate();
+  itk::ImageRegionIteratorWithIndex< TFilterBankImage > filterBankIt(filterBank,
+    filterBank->GetLargestPossibleRegion());
+  for ( filterBankIt.GoToBegin(); !filterBankIt.IsAtEnd(); ++filterBankIt )
+    {
+    const typename TFilterBankImage::IndexType index = filterBankIt.GetIndex();
+    filterBankIt.Set(static_cast< typename TFilterBankImage::PixelType >(1.0 / ( offset + index[0] + index[1] )));
+    }
+  return filterBank;
+}
+
+/** Maximum absolute difference between the pixels of two images with the same largest possible region. */
+template< typename TImage >
+double
+ComputeMaxAbsoluteDifference(const TImage * image1, const TImage * image2)
+{
+  double maxDifference = 0;
+  itk::ImageRegionConstIterator< TImage > it1(image1, image1->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator< TImage > it2(image2, image2->GetLargestPossibleRegion());
+  for ( it1.GoToBegin(), it2.GoToBegin(); !it1.IsAtEnd(); ++it1, ++it2 )
+    {
+    maxDifference = std::max(maxDifference, static_cast< double >( std::abs(it1.Get() - it2.Get()) ));
+    }
+  return maxDifference;
+}
 } // ns Testing
 } // ns itk
 #endif
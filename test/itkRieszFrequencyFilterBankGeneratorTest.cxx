@@ -23,6 +23,7 @@
 #include "itkComplexToRealImageFilter.h"
 #include "itkComplexToImaginaryImageFilter.h"
 #include "itkImageRegionConstIterator.h"
+#include "itkFrequencyFFTLayoutImageRegionIteratorWithIndex.h"
 #include "itkTestingMacros.h"
 
 #include <memory>
@@ -82,6 +83,29 @@ itkRieszFrequencyFilterBankGeneratorTest( int argc, char* argv[] )
 
   TRY_EXPECT_NO_EXCEPTION( filterBank->Update() );
 
+  // Compare the threaded generator with the evaluation of the RieszFunction at each frequency.
+  unsigned int differences = 0;
+  using FrequencyIteratorType = RieszFilterBankType::OutputRegionIterator;
+  FrequencyIteratorType frequencyIt( filterBank->GetOutput(), filterBank->GetOutput()->GetLargestPossibleRegion() );
+  for ( frequencyIt.GoToBegin(); !frequencyIt.IsAtEnd(); ++frequencyIt )
+    {
+    const RieszFilterBankType::RieszFunctionType::OutputComponentsType expected =
+      filterBank->GetModifiableEvaluator()->EvaluateAllComponents( frequencyIt.GetFrequency() );
+    for ( unsigned int comp = 0; comp < filterBank->GetNumberOfOutputs(); ++comp )
+      {
+      if ( std::abs( expected[comp] - filterBank->GetOutput( comp )->GetPixel( frequencyIt.GetIndex() ) ) > 1e-12 )
+        {
+        ++differences;
+        }
+      }
+    }
+  if ( differences > 0 )
+    {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The filter bank has " << differences << " differences with the RieszFunction." << std::endl;
+    return EXIT_FAILURE;
+    }
+
   // Get iterator to Indices of RieszFunction.
   using IndicesType = RieszFilterBankType::RieszFunctionType::SetType;
   IndicesType indices = filterBank->GetModifiableEvaluator()->GetIndices();
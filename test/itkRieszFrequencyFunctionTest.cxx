@@ -23,6 +23,7 @@
 #include "itkComplexToRealImageFilter.h"
 #include "itkTestingMacros.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <cmath>
@@ -129,6 +130,35 @@ runRieszFrequencyFunctionTest(unsigned int inputOrder)
           << " expected: " << expectedNumberOfComponents << " are not equal!" << std::endl;
       testPassed = false;
       }
+    // The cached indices are generated directly in the order of the set.
+    const auto & cachedIndices = itk::utils::GetAllPossibleIndices< VDimension >(order);
+    if ( cachedIndices.size() != allPermutations.size()
+         || !std::equal(allPermutations.begin(), allPermutations.end(), cachedIndices.begin()) )
+      {
+      std::cerr << "Error. GetAllPossibleIndices for order: " << order
+                << " differs from ComputeAllPermutations." << std::endl;
+      testPassed = false;
+      }
+    }
+
+  // Indices with order known at compile time.
+  constexpr unsigned int fixedOrder = 3;
+  using FixedIndicesTraits = itk::utils::RieszIndicesTraits< fixedOrder, VDimension >;
+  const typename FixedIndicesTraits::IndicesType & fixedIndices =
+    itk::utils::GetAllPossibleIndices< fixedOrder, VDimension >();
+  TEST_EXPECT_EQUAL( FixedIndicesTraits::NumberOfComponents,
+    RieszFrequencyFunctionType::ComputeNumberOfComponents(fixedOrder) );
+  const auto & fixedOrderIndices = itk::utils::GetAllPossibleIndices< VDimension >(fixedOrder);
+  for ( unsigned int comp = 0; comp < FixedIndicesTraits::NumberOfComponents; ++comp )
+    {
+    for ( unsigned int d = 0; d < Dimension; ++d )
+      {
+      if ( fixedIndices[comp][d] != fixedOrderIndices[comp][d] )
+        {
+        std::cerr << "Error. Compile time indices differ at component " << comp << std::endl;
+        testPassed = false;
+        }
+      }
     }
 
   // Evaluate All Components:
@@ -144,6 +174,34 @@ runRieszFrequencyFunctionTest(unsigned int inputOrder)
     }
   std::cout << std::endl;
 
+  // EvaluateAllComponents uses precomputed normalizing factors and a table of powers,
+  // compare with the direct evaluation of each component. Orders above 15 do not fit in the stack table.
+  InputType asymmetricPoint;
+  for ( unsigned int d = 0; d < Dimension; ++d )
+    {
+    asymmetricPoint[d] = 0.05 * ( d + 1 ) * ( d % 2 == 0 ? 1 : -1 );
+    }
+  for ( unsigned int order : { 1u, 2u, 3u, 5u, 16u } )
+    {
+    rieszFunction->SetOrder(order);
+    TEST_EXPECT_EQUAL( rieszFunction->GetNormalizingFactors().size(), rieszFunction->GetIndices().size() );
+    OutputComponentType components;
+    rieszFunction->EvaluateAllComponents(asymmetricPoint, components);
+    unsigned int comp = 0;
+    for ( const auto & index : rieszFunction->GetIndices() )
+      {
+      const OutputType expected = rieszFunction->EvaluateWithIndices(asymmetricPoint, index);
+      if ( std::abs(expected - components[comp]) > 1e-10 * ( 1.0 + std::abs(expected) ) )
+        {
+        std::cerr << "Error. EvaluateAllComponents with order " << order << ", component " << comp
+                  << ": actual: " << components[comp] << " expected: " << expected << std::endl;
+        testPassed = false;
+        }
+      ++comp;
+      }
+    }
+  rieszFunction->SetOrder(inputOrder);
+
   if ( testPassed )
     {
     std::cout << "Test Passed!" << std::endl;
@@ -20,6 +20,7 @@
 #include <complex>
 #include "itkImage.h"
 #include "itkImageDuplicator.h"
+#include "itkMultiplyImageFilter.h"
 #include "itkMath.h"
 #include "itkTestingComparisonImageFilter.h"
 
@@ -287,6 +288,24 @@ runRieszRotationMatrixTest()
   std::cout << "Matrix: Order 1" << std::endl;
   std::cout << S << std::endl;
 
+  // The table of terms is built once per order and shared.
+  constexpr unsigned int order4 = 4;
+  if ( SteerableMatrix::GetSteerableMatrixTermTable(order4) != SteerableMatrix::GetSteerableMatrixTermTable(order4) )
+    {
+    testPassed = false;
+    std::cerr << "The table of terms of order " << order4 << " is not cached." << std::endl;
+    }
+  SteerableMatrix S4(R, order4);
+  typename SteerableMatrix::InternalMatrixType S4multST = S4.GetVnlMatrix() * S4.GetTranspose();
+  identityMatrix = S4.GetVnlMatrix();
+  identityMatrix.set_identity();
+  if ( ( S4multST - identityMatrix ).absolute_value_max() > 1e-10 )
+    {
+    testPassed = false;
+    std::cerr << "Order " << order4 << ": S * S_transpose != identity" << std::endl;
+    std::cerr << S4multST << std::endl;
+    }
+
   // unsigned int highOrder = 10;
   // Sdefault.SetOrder(highOrder);
   // Sdefault.ComputeSteerableMatrix();
@@ -0,0 +1,178 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImage.h"
+#include "itkRieszSteeringImageFilter.h"
+#include "itkRieszRotationMatrix.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+
+namespace
+{
+template< unsigned int VDimension >
+int
+runRieszSteeringImageFilterTest(unsigned int order)
+{
+  using PixelType = double;
+  using ImageType = itk::Image< PixelType, VDimension >;
+  using SteeringFilterType = itk::RieszSteeringImageFilter< ImageType >;
+  using OrientationImageType = typename SteeringFilterType::OrientationImageType;
+  using RotationMatrixType = typename SteeringFilterType::SpatialRotationMatrixType;
+  using RieszRotationMatrixType = itk::RieszRotationMatrix< double, VDimension >;
+
+  bool testPassed = true;
+  const double tolerance = 1e-9;
+
+  auto steeringFilter = SteeringFilterType::New();
+  steeringFilter->SetOrder(order);
+  TEST_SET_GET_VALUE( order, steeringFilter->GetOrder() );
+  const unsigned int numberOfComponents = steeringFilter->GetNumberOfComponents();
+
+  typename ImageType::SizeType size;
+  size.Fill(6);
+
+  // Component images with different values at every pixel.
+  typename SteeringFilterType::InputsType inputs(numberOfComponents);
+  for ( unsigned int comp = 0; comp < numberOfComponents; ++comp )
+    {
+    inputs[comp] = ImageType::New();
+    inputs[comp]->SetRegions(size);
+    inputs[comp]->Allocate();
+    itk::ImageRegionIteratorWithIndex< ImageType > it(inputs[comp], inputs[comp]->GetLargestPossibleRegion());
+    for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+      {
+      const typename ImageType::IndexType index = it.GetIndex();
+      it.Set(std::sin(1.0 + comp + 0.7 * index[0]) + std::cos(0.3 * comp * index[VDimension - 1]));
+      }
+    }
+
+  // Orientation field varying per voxel, with a null direction at the origin.
+  auto orientation = OrientationImageType::New();
+  orientation->SetRegions(size);
+  orientation->Allocate();
+  itk::ImageRegionIteratorWithIndex< OrientationImageType > orientationIt(orientation,
+    orientation->GetLargestPossibleRegion());
+  for ( orientationIt.GoToBegin(); !orientationIt.IsAtEnd(); ++orientationIt )
+    {
+    const typename ImageType::IndexType index = orientationIt.GetIndex();
+    typename OrientationImageType::PixelType direction;
+    for ( unsigned int dim = 0; dim < VDimension; ++dim )
+      {
+      direction[dim] = index[dim] - 0.5 * dim * index[( dim + 1 ) % VDimension];
+      }
+    orientationIt.Set(direction);
+    }
+
+  // The number of inputs has to match the order.
+  steeringFilter->SetOrientation(orientation);
+  steeringFilter->SetInput(inputs[0]);
+  if ( numberOfComponents > 1 )
+    {
+    TRY_EXPECT_EXCEPTION( steeringFilter->Update() );
+    }
+
+  steeringFilter->SetInputs(inputs);
+  TRY_EXPECT_NO_EXCEPTION( steeringFilter->Update() );
+
+  unsigned int differences = 0;
+  for ( orientationIt.GoToBegin(); !orientationIt.IsAtEnd(); ++orientationIt )
+    {
+    const typename ImageType::IndexType index = orientationIt.GetIndex();
+    const typename OrientationImageType::PixelType direction = orientationIt.Get();
+    const RotationMatrixType rotation = SteeringFilterType::ComputeRotationMatrixFromDirection(direction);
+
+    // Rotation with the normalized direction as first row.
+    const double norm = direction.GetNorm();
+    for ( unsigned int dim = 0; dim < VDimension && norm > 0; ++dim )
+      {
+      if ( std::abs(rotation[0][dim] - direction[dim] / norm) > tolerance )
+        {
+        std::cerr << "Rotation at " << index << " does not have the direction as first row." << std::endl;
+        testPassed = false;
+        }
+      }
+    const RotationMatrixType identity = rotation * RotationMatrixType(rotation.GetTranspose());
+    for ( unsigned int r = 0; r < VDimension; ++r )
+      {
+      for ( unsigned int c = 0; c < VDimension; ++c )
+        {
+        if ( std::abs(identity[r][c] - ( r == c ? 1.0 : 0.0 )) > tolerance )
+          {
+          std::cerr << "Rotation at " << index << " is not orthonormal: " << rotation << std::endl;
+          testPassed = false;
+          }
+        }
+      }
+
+    RieszRotationMatrixType steerableMatrix(rotation, order);
+    for ( unsigned int n = 0; n < numberOfComponents; ++n )
+      {
+      double expected = 0;
+      for ( unsigned int m = 0; m < numberOfComponents; ++m )
+        {
+        expected += steerableMatrix.GetVnlMatrix()(n, m) * inputs[m]->GetPixel(index);
+        }
+      const double actual = steeringFilter->GetOutput(n)->GetPixel(index);
+      if ( std::abs(expected - actual) > tolerance * ( 1.0 + std::abs(expected) ) )
+        {
+        ++differences;
+        }
+      }
+    }
+  if ( differences > 0 )
+    {
+    std::cerr << "Order " << order << ", dimension " << VDimension << ": " << differences
+              << " differences with RieszRotationMatrix." << std::endl;
+    testPassed = false;
+    }
+
+  return testPassed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+}
+
+int
+itkRieszSteeringImageFilterTest( int, char *[] )
+{
+  constexpr unsigned int Dimension = 3;
+  using ImageType = itk::Image< double, Dimension >;
+  using SteeringFilterType = itk::RieszSteeringImageFilter< ImageType >;
+
+  auto steeringFilter = SteeringFilterType::New();
+  EXERCISE_BASIC_OBJECT_METHODS( steeringFilter, RieszSteeringImageFilter, ImageToImageFilter );
+  TRY_EXPECT_EXCEPTION( steeringFilter->SetOrder(0) );
+
+  int result = EXIT_SUCCESS;
+  for ( unsigned int order = 1; order < 4; ++order )
+    {
+    if ( runRieszSteeringImageFilterTest< 2 >(order) == EXIT_FAILURE )
+      {
+      result = EXIT_FAILURE;
+      }
+    if ( runRieszSteeringImageFilterTest< Dimension >(order) == EXIT_FAILURE )
+      {
+      result = EXIT_FAILURE;
+      }
+    }
+
+  if ( result == EXIT_FAILURE )
+    {
+    std::cerr << "Test failed!" << std::endl;
+    }
+  return result;
+}
@@ -0,0 +1,222 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImage.h"
+#include "itkWaveletFilterBankCache.h"
+#include "itkWaveletFrequencyForward.h"
+#include "itkWaveletFrequencyInverse.h"
+#include "itkWaveletFrequencyFilterBankGenerator.h"
+#include "itkHeldIsotropicWavelet.h"
+#include "itkIsotropicWaveletTestUtilities.h"
+#include "itkTestingMacros.h"
+
+#include <complex>
+#include <functional>
+#include <thread>
+
+int
+itkWaveletFilterBankCacheTest( int, char *[] )
+{
+  constexpr unsigned int Dimension = 3;
+  using PixelType = double;
+  using ComplexImageType = itk::Image< std::complex< PixelType >, Dimension >;
+  using WaveletFunctionType = itk::HeldIsotropicWavelet< PixelType, Dimension >;
+  using WaveletFilterBankType = itk::WaveletFrequencyFilterBankGenerator< ComplexImageType, WaveletFunctionType >;
+  using ForwardWaveletType = itk::WaveletFrequencyForward< ComplexImageType, ComplexImageType, WaveletFilterBankType >;
+  using InverseWaveletType = itk::WaveletFrequencyInverse< ComplexImageType, ComplexImageType, WaveletFilterBankType >;
+  using CacheType = itk::WaveletFilterBankCache< ComplexImageType >;
+
+  auto cache = CacheType::New();
+  EXERCISE_BASIC_OBJECT_METHODS( cache, WaveletFilterBankCache, Object );
+
+  ComplexImageType::SizeType size;
+  size.Fill(32);
+  auto input = itk::Testing::MakeSyntheticSpectrum< ComplexImageType >(size);
+
+  const unsigned int levels = 2;
+  const unsigned int highSubBands = 2;
+
+  auto forwardReference = ForwardWaveletType::New();
+  forwardReference->SetLevels(levels);
+  forwardReference->SetHighPassSubBands(highSubBands);
+  forwardReference->SetInput(input);
+  forwardReference->Update();
+
+  bool testPassed = true;
+  for ( unsigned int run = 0; run < 2; ++run )
+    {
+    auto forwardWavelet = ForwardWaveletType::New();
+    forwardWavelet->SetLevels(levels);
+    forwardWavelet->SetHighPassSubBands(highSubBands);
+    TEST_SET_GET_BOOLEAN(forwardWavelet, UseWaveletFilterBankCache, false);
+    forwardWavelet->UseWaveletFilterBankCacheOn();
+    forwardWavelet->SetWaveletFilterBankCache(cache);
+    TEST_SET_GET_VALUE( cache.GetPointer(), forwardWavelet->GetModifiableWaveletFilterBankCache() );
+    forwardWavelet->SetInput(input);
+    forwardWavelet->Update();
+
+    for ( unsigned int nOutput = 0; nOutput < forwardWavelet->GetTotalOutputs(); ++nOutput )
+      {
+      if ( itk::Testing::ComputeMaxAbsoluteDifference(forwardReference->GetOutput(nOutput),
+        forwardWavelet->GetOutput(nOutput)) != 0.0 )
+        {
+        std::cerr << "Run " << run << ": output " << nOutput << " differs from the non-cached transform." << std::endl;
+        testPassed = false;
+        }
+      }
+    }
+
+  // One bank per level: misses in the first run, hits in the second.
+  TEST_EXPECT_EQUAL( cache->GetNumberOfEntries(), static_cast< itk::SizeValueType >(levels) );
+  TEST_EXPECT_EQUAL( cache->GetNumberOfMisses(), static_cast< itk::SizeValueType >(levels) );
+  TEST_EXPECT_EQUAL( cache->GetNumberOfHits(), static_cast< itk::SizeValueType >(levels) );
+
+  // A different wavelet parameter is a different bank.
+  auto forwardOtherOrder = ForwardWaveletType::New();
+  forwardOtherOrder->SetLevels(levels);
+  forwardOtherOrder->SetHighPassSubBands(highSubBands);
+  forwardOtherOrder->GetModifiableWaveletFunction()->SetPolynomialOrder(3);
+  forwardOtherOrder->UseWaveletFilterBankCacheOn();
+  forwardOtherOrder->SetWaveletFilterBankCache(cache);
+  forwardOtherOrder->SetInput(input);
+  forwardOtherOrder->Update();
+  TEST_EXPECT_EQUAL( cache->GetNumberOfEntries(), static_cast< itk::SizeValueType >(2 * levels) );
+  TEST_EXPECT_EQUAL( cache->GetNumberOfMisses(), static_cast< itk::SizeValueType >(2 * levels) );
+
+  // Inverse with and without cache.
+  auto inverseReference = InverseWaveletType::New();
+  inverseReference->SetLevels(levels);
+  inverseReference->SetHighPassSubBands(highSubBands);
+  inverseReference->SetInputs(forwardReference->GetOutputs());
+  inverseReference->Update();
+  for ( unsigned int run = 0; run < 2; ++run )
+    {
+    auto inverseWavelet = InverseWaveletType::New();
+    inverseWavelet->SetLevels(levels);
+    inverseWavelet->SetHighPassSubBands(highSubBands);
+    inverseWavelet->UseWaveletFilterBankCacheOn();
+    inverseWavelet->SetWaveletFilterBankCache(cache);
+    inverseWavelet->SetInputs(forwardReference->GetOutputs());
+    inverseWavelet->Update();
+    if ( itk::Testing::ComputeMaxAbsoluteDifference(inverseReference->GetOutput(), inverseWavelet->GetOutput()) != 0.0 )
+      {
+      std::cerr << "Run " << run << ": inverse differs from the non-cached transform." << std::endl;
+      testPassed = false;
+      }
+    }
+
+  // The users of the cache get their own images, sharing the cached buffers:
+  // releasing their data, as a consumer with ReleaseDataFlag does, keeps the cached bank.
+  CacheType::BankType releasedBank;
+  const auto levelZeroKey = CacheType::MakeKey(forwardReference->GetModifiableWaveletFilterBank(), size, 0);
+  TEST_EXPECT_TRUE( cache->Find(levelZeroKey, releasedBank) );
+  CacheType::BankType otherBank;
+  TEST_EXPECT_TRUE( cache->Find(levelZeroKey, otherBank) );
+  TEST_EXPECT_TRUE( releasedBank[0] != otherBank[0] );
+  TEST_EXPECT_TRUE( releasedBank[0]->GetBufferPointer() == otherBank[0]->GetBufferPointer() );
+  for ( auto & image : releasedBank )
+    {
+    image->ReleaseData();
+    }
+  TEST_EXPECT_TRUE( cache->Find(levelZeroKey, otherBank) );
+  for ( const auto & image : otherBank )
+    {
+    TEST_EXPECT_EQUAL( image->GetBufferedRegion(), image->GetLargestPossibleRegion() );
+    TEST_EXPECT_TRUE( image->GetBufferPointer() != nullptr );
+    }
+
+  // Transforms running concurrently on the same cache, each with its own view of the input.
+  auto concurrentCache = CacheType::New();
+  auto runTransforms = [&](bool & transformsAreEqual)
+    {
+    transformsAreEqual = true;
+    try
+      {
+      for ( unsigned int run = 0; run < 3; ++run )
+        {
+        auto inputView = ComplexImageType::New();
+        inputView->Graft(input);
+        auto forwardWavelet = ForwardWaveletType::New();
+        forwardWavelet->SetLevels(levels);
+        forwardWavelet->SetHighPassSubBands(highSubBands);
+        forwardWavelet->UseWaveletFilterBankCacheOn();
+        forwardWavelet->SetWaveletFilterBankCache(concurrentCache);
+        forwardWavelet->SetInput(inputView);
+        forwardWavelet->Update();
+        for ( unsigned int nOutput = 0; nOutput < forwardWavelet->GetTotalOutputs(); ++nOutput )
+          {
+          transformsAreEqual &= itk::Testing::ComputeMaxAbsoluteDifference(forwardReference->GetOutput(nOutput),
+            forwardWavelet->GetOutput(nOutput)) == 0.0;
+          }
+
+        auto inverseWavelet = InverseWaveletType::New();
+        inverseWavelet->SetLevels(levels);
+        inverseWavelet->SetHighPassSubBands(highSubBands);
+        inverseWavelet->UseWaveletFilterBankCacheOn();
+        inverseWavelet->SetWaveletFilterBankCache(concurrentCache);
+        inverseWavelet->SetInputs(forwardWavelet->GetOutputs());
+        inverseWavelet->Update();
+        transformsAreEqual &= itk::Testing::ComputeMaxAbsoluteDifference(inverseReference->GetOutput(),
+          inverseWavelet->GetOutput()) == 0.0;
+        }
+      }
+    catch ( itk::ExceptionObject & error )
+      {
+      std::cerr << error << std::endl;
+      transformsAreEqual = false;
+      }
+    };
+  bool firstTransformsAreEqual = false;
+  bool secondTransformsAreEqual = false;
+  std::thread firstThread(runTransforms, std::ref(firstTransformsAreEqual));
+  std::thread secondThread(runTransforms, std::ref(secondTransformsAreEqual));
+  firstThread.join();
+  secondThread.join();
+  if ( !firstTransformsAreEqual || !secondTransformsAreEqual )
+    {
+    std::cerr << "Concurrent transforms sharing the cache differ from the non-cached transforms." << std::endl;
+    testPassed = false;
+    }
+  // Forward and inverse banks of each level.
+  TEST_EXPECT_EQUAL( concurrentCache->GetNumberOfEntries(), static_cast< itk::SizeValueType >(2 * levels) );
+  TEST_EXPECT_TRUE( concurrentCache->GetNumberOfHits() > 0 );
+
+  // Eviction: least recently used entries are removed first.
+  cache->ResetStatistics();
+  TEST_EXPECT_EQUAL( cache->GetNumberOfHits(), static_cast< itk::SizeValueType >(0) );
+  cache->SetMaximumNumberOfEntries(1);
+  TEST_EXPECT_EQUAL( cache->GetMaximumNumberOfEntries(), static_cast< itk::SizeValueType >(1) );
+  TEST_EXPECT_EQUAL( cache->GetNumberOfEntries(), static_cast< itk::SizeValueType >(1) );
+  TEST_EXPECT_TRUE( cache->GetNumberOfEvictions() > 0 );
+  cache->SetMaximumSizeInBytes(0);
+  TEST_EXPECT_EQUAL( cache->GetNumberOfEntries(), static_cast< itk::SizeValueType >(0) );
+  TEST_EXPECT_EQUAL( cache->GetSizeInBytes(), static_cast< itk::SizeValueType >(0) );
+
+  cache->Clear();
+  TEST_EXPECT_EQUAL( cache->GetNumberOfEntries(), static_cast< itk::SizeValueType >(0) );
+
+  // Process-wide instance.
+  TEST_EXPECT_TRUE( CacheType::GetInstance() == CacheType::GetInstance() );
+
+  if ( !testPassed )
+    {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+    }
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
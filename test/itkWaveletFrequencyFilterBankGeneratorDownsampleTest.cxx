@@ -22,6 +22,7 @@
 #include "itkWaveletFrequencyFilterBankGenerator.h"
 #include "itkFrequencyShrinkImageFilter.h"
 #include "itkFrequencyShrinkViaInverseFFTImageFilter.h"
+#include "itkShrinkDecimateImageFilter.h"
 #include "itkHeldIsotropicWavelet.h"
 #include "itkVowIsotropicWavelet.h"
 #include "itkSimoncelliIsotropicWavelet.h"
@@ -94,9 +95,44 @@ runWaveletFrequencyFilterBankGeneratorDownsampleTest( const std::string& inputIm
     {
     halfSize[i] = itk::Math::Floor< itk::SizeValueType >(inputSize[i] / static_cast< double >(shrinkFactor));
     }
+  // Share the wavelet function, as WaveletFrequencyForward does to generate the banks of each level.
+  forwardFilterBankDown->SetWaveletFunction(forwardFilterBank->GetModifiableWaveletFunction());
+  TEST_EXPECT_TRUE( forwardFilterBankDown->GetModifiableWaveletFunction()
+    == forwardFilterBank->GetModifiableWaveletFunction() );
   forwardFilterBankDown->SetSize(halfSize);
   forwardFilterBankDown->Update();
 
+  // The bank generated at half size equals the decimation of the bank when the size is even.
+  bool evenSize = true;
+  for ( unsigned int i = 0; i < Dimension; ++i )
+    {
+    evenSize = evenSize && ( inputSize[i] % shrinkFactor == 0 );
+    }
+  if ( evenSize )
+    {
+    using DecimateFilterType = itk::ShrinkDecimateImageFilter< ComplexImageType, ComplexImageType >;
+    for ( unsigned int bankOutput = 0; bankOutput < highSubBands + 1; ++bankOutput )
+      {
+      auto decimateFilter = DecimateFilterType::New();
+      decimateFilter->SetInput(forwardFilterBank->GetOutput(bankOutput));
+      decimateFilter->SetShrinkFactors(shrinkFactor);
+      decimateFilter->Update();
+      const ComplexImageType * decimated = decimateFilter->GetOutput();
+      const ComplexImageType * generated = forwardFilterBankDown->GetOutput(bankOutput);
+      itk::ImageRegionConstIterator< ComplexImageType > decimatedIt(decimated, decimated->GetLargestPossibleRegion());
+      itk::ImageRegionConstIterator< ComplexImageType > generatedIt(generated, generated->GetLargestPossibleRegion());
+      for ( decimatedIt.GoToBegin(), generatedIt.GoToBegin(); !decimatedIt.IsAtEnd(); ++decimatedIt, ++generatedIt )
+        {
+        if ( std::abs(decimatedIt.Get() - generatedIt.Get()) > 1e-6 )
+          {
+          std::cerr << "Error. Bank " << bankOutput << " generated at half size differs from the decimated bank: "
+                    << generatedIt.Get() << " vs " << decimatedIt.Get() << std::endl;
+          return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+
   // Compare Images
 #ifdef ITK_VISUALIZE_TESTS
   using ComplexToRealFilter = itk::ComplexToRealImageFilter< ComplexImageType, ImageType >;
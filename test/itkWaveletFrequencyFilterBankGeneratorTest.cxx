@@ -169,6 +169,68 @@ runWaveletFrequencyFilterBankGeneratorTest( const std::string& inputImage,
     std::cout << "No comparison errors: " << ne << " errors" << std::endl;
     }
 
+  // Radial lookup table: compare against the exact evaluation.
+  auto lookupTableFilterBank = WaveletFilterBankType::New();
+  TEST_SET_GET_BOOLEAN(lookupTableFilterBank, UseRadialLookupTable, false);
+  lookupTableFilterBank->SetUseRadialLookupTable( true );
+  const unsigned int radialLookupTableSize = 8192;
+  lookupTableFilterBank->SetRadialLookupTableSize( radialLookupTableSize );
+  TEST_SET_GET_VALUE( radialLookupTableSize, lookupTableFilterBank->GetRadialLookupTableSize() );
+  lookupTableFilterBank->SetHighPassSubBands( highSubBands );
+  lookupTableFilterBank->SetSize( fftFilter->GetOutput()->GetLargestPossibleRegion().GetSize() );
+  lookupTableFilterBank->Update();
+
+  // Shannon is discontinuous: the interpolation of the table differs from the exact evaluation in the bins
+  // with a discontinuity within one step of the table of their radius. Any other difference is an error.
+  const bool isContinuous = std::string( waveletInstance->GetNameOfClass() ) != "ShannonIsotropicWavelet";
+  const typename ComplexImageType::SpacingType & bankSpacing = forwardFilterBank->GetOutput(0)->GetSpacing();
+  double maxFrequencyModuloSquare = 0;
+  for ( unsigned int dim = 0; dim < Dimension; ++dim )
+    {
+    maxFrequencyModuloSquare += 0.25 / ( bankSpacing[dim] * bankSpacing[dim] );
+    }
+  const double lookupTableStep = std::sqrt(maxFrequencyModuloSquare) / ( radialLookupTableSize - 1 );
+  using FrequencyIteratorType = typename WaveletFilterBankType::OutputRegionIterator;
+  const double tolerance = 1e-4;
+  unsigned int neLookupTable = 0;
+  unsigned int discontinuousBins = 0;
+  for ( unsigned int i = 0; i < highSubBands + 1; ++i )
+    {
+    auto outExact = forwardFilterBank->GetOutput(i);
+    auto outLookupTable = lookupTableFilterBank->GetOutput(i);
+    ComplexConstRegionIterator itExact(outExact, outExact->GetLargestPossibleRegion() );
+    ComplexConstRegionIterator itLookupTable(outLookupTable, outLookupTable->GetLargestPossibleRegion() );
+    FrequencyIteratorType frequencyIt(outExact, outExact->GetLargestPossibleRegion() );
+    for ( itExact.GoToBegin(), itLookupTable.GoToBegin(), frequencyIt.GoToBegin(); !itExact.IsAtEnd();
+          ++itExact, ++itLookupTable, ++frequencyIt )
+      {
+      if ( std::abs( itExact.Get() - itLookupTable.Get() ) <= tolerance )
+        {
+        continue;
+        }
+      if ( !isContinuous )
+        {
+        const double w = std::sqrt( frequencyIt.GetFrequencyModuloSquare() );
+        const auto valueAtW = waveletInstance->EvaluateForwardSubBand( w, i );
+        if ( waveletInstance->EvaluateForwardSubBand( w - lookupTableStep, i ) != valueAtW
+             || waveletInstance->EvaluateForwardSubBand( w + lookupTableStep, i ) != valueAtW )
+          {
+          ++discontinuousBins;
+          continue;
+          }
+        }
+      ++neLookupTable;
+      }
+    }
+
+  if ( neLookupTable > 0 )
+    {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Radial lookup table comparison error: number of errors: " << neLookupTable << std::endl;
+    return EXIT_FAILURE;
+    }
+  std::cout << "Radial lookup table differences next to a discontinuity: " << discontinuousBins << std::endl;
+
   return EXIT_SUCCESS;
 }
 
@@ -25,12 +25,15 @@
 #include "itkVowIsotropicWavelet.h"
 #include "itkSimoncelliIsotropicWavelet.h"
 #include "itkShannonIsotropicWavelet.h"
+#include "itkImageRegionConstIterator.h"
 #include "itkForwardFFTImageFilter.h"
 #include "itkInverseFFTImageFilter.h"
 #include "itkComplexToRealImageFilter.h"
 #include "itkNumberToString.h"
+#include "itkThreadPool.h"
 #include "itkTestingMacros.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <cmath>
@@ -138,6 +141,168 @@ int runWaveletFrequencyForwardTest( const std::string& inputImage,
     std::cout << "InputIndex: " << i << " --> lv:" << lv << " b:" << b << std::endl;
     }
 
+  // GetScaleFactor is only defined when all the axes share the factor.
+  TEST_EXPECT_EQUAL( forwardWavelet->GetScaleFactor(), 2u );
+  auto anisotropicWavelet = ForwardWaveletType::New();
+  typename ForwardWaveletType::ScaleFactorsType anisotropicFactors;
+  anisotropicFactors.Fill(2);
+  anisotropicFactors[Dimension - 1] = 1;
+  anisotropicWavelet->SetScaleFactors(anisotropicFactors);
+  TRY_EXPECT_EXCEPTION( anisotropicWavelet->GetScaleFactor() );
+  // Factors larger than 2 alias the low pass.
+  TRY_EXPECT_EXCEPTION( anisotropicWavelet->SetScaleFactor(3) );
+  anisotropicFactors[0] = 5;
+  TRY_EXPECT_EXCEPTION( anisotropicWavelet->SetScaleFactors(anisotropicFactors) );
+
+  // Streaming mode: the bands handed to the callback are equal to the stored outputs.
+  for ( unsigned int onTheFly = 0; onTheFly < 2; ++onTheFly )
+    {
+    auto referenceWavelet = ForwardWaveletType::New();
+    referenceWavelet->SetHighPassSubBands( highSubBands );
+    referenceWavelet->SetLevels(levels);
+    referenceWavelet->SetComputeFilterBankOnTheFly(onTheFly == 1);
+    referenceWavelet->SetInput(fftFilter->GetOutput());
+    referenceWavelet->Update();
+
+    auto streamingWavelet = ForwardWaveletType::New();
+    streamingWavelet->SetHighPassSubBands( highSubBands );
+    streamingWavelet->SetLevels(levels);
+    streamingWavelet->SetComputeFilterBankOnTheFly(onTheFly == 1);
+    streamingWavelet->SetInput(fftFilter->GetOutput());
+    unsigned int streamedBands = 0;
+    unsigned int streamedDifferences = 0;
+    streamingWavelet->SetBandCallback(
+      [&](unsigned int level, unsigned int band, const ComplexImageType * bandImage)
+      {
+        ++streamedBands;
+        const ComplexImageType * expected = referenceWavelet->GetOutput(level * highSubBands + band);
+        if ( bandImage->GetLargestPossibleRegion() != expected->GetLargestPossibleRegion() )
+          {
+          ++streamedDifferences;
+          return;
+          }
+        itk::ImageRegionConstIterator< ComplexImageType > bandIt(bandImage, bandImage->GetLargestPossibleRegion());
+        itk::ImageRegionConstIterator< ComplexImageType > expectedIt(expected, expected->GetLargestPossibleRegion());
+        for ( bandIt.GoToBegin(), expectedIt.GoToBegin(); !bandIt.IsAtEnd(); ++bandIt, ++expectedIt )
+          {
+          if ( bandIt.Get() != expectedIt.Get() )
+            {
+            ++streamedDifferences;
+            return;
+            }
+          }
+      });
+    TRY_EXPECT_NO_EXCEPTION( streamingWavelet->Update() );
+    TEST_EXPECT_EQUAL( streamedBands, levels * highSubBands );
+    if ( streamedDifferences > 0 )
+      {
+      std::cerr << "Error in streaming mode (ComputeFilterBankOnTheFly: " << onTheFly << "): "
+                << streamedDifferences << " bands differ from the outputs." << std::endl;
+      testPassed = false;
+      }
+    }
+
+  // Number of outputs of waveletToCompare different than the outputs of referenceWavelet.
+  auto countDifferentOutputs = [](const ForwardWaveletType * referenceWavelet,
+    const ForwardWaveletType * waveletToCompare) -> unsigned int
+    {
+    unsigned int differentOutputs = 0;
+    for ( unsigned int i = 0; i < referenceWavelet->GetNumberOfOutputs(); ++i )
+      {
+      const ComplexImageType * expected = referenceWavelet->GetOutput(i);
+      const ComplexImageType * actual = waveletToCompare->GetOutput(i);
+      if ( actual->GetLargestPossibleRegion() != expected->GetLargestPossibleRegion() )
+        {
+        ++differentOutputs;
+        continue;
+        }
+      itk::ImageRegionConstIterator< ComplexImageType > actualIt(actual, actual->GetLargestPossibleRegion());
+      itk::ImageRegionConstIterator< ComplexImageType > expectedIt(expected, expected->GetLargestPossibleRegion());
+      for ( actualIt.GoToBegin(), expectedIt.GoToBegin(); !actualIt.IsAtEnd(); ++actualIt, ++expectedIt )
+        {
+        if ( actualIt.Get() != expectedIt.Get() )
+          {
+          ++differentOutputs;
+          break;
+          }
+        }
+      }
+    return differentOutputs;
+    };
+
+  // Task parallel mode: same outputs than the serial execution.
+  auto taskParallelWavelet = ForwardWaveletType::New();
+  taskParallelWavelet->SetHighPassSubBands( highSubBands );
+  taskParallelWavelet->SetLevels(levels);
+  taskParallelWavelet->UseTaskParallelismOn();
+  TEST_EXPECT_TRUE( taskParallelWavelet->GetUseTaskParallelism() );
+  taskParallelWavelet->SetInput(fftFilter->GetOutput());
+  TRY_EXPECT_NO_EXCEPTION( taskParallelWavelet->Update() );
+  unsigned int taskParallelDifferences = countDifferentOutputs(forwardWavelet, taskParallelWavelet);
+  if ( taskParallelDifferences > 0 )
+    {
+    std::cerr << "Error in task parallel mode: " << taskParallelDifferences
+              << " outputs differ from the serial execution." << std::endl;
+    testPassed = false;
+    }
+
+  // Task parallel mode with more concurrent band tasks and pool threads, repeated
+  // to exercise the scratch buffers of the bands from different threads.
+  const unsigned int concurrentBands = std::max(highSubBands, 5u);
+  auto serialManyBandsWavelet = ForwardWaveletType::New();
+  serialManyBandsWavelet->SetHighPassSubBands( concurrentBands );
+  serialManyBandsWavelet->SetLevels(levels);
+  serialManyBandsWavelet->SetInput(fftFilter->GetOutput());
+  TRY_EXPECT_NO_EXCEPTION( serialManyBandsWavelet->Update() );
+  itk::ThreadPool * threadPool = itk::ThreadPool::GetInstance();
+  for ( itk::ThreadIdType poolThreads : { 2u, 4u, 8u } )
+    {
+    if ( threadPool->GetMaximumNumberOfThreads() < poolThreads )
+      {
+      threadPool->AddThreads(poolThreads - threadPool->GetMaximumNumberOfThreads());
+      }
+    for ( unsigned int repetition = 0; repetition < 3; ++repetition )
+      {
+      auto taskManyBandsWavelet = ForwardWaveletType::New();
+      taskManyBandsWavelet->SetHighPassSubBands( concurrentBands );
+      taskManyBandsWavelet->SetLevels(levels);
+      taskManyBandsWavelet->UseTaskParallelismOn();
+      taskManyBandsWavelet->SetInput(fftFilter->GetOutput());
+      TRY_EXPECT_NO_EXCEPTION( taskManyBandsWavelet->Update() );
+      const unsigned int differentOutputs = countDifferentOutputs(serialManyBandsWavelet, taskManyBandsWavelet);
+      if ( differentOutputs > 0 )
+        {
+        std::cerr << "Error in task parallel mode with " << concurrentBands << " bands and "
+                  << threadPool->GetMaximumNumberOfThreads() << " pool threads (repetition " << repetition
+                  << "): " << differentOutputs << " outputs differ from the serial execution." << std::endl;
+        testPassed = false;
+        }
+      }
+    }
+
+  // The outputs are stored in the arena of the pyramid by default.
+  TEST_EXPECT_TRUE( forwardWavelet->GetUseContiguousPyramid() );
+  TEST_EXPECT_EQUAL( forwardWavelet->GetPyramid()->GetNumberOfImages(), forwardWavelet->GetNumberOfOutputs() );
+  for ( unsigned int i = 0; i < forwardWavelet->GetNumberOfOutputs(); ++i )
+    {
+    TEST_EXPECT_TRUE( forwardWavelet->GetOutput(i)->GetBufferPointer()
+      == forwardWavelet->GetPyramid()->GetImage(i)->GetBufferPointer() );
+    }
+  auto separateOutputsWavelet = ForwardWaveletType::New();
+  separateOutputsWavelet->SetHighPassSubBands( highSubBands );
+  separateOutputsWavelet->SetLevels(levels);
+  separateOutputsWavelet->UseContiguousPyramidOff();
+  separateOutputsWavelet->SetInput(fftFilter->GetOutput());
+  TRY_EXPECT_NO_EXCEPTION( separateOutputsWavelet->Update() );
+  TEST_EXPECT_EQUAL( separateOutputsWavelet->GetPyramid()->GetNumberOfImages(), 0u );
+  unsigned int separateOutputsDifferences = countDifferentOutputs(forwardWavelet, separateOutputsWavelet);
+  if ( separateOutputsDifferences > 0 )
+    {
+    std::cerr << "Error with UseContiguousPyramidOff: " << separateOutputsDifferences
+              << " outputs differ from the contiguous pyramid." << std::endl;
+    testPassed = false;
+    }
+
   // Inverse FFT Transform (Multilevel)
   using InverseFFTFilterType = itk::InverseFFTImageFilter< ComplexImageType, ImageType >;
   auto inverseFFT = InverseFFTFilterType::New();
@@ -0,0 +1,308 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImage.h"
+#include "itkForwardFFTImageFilter.h"
+#include "itkRealToHalfHermitianForwardFFTImageFilter.h"
+#include "itkHalfHermitianToRealInverseFFTImageFilter.h"
+#include "itkFrequencyHalfHermitianFFTLayoutImageRegionIteratorWithIndex.h"
+#include "itkFrequencyShrinkImageFilter.h"
+#include "itkFrequencyExpandImageFilter.h"
+#include "itkWaveletFrequencyFilterBankGenerator.h"
+#include "itkWaveletFrequencyForward.h"
+#include "itkWaveletFrequencyInverse.h"
+#include "itkHeldIsotropicWavelet.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+#include <complex>
+#include <string>
+
+namespace
+{
+/** Count the bins of the half spectrum that differ from the same bins of the full spectrum. */
+template< typename TImage >
+unsigned int
+CountHalfDifferences(const TImage * fullImage, const TImage * halfImage, double tolerance)
+{
+  unsigned int differences = 0;
+  itk::ImageRegionConstIteratorWithIndex< TImage > halfIt(halfImage, halfImage->GetLargestPossibleRegion());
+  for ( halfIt.GoToBegin(); !halfIt.IsAtEnd(); ++halfIt )
+    {
+    const typename TImage::PixelType fullValue = fullImage->GetPixel(halfIt.GetIndex());
+    if ( std::abs(fullValue - halfIt.Get()) > tolerance * ( 1.0 + std::abs(fullValue) ) )
+      {
+      ++differences;
+      }
+    }
+  return differences;
+}
+
+template< typename TImage >
+typename TImage::Pointer
+CreateRealImage(const typename TImage::SizeType & size)
+{
+  auto image = TImage::New();
+  image->SetRegions(size);
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex< TImage > it(image, image->GetLargestPossibleRegion());
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    const typename TImage::IndexType index = it.GetIndex();
+    double value = 0;
+    for ( unsigned int dim = 0; dim < TImage::ImageDimension; ++dim )
+      {
+      value += std::cos(0.3 * ( dim + 1 ) * index[dim]) + 0.01 * index[dim] * index[dim];
+      }
+    it.Set(value);
+    }
+  return image;
+}
+
+template< unsigned int VDimension >
+int
+runFrequencyResizeHalfHermitianTest(const typename itk::Image< double, VDimension >::SizeType & size)
+{
+  using RealImageType = itk::Image< double, VDimension >;
+  using ComplexImageType = itk::Image< std::complex< double >, VDimension >;
+  using FFTFilterType = itk::ForwardFFTImageFilter< RealImageType, ComplexImageType >;
+  using HalfFFTFilterType = itk::RealToHalfHermitianForwardFFTImageFilter< RealImageType, ComplexImageType >;
+  using ShrinkFilterType = itk::FrequencyShrinkImageFilter< ComplexImageType >;
+  using ExpandFilterType = itk::FrequencyExpandImageFilter< ComplexImageType >;
+
+  const double tolerance = 1e-8;
+  bool testPassed = true;
+  auto realImage = CreateRealImage< RealImageType >(size);
+
+  auto fftFilter = FFTFilterType::New();
+  fftFilter->SetInput(realImage);
+  fftFilter->Update();
+  auto halfFFTFilter = HalfFFTFilterType::New();
+  halfFFTFilter->SetInput(realImage);
+  halfFFTFilter->Update();
+  const bool actualXDimensionIsOdd = halfFFTFilter->GetActualXDimensionIsOdd();
+
+  auto shrinkFilter = ShrinkFilterType::New();
+  shrinkFilter->SetInput(fftFilter->GetOutput());
+  shrinkFilter->Update();
+  auto halfShrinkFilter = ShrinkFilterType::New();
+  TEST_SET_GET_BOOLEAN(halfShrinkFilter, HalfHermitian, false);
+  TEST_SET_GET_BOOLEAN(halfShrinkFilter, ActualXDimensionIsOdd, false);
+  halfShrinkFilter->HalfHermitianOn();
+  halfShrinkFilter->SetActualXDimensionIsOdd(actualXDimensionIsOdd);
+  halfShrinkFilter->SetInput(halfFFTFilter->GetOutput());
+  halfShrinkFilter->Update();
+  const itk::SizeValueType shrinkFullSizeX = shrinkFilter->GetOutput()->GetLargestPossibleRegion().GetSize()[0];
+  TEST_EXPECT_EQUAL( halfShrinkFilter->GetOutput()->GetLargestPossibleRegion().GetSize()[0],
+    shrinkFullSizeX / 2 + 1 );
+  TEST_EXPECT_EQUAL( halfShrinkFilter->GetOutputActualXDimensionIsOdd(), ( shrinkFullSizeX % 2 == 1 ) );
+  unsigned int differences = CountHalfDifferences(shrinkFilter->GetOutput(), halfShrinkFilter->GetOutput(),
+    tolerance);
+  if ( differences > 0 )
+    {
+    std::cerr << "Shrink of size " << size << " has " << differences << " differences." << std::endl;
+    testPassed = false;
+    }
+
+  // The band filter is not supported in the half-hermitian layout.
+  halfShrinkFilter->ApplyBandFilterOn();
+  TRY_EXPECT_EXCEPTION( halfShrinkFilter->Update() );
+
+  auto expandFilter = ExpandFilterType::New();
+  expandFilter->SetInput(fftFilter->GetOutput());
+  expandFilter->Update();
+  auto halfExpandFilter = ExpandFilterType::New();
+  TEST_SET_GET_BOOLEAN(halfExpandFilter, HalfHermitian, false);
+  TEST_SET_GET_BOOLEAN(halfExpandFilter, ActualXDimensionIsOdd, false);
+  halfExpandFilter->HalfHermitianOn();
+  halfExpandFilter->SetActualXDimensionIsOdd(actualXDimensionIsOdd);
+  halfExpandFilter->SetInput(halfFFTFilter->GetOutput());
+  halfExpandFilter->Update();
+  TEST_EXPECT_EQUAL( halfExpandFilter->GetOutputActualXDimensionIsOdd(), false );
+  differences = CountHalfDifferences(expandFilter->GetOutput(), halfExpandFilter->GetOutput(), tolerance);
+  if ( differences > 0 )
+    {
+    std::cerr << "Expand of size " << size << " has " << differences << " differences." << std::endl;
+    testPassed = false;
+    }
+
+  return testPassed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+template< unsigned int VDimension >
+int
+runWaveletHalfHermitianTest()
+{
+  using RealImageType = itk::Image< double, VDimension >;
+  using ComplexImageType = itk::Image< std::complex< double >, VDimension >;
+  using FFTFilterType = itk::ForwardFFTImageFilter< RealImageType, ComplexImageType >;
+  using HalfFFTFilterType = itk::RealToHalfHermitianForwardFFTImageFilter< RealImageType, ComplexImageType >;
+  using HalfInverseFFTFilterType = itk::HalfHermitianToRealInverseFFTImageFilter< ComplexImageType, RealImageType >;
+  using WaveletFunctionType = itk::HeldIsotropicWavelet< double, VDimension >;
+  using WaveletFilterBankType = itk::WaveletFrequencyFilterBankGenerator< ComplexImageType, WaveletFunctionType >;
+  using HalfHermitianIteratorType = itk::FrequencyHalfHermitianFFTLayoutImageRegionIteratorWithIndex< ComplexImageType >;
+  using HalfWaveletFilterBankType = itk::WaveletFrequencyFilterBankGenerator< ComplexImageType,
+    WaveletFunctionType, HalfHermitianIteratorType >;
+  using ForwardWaveletType = itk::WaveletFrequencyForward< ComplexImageType, ComplexImageType, WaveletFilterBankType >;
+  using HalfForwardWaveletType = itk::WaveletFrequencyForward< ComplexImageType, ComplexImageType,
+    HalfWaveletFilterBankType >;
+  using HalfInverseWaveletType = itk::WaveletFrequencyInverse< ComplexImageType, ComplexImageType,
+    HalfWaveletFilterBankType >;
+
+  const unsigned int levels = 2;
+  const unsigned int highSubBands = 2;
+  const double tolerance = 1e-6;
+  bool testPassed = true;
+
+  typename RealImageType::SizeType size;
+  size.Fill(32);
+  auto realImage = CreateRealImage< RealImageType >(size);
+
+  auto fftFilter = FFTFilterType::New();
+  fftFilter->SetInput(realImage);
+  auto halfFFTFilter = HalfFFTFilterType::New();
+  halfFFTFilter->SetInput(realImage);
+  halfFFTFilter->Update();
+
+  auto forwardWavelet = ForwardWaveletType::New();
+  forwardWavelet->SetLevels(levels);
+  forwardWavelet->SetHighPassSubBands(highSubBands);
+  forwardWavelet->SetInput(fftFilter->GetOutput());
+  forwardWavelet->Update();
+
+  auto halfForwardWavelet = HalfForwardWaveletType::New();
+  halfForwardWavelet->SetLevels(levels);
+  halfForwardWavelet->SetHighPassSubBands(highSubBands);
+  TEST_SET_GET_BOOLEAN(halfForwardWavelet, HalfHermitian, false);
+  TEST_SET_GET_BOOLEAN(halfForwardWavelet, ActualXDimensionIsOdd, false);
+  halfForwardWavelet->HalfHermitianOn();
+  halfForwardWavelet->SetActualXDimensionIsOdd(halfFFTFilter->GetActualXDimensionIsOdd());
+  halfForwardWavelet->StoreWaveletFilterBankPyramidOn();
+  halfForwardWavelet->SetInput(halfFFTFilter->GetOutput());
+  halfForwardWavelet->Update();
+
+  for ( unsigned int nOutput = 0; nOutput < forwardWavelet->GetTotalOutputs(); ++nOutput )
+    {
+    const ComplexImageType * fullOutput = forwardWavelet->GetOutput(nOutput);
+    const ComplexImageType * halfOutput = halfForwardWavelet->GetOutput(nOutput);
+    typename ComplexImageType::SizeType expectedSize = fullOutput->GetLargestPossibleRegion().GetSize();
+    expectedSize[0] = expectedSize[0] / 2 + 1;
+    if ( halfOutput->GetLargestPossibleRegion().GetSize() != expectedSize
+         || halfOutput->GetSpacing() != fullOutput->GetSpacing() )
+      {
+      std::cerr << "Output " << nOutput << " has wrong metadata: "
+                << halfOutput->GetLargestPossibleRegion().GetSize() << std::endl;
+      testPassed = false;
+      continue;
+      }
+    const unsigned int differences = CountHalfDifferences(fullOutput, halfOutput, tolerance);
+    if ( differences > 0 )
+      {
+      std::cerr << "Forward output " << nOutput << " has " << differences << " differences." << std::endl;
+      testPassed = false;
+      }
+    }
+  TEST_EXPECT_EQUAL( halfForwardWavelet->GetWaveletFilterBankPyramid().size(),
+    static_cast< size_t >( levels * ( highSubBands + 1 ) ) );
+
+  // A full layout filter bank cannot be used with half-hermitian images.
+  auto wrongForwardWavelet = ForwardWaveletType::New();
+  wrongForwardWavelet->HalfHermitianOn();
+  wrongForwardWavelet->SetInput(halfFFTFilter->GetOutput());
+  TRY_EXPECT_EXCEPTION( wrongForwardWavelet->Update() );
+
+  // Reconstruction, with generated and stored filter banks.
+  for ( unsigned int usePyramid = 0; usePyramid < 2; ++usePyramid )
+    {
+    auto halfInverseWavelet = HalfInverseWaveletType::New();
+    halfInverseWavelet->SetLevels(levels);
+    halfInverseWavelet->SetHighPassSubBands(highSubBands);
+    TEST_SET_GET_BOOLEAN(halfInverseWavelet, HalfHermitian, false);
+    halfInverseWavelet->HalfHermitianOn();
+    halfInverseWavelet->SetActualXDimensionIsOdd(halfFFTFilter->GetActualXDimensionIsOdd());
+    halfInverseWavelet->SetUseWaveletFilterBankPyramid(usePyramid == 1);
+    halfInverseWavelet->SetWaveletFilterBankPyramid(halfForwardWavelet->GetWaveletFilterBankPyramid());
+    halfInverseWavelet->SetInputs(halfForwardWavelet->GetOutputs());
+    halfInverseWavelet->Update();
+
+    auto halfInverseFFTFilter = HalfInverseFFTFilterType::New();
+    halfInverseFFTFilter->SetInput(halfInverseWavelet->GetOutput());
+    halfInverseFFTFilter->SetActualXDimensionIsOdd(halfFFTFilter->GetActualXDimensionIsOdd());
+    halfInverseFFTFilter->Update();
+
+    unsigned int differences = 0;
+    itk::ImageRegionConstIterator< RealImageType > inputIt(realImage, realImage->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator< RealImageType > reconstructedIt(halfInverseFFTFilter->GetOutput(),
+      realImage->GetLargestPossibleRegion());
+    for ( ; !inputIt.IsAtEnd(); ++inputIt, ++reconstructedIt )
+      {
+      if ( std::abs(inputIt.Get() - reconstructedIt.Get()) > 1e-4 * ( 1.0 + std::abs(inputIt.Get()) ) )
+        {
+        ++differences;
+        }
+      }
+    if ( differences > 0 )
+      {
+      std::cerr << "Reconstruction (UseWaveletFilterBankPyramid: " << usePyramid << ") has "
+                << differences << " differences with the input." << std::endl;
+      testPassed = false;
+      }
+    }
+
+  return testPassed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+}
+
+int
+itkWaveletFrequencyHalfHermitianTest( int, char *[] )
+{
+  int result = EXIT_SUCCESS;
+
+  // Even and odd size in the x dimension.
+  itk::Image< double, 2 >::SizeType size2D = { { 16, 20 } };
+  if ( runFrequencyResizeHalfHermitianTest< 2 >(size2D) == EXIT_FAILURE )
+    {
+    result = EXIT_FAILURE;
+    }
+  size2D[0] = 15;
+  if ( runFrequencyResizeHalfHermitianTest< 2 >(size2D) == EXIT_FAILURE )
+    {
+    result = EXIT_FAILURE;
+    }
+  itk::Image< double, 3 >::SizeType size3D = { { 9, 8, 10 } };
+  if ( runFrequencyResizeHalfHermitianTest< 3 >(size3D) == EXIT_FAILURE )
+    {
+    result = EXIT_FAILURE;
+    }
+
+  if ( runWaveletHalfHermitianTest< 2 >() == EXIT_FAILURE )
+    {
+    result = EXIT_FAILURE;
+    }
+  if ( runWaveletHalfHermitianTest< 3 >() == EXIT_FAILURE )
+    {
+    result = EXIT_FAILURE;
+    }
+
+  if ( result == EXIT_FAILURE )
+    {
+    std::cerr << "Test failed!" << std::endl;
+    }
+  return result;
+}
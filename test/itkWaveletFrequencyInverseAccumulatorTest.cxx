@@ -0,0 +1,154 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImage.h"
+#include "itkWaveletFrequencyInverseAccumulator.h"
+#include "itkForwardFFTImageFilter.h"
+#include "itkWaveletFrequencyForward.h"
+#include "itkWaveletFrequencyInverse.h"
+#include "itkWaveletFrequencyFilterBankGenerator.h"
+#include "itkHeldIsotropicWavelet.h"
+#include "itkImageAlgorithm.h"
+#include "itkCommand.h"
+#include "itkIsotropicWaveletTestUtilities.h"
+#include "itkTestingMacros.h"
+
+#include <complex>
+
+namespace
+{
+/** DeleteEvent callback: decrements the counter of live images passed as client data. */
+void
+countDeletedImage(itk::Object *, const itk::EventObject &, void * clientData)
+{
+  --*static_cast< unsigned int * >( clientData );
+}
+}
+
+int
+itkWaveletFrequencyInverseAccumulatorTest( int, char *[] )
+{
+  constexpr unsigned int Dimension = 3;
+  using RealImageType = itk::Image< double, Dimension >;
+  using FFTFilterType = itk::ForwardFFTImageFilter< RealImageType >;
+  using ComplexImageType = FFTFilterType::OutputImageType;
+  using WaveletFunctionType = itk::HeldIsotropicWavelet<>;
+  using WaveletFilterBankType = itk::WaveletFrequencyFilterBankGenerator< ComplexImageType, WaveletFunctionType >;
+  using ForwardWaveletType = itk::WaveletFrequencyForward< ComplexImageType, ComplexImageType, WaveletFilterBankType >;
+  using InverseWaveletType = itk::WaveletFrequencyInverse< ComplexImageType, ComplexImageType, WaveletFilterBankType >;
+  using AccumulatorType = itk::WaveletFrequencyInverseAccumulator< ComplexImageType, WaveletFilterBankType >;
+  constexpr unsigned int levels = 2;
+  constexpr unsigned int bands = 3;
+
+  bool testPassed = true;
+
+  auto accumulator = AccumulatorType::New();
+  EXERCISE_BASIC_OBJECT_METHODS( accumulator, WaveletFrequencyInverseAccumulator, Object );
+  TEST_SET_GET_BOOLEAN( accumulator, ApplyReconstructionFactors, true );
+  TEST_SET_GET_BOOLEAN( accumulator, UseWaveletFilterBankCache, false );
+  accumulator->SetLevels(levels);
+  accumulator->SetHighPassSubBands(bands);
+  TEST_EXPECT_EQUAL( accumulator->GetTotalInputs(), levels * bands + 1 );
+  TEST_EXPECT_EQUAL( accumulator->GetNumberOfPendingInputs(), levels * bands + 1 );
+  // At least one level is needed to expand the low pass.
+  TRY_EXPECT_EXCEPTION( accumulator->SetLevels(0) );
+  TEST_EXPECT_EQUAL( accumulator->GetLevels(), levels );
+  // Factors larger than 2 alias the low pass.
+  TRY_EXPECT_EXCEPTION( accumulator->SetScaleFactor(3) );
+
+  ComplexImageType::SizeType size = {{32, 32, 16}};
+  auto fftFilter = FFTFilterType::New();
+  fftFilter->SetInput(itk::Testing::MakeSyntheticImage< RealImageType >(size));
+  fftFilter->Update();
+
+  auto forwardWavelet = ForwardWaveletType::New();
+  forwardWavelet->SetLevels(levels);
+  forwardWavelet->SetHighPassSubBands(bands);
+  forwardWavelet->SetInput(fftFilter->GetOutput());
+  forwardWavelet->Update();
+
+  auto inverseWavelet = InverseWaveletType::New();
+  inverseWavelet->SetLevels(levels);
+  inverseWavelet->SetHighPassSubBands(bands);
+  inverseWavelet->SetInputs(forwardWavelet->GetOutputs());
+  inverseWavelet->Update();
+
+  // Add the inputs in reverse order, from copies that own their buffer and are released
+  // after being added. Only the low pass, added first, is kept until Finalize.
+  unsigned int liveCopies = 0;
+  auto deletionCommand = itk::CStyleCommand::New();
+  deletionCommand->SetCallback(countDeletedImage);
+  deletionCommand->SetClientData(&liveCopies);
+  const unsigned int lowPassInput = accumulator->GetTotalInputs() - 1;
+  for ( int nInput = lowPassInput; nInput > -1; --nInput )
+    {
+    const ComplexImageType * output = forwardWavelet->GetOutput(nInput);
+    auto coefficients = ComplexImageType::New();
+    coefficients->CopyInformation(output);
+    coefficients->SetRegions(output->GetLargestPossibleRegion());
+    coefficients->Allocate();
+    itk::ImageAlgorithm::Copy(output, coefficients.GetPointer(), output->GetLargestPossibleRegion(),
+      coefficients->GetLargestPossibleRegion());
+    coefficients->AddObserver(itk::DeleteEvent(), deletionCommand);
+    ++liveCopies;
+
+    accumulator->AddInput(nInput, coefficients);
+    if ( static_cast< unsigned int >( nInput ) != lowPassInput )
+      {
+      // The accumulator does not hold the band.
+      TEST_EXPECT_EQUAL( coefficients->GetReferenceCount(), 1 );
+      }
+    coefficients = nullptr;
+    TEST_EXPECT_EQUAL( liveCopies, 1u );
+    }
+  TEST_EXPECT_EQUAL( accumulator->GetNumberOfPendingInputs(), 0u );
+  ComplexImageType::Pointer reconstruction;
+  TRY_EXPECT_NO_EXCEPTION( reconstruction = accumulator->Finalize() );
+  // Finalize releases the low pass.
+  TEST_EXPECT_EQUAL( liveCopies, 0u );
+
+  const ComplexImageType * expected = inverseWavelet->GetOutput();
+  TEST_EXPECT_EQUAL( reconstruction->GetLargestPossibleRegion(), expected->GetLargestPossibleRegion() );
+  const double maxDifference = itk::Testing::ComputeMaxAbsoluteDifference(expected, reconstruction.GetPointer());
+  if ( maxDifference > 1e-9 * expected->GetLargestPossibleRegion().GetNumberOfPixels() )
+    {
+    std::cerr << "Error. The accumulated reconstruction differs from WaveletFrequencyInverse: "
+              << maxDifference << std::endl;
+    testPassed = false;
+    }
+
+  // Finalize discards the inputs.
+  TEST_EXPECT_EQUAL( accumulator->GetNumberOfPendingInputs(), levels * bands + 1 );
+  TRY_EXPECT_EXCEPTION( accumulator->Finalize() );
+
+  accumulator->AddBand(1, 0, forwardWavelet->GetOutput(bands));
+  // Each band is added once.
+  TRY_EXPECT_EXCEPTION( accumulator->AddBand(1, 0, forwardWavelet->GetOutput(bands)) );
+  // The bands of a level have the same size.
+  TRY_EXPECT_EXCEPTION( accumulator->AddBand(1, 1, forwardWavelet->GetOutput(0)) );
+  TRY_EXPECT_EXCEPTION( accumulator->AddBand(levels, 0, forwardWavelet->GetOutput(0)) );
+  TRY_EXPECT_EXCEPTION( accumulator->AddInput(levels * bands + 1, forwardWavelet->GetOutput(0)) );
+  accumulator->Clear();
+  TEST_EXPECT_EQUAL( accumulator->GetNumberOfPendingInputs(), levels * bands + 1 );
+
+  if ( !testPassed )
+    {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
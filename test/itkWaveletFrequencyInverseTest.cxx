@@ -29,8 +29,10 @@
 #include "itkForwardFFTImageFilter.h"
 #include "itkInverseFFTImageFilter.h"
 #include "itkChangeInformationImageFilter.h"
+#include "itkIsotropicWaveletTestUtilities.h"
 #include "itkTestingMacros.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <cmath>
@@ -193,6 +195,176 @@ runWaveletFrequencyInverseTest( const std::string& inputImage,
     }
 }
 
+/** Forward and inverse with a scale factor per axis: the short z axis of a stack is not decimated.
+ * The reconstruction has to be equal to the input. */
+template< typename TWaveletFunction >
+int
+runWaveletFrequencyInverseAnisotropicTest()
+{
+  constexpr unsigned int Dimension = 3;
+  using ImageType = itk::Image< double, Dimension >;
+  using FFTFilterType = itk::ForwardFFTImageFilter< ImageType >;
+  using ComplexImageType = typename FFTFilterType::OutputImageType;
+  using WaveletFilterBankType = itk::WaveletFrequencyFilterBankGenerator< ComplexImageType, TWaveletFunction >;
+  using ForwardWaveletType = itk::WaveletFrequencyForward< ComplexImageType, ComplexImageType, WaveletFilterBankType >;
+  using InverseWaveletType = itk::WaveletFrequencyInverse< ComplexImageType, ComplexImageType, WaveletFilterBankType >;
+  using InverseFFTFilterType = itk::InverseFFTImageFilter< ComplexImageType, ImageType >;
+  constexpr unsigned int levels = 2;
+  constexpr unsigned int bands = 2;
+
+  bool testPassed = true;
+
+  const typename ImageType::SizeType size = {{32, 32, 8}};
+  auto image = itk::Testing::MakeSyntheticImage< ImageType >(size);
+  auto fftFilter = FFTFilterType::New();
+  fftFilter->SetInput(image);
+
+  typename ForwardWaveletType::ScaleFactorsType scaleFactors;
+  scaleFactors[0] = 2;
+  scaleFactors[1] = 2;
+  scaleFactors[2] = 1;
+  // The z axis does not limit the number of levels.
+  TEST_EXPECT_EQUAL( ForwardWaveletType::ComputeMaxNumberOfLevels(size, scaleFactors), 5u );
+
+  auto forwardWavelet = ForwardWaveletType::New();
+  forwardWavelet->SetLevels(levels);
+  forwardWavelet->SetHighPassSubBands(bands);
+  forwardWavelet->SetScaleFactors(scaleFactors);
+  forwardWavelet->StoreWaveletFilterBankPyramidOn();
+  forwardWavelet->SetInput(fftFilter->GetOutput());
+  TRY_EXPECT_NO_EXCEPTION( forwardWavelet->Update() );
+  const typename ComplexImageType::SizeType expectedLowPassSize = {{8, 8, 8}};
+  TEST_EXPECT_EQUAL( forwardWavelet->GetOutputLowPass()->GetLargestPossibleRegion().GetSize(), expectedLowPassSize );
+
+  // With the filter banks generated by the inverse, and with the ones stored by the forward.
+  for ( bool useWaveletFilterBankPyramid : { false, true } )
+    {
+    auto inverseWavelet = InverseWaveletType::New();
+    inverseWavelet->SetLevels(levels);
+    inverseWavelet->SetHighPassSubBands(bands);
+    inverseWavelet->SetScaleFactors(scaleFactors);
+    inverseWavelet->SetInputs(forwardWavelet->GetOutputs());
+    inverseWavelet->SetUseWaveletFilterBankPyramid(useWaveletFilterBankPyramid);
+    inverseWavelet->SetWaveletFilterBankPyramid(forwardWavelet->GetWaveletFilterBankPyramid());
+    auto inverseFFT = InverseFFTFilterType::New();
+    inverseFFT->SetInput(inverseWavelet->GetOutput());
+    TRY_EXPECT_NO_EXCEPTION( inverseFFT->Update() );
+
+    TEST_EXPECT_EQUAL( inverseFFT->GetOutput()->GetLargestPossibleRegion(), image->GetLargestPossibleRegion() );
+    const double difference = itk::Testing::ComputeMaxAbsoluteDifference(image.GetPointer(), inverseFFT->GetOutput());
+    if ( difference > 1e-6 )
+      {
+      std::cerr << "Error. Reconstruction with scale factors " << scaleFactors << " (UseWaveletFilterBankPyramid: "
+                << useWaveletFilterBankPyramid << ") differs from the input by " << difference << std::endl;
+      testPassed = false;
+      }
+    }
+
+  // Factors larger than 2 alias the low pass.
+  auto inverseWavelet = InverseWaveletType::New();
+  TRY_EXPECT_EXCEPTION( inverseWavelet->SetScaleFactor(3) );
+  scaleFactors[2] = 5;
+  TRY_EXPECT_EXCEPTION( inverseWavelet->SetScaleFactors(scaleFactors) );
+
+  return testPassed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/** The band normalization with the geometric mean of the scale factors, \sa utils::ComputeMeanScaleFactor.
+ * With the factors {2, 2, 1}, the forward transform of a volume constant along z is, in the plane kz = 0,
+ * the 2D dyadic transform of one slice times the number of slices, and zero in the other planes. */
+template< typename TWaveletFunction >
+int
+runWaveletFrequencyForwardPerAxisNormalizationTest()
+{
+  using SliceType = itk::Image< double, 2 >;
+  using VolumeType = itk::Image< double, 3 >;
+  using SliceFFTFilterType = itk::ForwardFFTImageFilter< SliceType >;
+  using VolumeFFTFilterType = itk::ForwardFFTImageFilter< VolumeType >;
+  using ComplexSliceType = typename SliceFFTFilterType::OutputImageType;
+  using ComplexVolumeType = typename VolumeFFTFilterType::OutputImageType;
+  using SliceForwardWaveletType = itk::WaveletFrequencyForward< ComplexSliceType, ComplexSliceType,
+    itk::WaveletFrequencyFilterBankGenerator< ComplexSliceType, TWaveletFunction > >;
+  using VolumeForwardWaveletType = itk::WaveletFrequencyForward< ComplexVolumeType, ComplexVolumeType,
+    itk::WaveletFrequencyFilterBankGenerator< ComplexVolumeType, TWaveletFunction > >;
+  constexpr unsigned int levels = 2;
+  constexpr unsigned int bands = 2;
+  constexpr unsigned int slices = 8;
+
+  bool testPassed = true;
+
+  const typename SliceType::SizeType sliceSize = {{32, 32}};
+  auto slice = itk::Testing::MakeSyntheticImage< SliceType >(sliceSize);
+  const typename VolumeType::SizeType volumeSize = {{32, 32, slices}};
+  auto volume = VolumeType::New();
+  volume->SetRegions(volumeSize);
+  volume->Allocate();
+  itk::ImageRegionIteratorWithIndex< VolumeType > volumeIt(volume, volume->GetLargestPossibleRegion());
+  for ( volumeIt.GoToBegin(); !volumeIt.IsAtEnd(); ++volumeIt )
+    {
+    const typename VolumeType::IndexType index = volumeIt.GetIndex();
+    const typename SliceType::IndexType sliceIndex = {{index[0], index[1]}};
+    volumeIt.Set(slice->GetPixel(sliceIndex));
+    }
+
+  auto sliceFFT = SliceFFTFilterType::New();
+  sliceFFT->SetInput(slice);
+  auto sliceWavelet = SliceForwardWaveletType::New();
+  sliceWavelet->SetLevels(levels);
+  sliceWavelet->SetHighPassSubBands(bands);
+  sliceWavelet->SetInput(sliceFFT->GetOutput());
+  TRY_EXPECT_NO_EXCEPTION( sliceWavelet->Update() );
+
+  auto volumeFFT = VolumeFFTFilterType::New();
+  volumeFFT->SetInput(volume);
+  typename VolumeForwardWaveletType::ScaleFactorsType scaleFactors;
+  scaleFactors[0] = 2;
+  scaleFactors[1] = 2;
+  scaleFactors[2] = 1;
+  auto volumeWavelet = VolumeForwardWaveletType::New();
+  volumeWavelet->SetLevels(levels);
+  volumeWavelet->SetHighPassSubBands(bands);
+  volumeWavelet->SetScaleFactors(scaleFactors);
+  volumeWavelet->SetInput(volumeFFT->GetOutput());
+  TRY_EXPECT_NO_EXCEPTION( volumeWavelet->Update() );
+
+  for ( unsigned int nOutput = 0; nOutput < volumeWavelet->GetTotalOutputs(); ++nOutput )
+    {
+    const ComplexSliceType * sliceOutput = sliceWavelet->GetOutput(nOutput);
+    const ComplexVolumeType * volumeOutput = volumeWavelet->GetOutput(nOutput);
+    const typename ComplexSliceType::SizeType sliceOutputSize = sliceOutput->GetLargestPossibleRegion().GetSize();
+    const typename ComplexVolumeType::SizeType volumeOutputSize = volumeOutput->GetLargestPossibleRegion().GetSize();
+    TEST_EXPECT_EQUAL( volumeOutputSize[0], sliceOutputSize[0] );
+    TEST_EXPECT_EQUAL( volumeOutputSize[1], sliceOutputSize[1] );
+    TEST_EXPECT_EQUAL( volumeOutputSize[2], static_cast< itk::SizeValueType >( slices ) );
+
+    double maxDifference = 0;
+    double maxExpected = 0;
+    itk::ImageRegionConstIteratorWithIndex< ComplexVolumeType > outputIt(volumeOutput,
+      volumeOutput->GetLargestPossibleRegion());
+    for ( outputIt.GoToBegin(); !outputIt.IsAtEnd(); ++outputIt )
+      {
+      const typename ComplexVolumeType::IndexType index = outputIt.GetIndex();
+      typename ComplexVolumeType::PixelType expected(0);
+      if ( index[2] == 0 )
+        {
+        const typename ComplexSliceType::IndexType sliceIndex = {{index[0], index[1]}};
+        expected = static_cast< double >( slices ) * sliceOutput->GetPixel(sliceIndex);
+        }
+      maxDifference = std::max(maxDifference, std::abs(outputIt.Get() - expected));
+      maxExpected = std::max(maxExpected, std::abs(expected));
+      }
+    if ( maxDifference > 1e-9 * maxExpected )
+      {
+      std::cerr << "Error. Output " << nOutput << " with scale factors " << scaleFactors
+                << " differs from the 2D dyadic transform of a slice by " << maxDifference
+                << " (max value: " << maxExpected << ")" << std::endl;
+      testPassed = false;
+      }
+    }
+
+  return testPassed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
 int
 itkWaveletFrequencyInverseTest(int argc, char *argv[])
 {
@@ -304,6 +476,12 @@ itkWaveletFrequencyInverseTest(int argc, char *argv[])
     }
   else if ( dimension == 3 )
     {
+    if ( runWaveletFrequencyInverseAnisotropicTest< HeldWavelet >() == EXIT_FAILURE
+         || runWaveletFrequencyForwardPerAxisNormalizationTest< HeldWavelet >() == EXIT_FAILURE )
+      {
+      std::cerr << "Test failed!" << std::endl;
+      return EXIT_FAILURE;
+      }
     if ( waveletFunction == "Held" )
       {
       return runWaveletFrequencyInverseTest< 3, HeldWavelet >( inputImage, outputImage, inputLevels, inputBands );
@@ -0,0 +1,160 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImage.h"
+#include "itkWaveletFrequencyMultiplyImageFilter.h"
+#include "itkWaveletFrequencyFilterBankGenerator.h"
+#include "itkWaveletFrequencyForward.h"
+#include "itkHeldIsotropicWavelet.h"
+#include "itkSimoncelliIsotropicWavelet.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkIsotropicWaveletTestUtilities.h"
+#include "itkTestingMacros.h"
+
+#include <complex>
+#include <string>
+
+namespace
+{
+template< unsigned int VDimension, typename TWaveletFunction >
+int
+runWaveletFrequencyMultiplyImageFilterTest(const std::string & waveletName)
+{
+  using PixelType = double;
+  using ComplexImageType = itk::Image< std::complex< PixelType >, VDimension >;
+  using WaveletFilterBankType = itk::WaveletFrequencyFilterBankGenerator< ComplexImageType, TWaveletFunction >;
+  using MultiplyWaveletFilterType = itk::WaveletFrequencyMultiplyImageFilter< ComplexImageType, TWaveletFunction >;
+  using ForwardWaveletType = itk::WaveletFrequencyForward< ComplexImageType, ComplexImageType, WaveletFilterBankType >;
+
+  typename ComplexImageType::SizeType size;
+  size.Fill(32);
+  auto input = itk::Testing::MakeSyntheticSpectrum< ComplexImageType >(size);
+
+  const unsigned int highSubBands = 3;
+  const double tolerance = 1e-6;
+  bool testPassed = true;
+
+  // Compare with the product of the images of the filter bank.
+  auto filterBank = WaveletFilterBankType::New();
+  filterBank->SetHighPassSubBands(highSubBands);
+  filterBank->SetSize(size);
+  filterBank->Update();
+
+  auto multiplyWaveletFilter = MultiplyWaveletFilterType::New();
+  multiplyWaveletFilter->SetHighPassSubBands(highSubBands);
+  TEST_SET_GET_VALUE( highSubBands, multiplyWaveletFilter->GetHighPassSubBands() );
+  TEST_SET_GET_BOOLEAN(multiplyWaveletFilter, InverseBank, false);
+  typename MultiplyWaveletFilterType::BandFactorsType wrongBandFactors(highSubBands, 1.0);
+  multiplyWaveletFilter->SetBandFactors(wrongBandFactors);
+  multiplyWaveletFilter->SetInput(input);
+  TRY_EXPECT_EXCEPTION( multiplyWaveletFilter->Update() );
+
+  typename MultiplyWaveletFilterType::BandFactorsType bandFactors(highSubBands + 1, 1.0);
+  bandFactors[1] = 0.5;
+  multiplyWaveletFilter->SetBandFactors(bandFactors);
+  TRY_EXPECT_NO_EXCEPTION( multiplyWaveletFilter->Update() );
+
+  using ConstIteratorType = itk::ImageRegionConstIterator< ComplexImageType >;
+  for ( unsigned int band = 0; band < highSubBands + 1; ++band )
+    {
+    unsigned int differences = 0;
+    ConstIteratorType bankIt(filterBank->GetOutput(band), input->GetLargestPossibleRegion());
+    ConstIteratorType inIt(input, input->GetLargestPossibleRegion());
+    ConstIteratorType outIt(multiplyWaveletFilter->GetOutput(band), input->GetLargestPossibleRegion());
+    for ( ; !outIt.IsAtEnd(); ++bankIt, ++inIt, ++outIt )
+      {
+      const std::complex< PixelType > expected = bandFactors[band] * bankIt.Get() * inIt.Get();
+      if ( std::abs(expected - outIt.Get()) > tolerance * ( 1.0 + std::abs(expected) ) )
+        {
+        ++differences;
+        }
+      }
+    if ( differences > 0 )
+      {
+      std::cerr << waveletName << ": band " << band << " has " << differences << " differences." << std::endl;
+      testPassed = false;
+      }
+    }
+
+  // Forward wavelet, with and without filter bank images.
+  const unsigned int levels = 2;
+  auto forwardReference = ForwardWaveletType::New();
+  forwardReference->SetLevels(levels);
+  forwardReference->SetHighPassSubBands(highSubBands);
+  forwardReference->SetInput(input);
+  forwardReference->Update();
+
+  auto forwardOnTheFly = ForwardWaveletType::New();
+  forwardOnTheFly->SetLevels(levels);
+  forwardOnTheFly->SetHighPassSubBands(highSubBands);
+  TEST_SET_GET_BOOLEAN(forwardOnTheFly, ComputeFilterBankOnTheFly, false);
+  forwardOnTheFly->ComputeFilterBankOnTheFlyOn();
+  forwardOnTheFly->SetInput(input);
+  forwardOnTheFly->Update();
+
+  for ( unsigned int nOutput = 0; nOutput < forwardReference->GetTotalOutputs(); ++nOutput )
+    {
+    const ComplexImageType * reference = forwardReference->GetOutput(nOutput);
+    const ComplexImageType * onTheFly = forwardOnTheFly->GetOutput(nOutput);
+    if ( reference->GetLargestPossibleRegion() != onTheFly->GetLargestPossibleRegion()
+         || reference->GetSpacing() != onTheFly->GetSpacing() )
+      {
+      std::cerr << waveletName << ": output " << nOutput << " has different metadata." << std::endl;
+      testPassed = false;
+      continue;
+      }
+    const double difference = itk::Testing::ComputeMaxAbsoluteDifference(reference, onTheFly);
+    if ( difference > tolerance )
+      {
+      std::cerr << waveletName << ": forward output " << nOutput << " differs by "
+                << difference << "." << std::endl;
+      testPassed = false;
+      }
+    }
+
+  return testPassed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+}
+
+int
+itkWaveletFrequencyMultiplyImageFilterTest( int, char *[] )
+{
+  constexpr unsigned int Dimension = 3;
+  using HeldWavelet = itk::HeldIsotropicWavelet< double, Dimension >;
+  using SimoncelliWavelet2D = itk::SimoncelliIsotropicWavelet< double, 2 >;
+  using ComplexImageType = itk::Image< std::complex< double >, Dimension >;
+  using MultiplyWaveletFilterType = itk::WaveletFrequencyMultiplyImageFilter< ComplexImageType, HeldWavelet >;
+
+  auto multiplyWaveletFilter = MultiplyWaveletFilterType::New();
+  EXERCISE_BASIC_OBJECT_METHODS( multiplyWaveletFilter, WaveletFrequencyMultiplyImageFilter, ImageToImageFilter );
+
+  int result = EXIT_SUCCESS;
+  if ( runWaveletFrequencyMultiplyImageFilterTest< Dimension, HeldWavelet >("Held") == EXIT_FAILURE )
+    {
+    result = EXIT_FAILURE;
+    }
+  if ( runWaveletFrequencyMultiplyImageFilterTest< 2, SimoncelliWavelet2D >("Simoncelli2D") == EXIT_FAILURE )
+    {
+    result = EXIT_FAILURE;
+    }
+
+  if ( result == EXIT_FAILURE )
+    {
+    std::cerr << "Test failed!" << std::endl;
+    }
+  return result;
+}
@@ -0,0 +1,116 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImage.h"
+#include "itkWaveletPyramid.h"
+#include "itkTestingMacros.h"
+
+#include <complex>
+
+int
+itkWaveletPyramidTest( int, char *[] )
+{
+  constexpr unsigned int Dimension = 3;
+  using ComplexImageType = itk::Image< std::complex< double >, Dimension >;
+  using PyramidType = itk::WaveletPyramid< ComplexImageType >;
+  using RegionType = ComplexImageType::RegionType;
+
+  auto pyramid = PyramidType::New();
+  EXERCISE_BASIC_OBJECT_METHODS( pyramid, WaveletPyramid, Object );
+
+  // Regions of a pyramid of 2 levels, 2 bands, with odd number of pixels.
+  PyramidType::RegionsType regions;
+  for ( unsigned int sizeValue : { 9u, 9u, 4u, 4u, 2u } )
+    {
+    ComplexImageType::SizeType size;
+    size.Fill(sizeValue);
+    regions.push_back(RegionType(size));
+    }
+  pyramid->Allocate(regions);
+  TEST_EXPECT_EQUAL( pyramid->GetNumberOfImages(), regions.size() );
+  TRY_EXPECT_EXCEPTION( pyramid->GetImage(regions.size()) );
+
+  bool testPassed = true;
+  const ComplexImageType::PixelType * arenaBegin = pyramid->GetImage(0)->GetBufferPointer();
+  const ComplexImageType::PixelType * previousEnd = arenaBegin;
+  for ( unsigned int n = 0; n < pyramid->GetNumberOfImages(); ++n )
+    {
+    ComplexImageType * image = pyramid->GetImage(n);
+    TEST_EXPECT_EQUAL( image->GetBufferedRegion(), regions[n] );
+    const ComplexImageType::PixelType * begin = image->GetBufferPointer();
+    // Back to back, in order, and aligned with respect to the first image.
+    const auto alignmentInPixels = PyramidType::Alignment / sizeof( ComplexImageType::PixelType );
+    if ( begin < previousEnd || ( begin - arenaBegin ) % alignmentInPixels != 0 )
+      {
+      std::cerr << "Error. Image " << n << " is not aligned after the previous image." << std::endl;
+      testPassed = false;
+      }
+    previousEnd = begin + regions[n].GetNumberOfPixels();
+    image->FillBuffer(std::complex< double >(n, -1.0 * n));
+    }
+  if ( static_cast< itk::SizeValueType >( previousEnd - arenaBegin ) > pyramid->GetArenaSize() )
+    {
+    std::cerr << "Error. The images exceed the arena size: " << pyramid->GetArenaSize() << std::endl;
+    testPassed = false;
+    }
+  // Writing an image does not modify the others.
+  for ( unsigned int n = 0; n < pyramid->GetNumberOfImages(); ++n )
+    {
+    const ComplexImageType * image = pyramid->GetImage(n);
+    const ComplexImageType::PixelType * buffer = image->GetBufferPointer();
+    for ( itk::SizeValueType i = 0; i < regions[n].GetNumberOfPixels(); ++i )
+      {
+      if ( buffer[i] != std::complex< double >(n, -1.0 * n) )
+        {
+        std::cerr << "Error. Image " << n << " overlaps with other images." << std::endl;
+        testPassed = false;
+        break;
+        }
+      }
+    }
+
+  // The arena outlives the pyramid while the images are referenced.
+  ComplexImageType::Pointer lastImage = pyramid->GetImage(regions.size() - 1);
+  pyramid->Allocate(regions);
+  TEST_EXPECT_TRUE( lastImage->GetBufferPointer() != pyramid->GetImage(regions.size() - 1)->GetBufferPointer() );
+  pyramid->Clear();
+  TEST_EXPECT_EQUAL( pyramid->GetNumberOfImages(), 0u );
+  TEST_EXPECT_EQUAL( lastImage->GetPixel(ComplexImageType::IndexType()),
+    std::complex< double >(regions.size() - 1, -1.0 * ( regions.size() - 1 )) );
+
+  // Scratch buffers are reused while they are big enough.
+  auto scratchLarge = pyramid->GetScratchImage(0, regions[0]);
+  auto scratchSmall = pyramid->GetScratchImage(0, regions[2]);
+  TEST_EXPECT_EQUAL( scratchSmall->GetBufferedRegion(), regions[2] );
+  TEST_EXPECT_TRUE( scratchLarge->GetBufferPointer() == scratchSmall->GetBufferPointer() );
+  auto otherSlot = pyramid->GetScratchImage(1, regions[2]);
+  TEST_EXPECT_TRUE( otherSlot->GetBufferPointer() != scratchSmall->GetBufferPointer() );
+
+  // Reserved slots are created without changing the existing ones.
+  pyramid->ReserveScratchSlots(4);
+  TEST_EXPECT_EQUAL( pyramid->GetNumberOfScratchSlots(), 4u );
+  pyramid->ReserveScratchSlots(1);
+  TEST_EXPECT_EQUAL( pyramid->GetNumberOfScratchSlots(), 4u );
+  TEST_EXPECT_TRUE( pyramid->GetScratchImage(0, regions[2])->GetBufferPointer() == scratchSmall->GetBufferPointer() );
+
+  if ( !testPassed )
+    {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
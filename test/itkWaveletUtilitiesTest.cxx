@@ -17,6 +17,7 @@
  *=========================================================================*/
 
 #include "itkWaveletUtilities.h"
+#include "itkImage.h"
 #include "itkTestingMacros.h"
 
 bool IndexToLevelBandTest(
@@ -157,6 +158,152 @@ bool testComputeMaxNumberOfLevels()
   return testPassed;
 }
 
+bool testComputeMaxNumberOfLevelsPerAxis()
+{
+  bool testPassed = true;
+  constexpr unsigned int Dimension = 3;
+  using SizeType = itk::Size<Dimension>;
+  using ScaleFactorsType = itk::FixedArray< unsigned int, Dimension >;
+
+  // A short z axis that is not decimated does not limit the in-plane levels.
+  SizeType inputSize = {{1024, 1024, 64}};
+  ScaleFactorsType scaleFactors;
+  scaleFactors[0] = 2;
+  scaleFactors[1] = 2;
+  scaleFactors[2] = 1;
+  unsigned int result = itk::utils::ComputeMaxNumberOfLevels(inputSize, scaleFactors);
+  if ( result != 10 )
+    {
+    std::cerr << "Error in ComputeMaxNumberOfLevels with per-axis factors " << scaleFactors
+              << ": expected 10, got " << result << std::endl;
+    testPassed = false;
+    }
+
+  // Equal factors give the same result than a single factor.
+  scaleFactors.Fill(2);
+  result = itk::utils::ComputeMaxNumberOfLevels(inputSize, scaleFactors);
+  if ( result != itk::utils::ComputeMaxNumberOfLevels(inputSize, 2u) )
+    {
+    std::cerr << "Error in ComputeMaxNumberOfLevels with equal per-axis factors: " << result << std::endl;
+    testPassed = false;
+    }
+
+  // Non-dyadic factors per axis: 45 = 3^2 * 5, 75 = 3 * 5^2.
+  inputSize = {{45, 75, 16}};
+  scaleFactors[0] = 3;
+  scaleFactors[1] = 5;
+  scaleFactors[2] = 2;
+  result = itk::utils::ComputeMaxNumberOfLevels(inputSize, scaleFactors);
+  if ( result != 3 )
+    {
+    std::cerr << "Error in ComputeMaxNumberOfLevels with per-axis factors " << scaleFactors
+              << ": expected 3, got " << result << std::endl;
+    testPassed = false;
+    }
+
+  // A decimated axis of size 1 cannot be shrunk, whatever the size of the following axes.
+  inputSize = {{1, 64, 64}};
+  scaleFactors.Fill(2);
+  result = itk::utils::ComputeMaxNumberOfLevels(inputSize, scaleFactors);
+  if ( result != 0 || result != itk::utils::ComputeMaxNumberOfLevels(inputSize, 2u) )
+    {
+    std::cerr << "Error in ComputeMaxNumberOfLevels with a decimated axis of size 1: expected 0, got "
+              << result << std::endl;
+    testPassed = false;
+    }
+  // The axis of size 1 does not limit the levels when it is not decimated.
+  scaleFactors[0] = 1;
+  result = itk::utils::ComputeMaxNumberOfLevels(inputSize, scaleFactors);
+  if ( result != 6 )
+    {
+    std::cerr << "Error in ComputeMaxNumberOfLevels with a not decimated axis of size 1: expected 6, got "
+              << result << std::endl;
+    testPassed = false;
+    }
+
+  // No decimated axis.
+  inputSize = {{45, 75, 16}};
+  scaleFactors.Fill(1);
+  result = itk::utils::ComputeMaxNumberOfLevels(inputSize, scaleFactors);
+  if ( result != 1 )
+    {
+    std::cerr << "Error in ComputeMaxNumberOfLevels without decimated axes: expected 1, got " << result << std::endl;
+    testPassed = false;
+    }
+
+  // Normalization of the levels.
+  scaleFactors.Fill(2);
+  if ( itk::Math::NotAlmostEquals(itk::utils::ComputeMeanScaleFactor(scaleFactors), 2.0) )
+    {
+    std::cerr << "Error in ComputeMeanScaleFactor with factors " << scaleFactors << std::endl;
+    testPassed = false;
+    }
+  scaleFactors[2] = 1;
+  if ( std::abs(std::pow(itk::utils::ComputeMeanScaleFactor(scaleFactors), 3.0) - 4.0) > 1e-12 )
+    {
+    std::cerr << "Error in ComputeMeanScaleFactor with factors " << scaleFactors << std::endl;
+    testPassed = false;
+    }
+
+  // The wavelets only support factors of 1 and 2.
+  if ( !itk::utils::AreWaveletScaleFactorsSupported(scaleFactors) )
+    {
+    std::cerr << "Error in AreWaveletScaleFactorsSupported with factors " << scaleFactors << std::endl;
+    testPassed = false;
+    }
+  scaleFactors[0] = 3;
+  if ( itk::utils::AreWaveletScaleFactorsSupported(scaleFactors) )
+    {
+    std::cerr << "Error in AreWaveletScaleFactorsSupported with factors " << scaleFactors << std::endl;
+    testPassed = false;
+    }
+
+  return testPassed;
+}
+
+bool testShareOrCastImage()
+{
+  bool testPassed = true;
+  constexpr unsigned int Dimension = 3;
+  using ImageType = itk::Image< float, Dimension >;
+  using DoubleImageType = itk::Image< double, Dimension >;
+
+  auto input = ImageType::New();
+  ImageType::SizeType size;
+  size.Fill(4);
+  input->SetRegions(size);
+  input->Allocate();
+  input->FillBuffer(3.0f);
+  ImageType::SpacingType spacing;
+  spacing.Fill(0.5);
+  input->SetSpacing(spacing);
+
+  // Same type: the pixels are shared, the metadata is independent.
+  ImageType::Pointer shared = itk::utils::ShareOrCastImage< ImageType, ImageType >(input.GetPointer());
+  ImageType::SpacingType unitSpacing;
+  unitSpacing.Fill(1.0);
+  shared->SetSpacing(unitSpacing);
+  if ( shared->GetBufferPointer() != input->GetBufferPointer()
+       || shared->GetSource() != nullptr
+       || input->GetSpacing() != spacing )
+    {
+    std::cerr << "Error in ShareOrCastImage with equal image types" << std::endl;
+    testPassed = false;
+    }
+
+  // Different type: the pixels are cast.
+  DoubleImageType::Pointer cast = itk::utils::ShareOrCastImage< ImageType, DoubleImageType >(input.GetPointer());
+  DoubleImageType::IndexType index;
+  index.Fill(1);
+  if ( cast->GetSource() != nullptr
+       || cast->GetLargestPossibleRegion().GetSize() != size
+       || cast->GetPixel(index) != 3.0 )
+    {
+    std::cerr << "Error in ShareOrCastImage with different image types" << std::endl;
+    testPassed = false;
+    }
+  return testPassed;
+}
 
 int itkWaveletUtilitiesTest(int , char*[] )
 {
@@ -261,6 +408,16 @@ int itkWaveletUtilitiesTest(int , char*[] )
     {
     testPassed = false;
     }
+  if ( !testComputeMaxNumberOfLevelsPerAxis() )
+    {
+    testPassed = false;
+    }
+
+  // Test ShareOrCastImage
+  if ( !testShareOrCastImage() )
+    {
+    testPassed = false;
+    }
 
 
   if ( testPassed )